@@ -12,6 +12,7 @@
 #include "DebugMenu/CSDebug_DebugMenuManager.h"
 #include "ActorSelect/CSDebug_ActorSelectComponent.h"
 #include "CSDebug_Config.h"
+#include "CSDebug_Subsystem.h"
 #include "ScreenWindow/CSDebug_ScreenWindowText.h"
 
 #include "Engine/Canvas.h"
@@ -31,19 +32,57 @@ UCSDebug_ActorSelectManager* UCSDebug_ActorSelectManager::sGet(const UWorld* InW
  */
 void	UCSDebug_ActorSelectManager::Init()
 {
+	SetupDebugMenu();
+
  	UCSDebug_DebugMenuManager* DebugMenuManager = UCSDebug_DebugMenuManager::sGet(this);
+	mDebugMenuValueChangedHandle = DebugMenuManager->SubscribeFolderValueChanged(FString(TEXT("CSDebug/ActorSelect")), FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate::CreateUObject(this, &UCSDebug_ActorSelectManager::OnChangeDebugMenuValue));
+	ApplyDebugMenuValue();
+}
+
+/**
+ * @brief	デバッグメニューのノードを追加して参照を取る(既にあればその参照)
+ *			デバッグメニューが作り直されたら参照が無効になるので取り直す
+ */
+void	UCSDebug_ActorSelectManager::SetupDebugMenu()
+{
+ 	UCSDebug_DebugMenuManager* DebugMenuManager = UCSDebug_DebugMenuManager::sGet(this);
+	mDebugMenuNodeGeneration = DebugMenuManager->GetNodeGeneration();
 
  	const FString BaseDebugMenuPath(TEXT("CSDebug/ActorSelect"));
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath, FString(TEXT("Active")), false);
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath, FString(TEXT("UpdateOnlySelectActor")), false);
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Info")), false);
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Mark")), false);
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Axis")), false);
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Bone")), false);
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("PathFollow")), false);
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("LastEQS")), false);
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("BehaviorTree")), false);
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Perception")), false);
+	mMenuValue_Active = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath, FString(TEXT("Active")), false);
+	mMenuValue_UpdateOnlySelectActor = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath, FString(TEXT("UpdateOnlySelectActor")), false);
+	mMenuValue_DrawInfo = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Info")), false);
+	mMenuValue_DrawMark = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Mark")), false);
+	mMenuValue_DrawAxis = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Axis")), false);
+	mMenuValue_DrawBone = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Bone")), false);
+	mMenuValue_DrawPathFollow = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("PathFollow")), false);
+	mMenuValue_DrawLastEQS = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("LastEQS")), false);
+	mMenuValue_DrawBehaviorTree = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("BehaviorTree")), false);
+	mMenuValue_DrawPerception = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath + FString(TEXT("/Draw")), FString(TEXT("Perception")), false);
+}
+
+/**
+ * @brief	mMenuValue_*を取った後にデバッグメニューが作り直されたか
+ *			(ノードを足せなかった時に毎フレーム足し直さないよう 参照の有効性ではなく世代で見る)
+ */
+bool	UCSDebug_ActorSelectManager::IsDebugMenuRebuilt() const
+{
+	const UCSDebug_DebugMenuManager* DebugMenuManager = UCSDebug_DebugMenuManager::sGet(this);
+	return DebugMenuManager
+		&& DebugMenuManager->GetNodeGeneration() != mDebugMenuNodeGeneration;
+}
+
+/**
+ * @brief	Exit
+ */
+void	UCSDebug_ActorSelectManager::Exit()
+{
+	const UCSDebug_Subsystem* CSDebugSubsystem = GetTypedOuter<UCSDebug_Subsystem>();
+	if (UCSDebug_DebugMenuManager* DebugMenuManager = CSDebugSubsystem ? CSDebugSubsystem->GetDebugMenuManager() : nullptr)
+	{
+		DebugMenuManager->Unsubscribe(mDebugMenuValueChangedHandle);
+	}
+	mDebugMenuValueChangedHandle.Reset();
 }
 
 /**
@@ -51,17 +90,11 @@ void	UCSDebug_ActorSelectManager::Init()
  */
 bool	UCSDebug_ActorSelectManager::DebugTick(float InDeltaSecond)
 {
-	const UCSDebug_DebugMenuManager* DebugMenuManager = UCSDebug_DebugMenuManager::sGet(this);
-	mbActive = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/Active")));
-	SetOnlyUpdateSelectActor(DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/UpdateOnlySelectActor"))));
-	mbShowInfo = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/Draw/Info")));
-	mbShowMark = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/Draw/Mark")));
-	mbShowSelectAxis = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/Draw/Axis")));
-	mbShowSelectBone = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/Draw/Bone")));
-	mbShowSelectPathFollow = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/Draw/PathFollow")));
-	mbShowSelectLastEQS = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/Draw/LastEQS")));
-	mbShowSelectBehaviorTree = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/Draw/BehaviorTree")));
-	mbShowSelectPerception = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/ActorSelect/Draw/Perception")));
+	//デバッグメニューが作り直されてたらノードを足し直す
+	if (IsDebugMenuRebuilt())
+	{
+		ApplyDebugMenuValue();
+	}
 	if (!mbActive)
 	{
 		return true;
@@ -336,4 +369,33 @@ void	UCSDebug_ActorSelectManager::SetOnlyUpdateSelectActor(const bool bInOnlyUpd
 	}
 }
 
+/**
+ * @brief	デバッグメニューのActorSelect以下の値が変わった
+ */
+void	UCSDebug_ActorSelectManager::OnChangeDebugMenuValue(const CSDebug_DebugMenuNodeBase& InNode)
+{
+	ApplyDebugMenuValue();
+}
+
+/**
+ * @brief	デバッグメニューの値を反映
+ */
+void	UCSDebug_ActorSelectManager::ApplyDebugMenuValue()
+{
+	if (IsDebugMenuRebuilt())
+	{
+		SetupDebugMenu();
+	}
+	mbActive = mMenuValue_Active.Get();
+	SetOnlyUpdateSelectActor(mMenuValue_UpdateOnlySelectActor.Get());
+	mbShowInfo = mMenuValue_DrawInfo.Get();
+	mbShowMark = mMenuValue_DrawMark.Get();
+	mbShowSelectAxis = mMenuValue_DrawAxis.Get();
+	mbShowSelectBone = mMenuValue_DrawBone.Get();
+	mbShowSelectPathFollow = mMenuValue_DrawPathFollow.Get();
+	mbShowSelectLastEQS = mMenuValue_DrawLastEQS.Get();
+	mbShowSelectBehaviorTree = mMenuValue_DrawBehaviorTree.Get();
+	mbShowSelectPerception = mMenuValue_DrawPerception.Get();
+}
+
 #endif//USE_CSDEBUG
\ No newline at end of file
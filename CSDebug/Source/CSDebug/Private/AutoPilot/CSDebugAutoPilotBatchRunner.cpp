@@ -0,0 +1,485 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotBatchRunner.cpp
+ * @brief 自動入力 入力記録の一括再生(-nullrhi等での夜間計測用)
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotBatchRunner.h"
+#include "AutoPilot/CSDebugAutoPilotComponent.h"
+#include "AutoPilot/CSDebugAutoPilotModeRecord.h"
+#include "AutoPilot/CSDebugAutoPilotRecordFile.h"
+#include "CSDebug_Subsystem.h"
+#include "CSDebug_Config.h"
+
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if USE_CSDEBUG
+
+namespace
+{
+	const TCHAR* const	sBatchParam = TEXT("CSDebugAutoPilotBatch");
+
+	FString	sGetRecordDir()
+	{
+		return FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/");
+	}
+
+	/**
+	 * @brief	入力記録の終了フレーム(読めなければ0)
+	 *			バイナリはヘッダだけ読む 拡張子が無ければ再生時と同じくcsrec,jsonの順
+	 */
+	uint32	sReadRecordEndFrame(const FString& InFileName)
+	{
+		FString Path = sGetRecordDir() + InFileName;
+		if (FPaths::GetExtension(InFileName).IsEmpty())
+		{
+			Path += FPaths::FileExists(Path + TEXT(".csrec")) ? TEXT(".csrec") : TEXT(".json");
+		}
+		if (FCSDebugAutoPilotRecordFile::IsBinaryPath(Path))
+		{
+			FCSDebugAutoPilotRecordReader Reader;
+			return Reader.Open(Path) ? Reader.GetHeader().mEndFrame : 0;
+		}
+		FCSDebugAutoPilotCommandList CommandList;
+		return FCSDebugAutoPilotRecordFile::LoadJson(Path, CommandList) ? CommandList.mEndFrame : 0;
+	}
+
+	/**
+	 * @brief	ソート済みリストのパーセンタイル(InRate:0～1)
+	 */
+	float	sGetPercentile(const TArray<float>& InSortedList, const float InRate)
+	{
+		if (InSortedList.Num() == 0)
+		{
+			return 0.f;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(InRate * InSortedList.Num()) - 1, 0, InSortedList.Num() - 1);
+		return InSortedList[Index];
+	}
+}
+
+/**
+ * @brief	起動引数で一括再生が指定されてるか
+ */
+bool	UCSDebugAutoPilotBatchRunner::sIsRequested()
+{
+	return FParse::Param(FCommandLine::Get(), sBatchParam)
+		|| FCString::Strifind(FCommandLine::Get(), TEXT("-CSDebugAutoPilotBatch=")) != nullptr;
+}
+
+/**
+ * @brief	Init
+ *			再生する入力記録と同時再生数の一覧を作る
+ */
+void	UCSDebugAutoPilotBatchRunner::Init()
+{
+	FString FileNameParam;
+	if (FParse::Value(FCommandLine::Get(), TEXT("CSDebugAutoPilotBatch="), FileNameParam, false))
+	{
+		FileNameParam.ParseIntoArray(mFileNameList, TEXT(","));
+	}
+	if (mFileNameList.Num() == 0)
+	{
+		const FString RecordDir = sGetRecordDir();
+		TArray<FString> FoundList;
+		IFileManager::Get().FindFiles(FoundList, *(RecordDir + TEXT("*.csrec")), true, false);
+		mFileNameList.Append(FoundList);
+		FoundList.Reset();
+		IFileManager::Get().FindFiles(FoundList, *(RecordDir + TEXT("*.json")), true, false);
+		mFileNameList.Append(FoundList);
+		mFileNameList.Sort();
+	}
+
+	mLaneNumList.Reset();
+	if (FParse::Param(FCommandLine::Get(), TEXT("CSDebugAutoPilotBatchScaling")))
+	{
+		for (int32 LaneNum = 1; LaneNum <= sMaxLaneNum; LaneNum *= 2)
+		{
+			mLaneNumList.Add(LaneNum);
+		}
+	}
+	else
+	{
+		int32 LaneNum = 1;
+		FParse::Value(FCommandLine::Get(), TEXT("CSDebugAutoPilotBatchLane="), LaneNum);
+		mLaneNumList.Add(FMath::Clamp(LaneNum, 1, sMaxLaneNum));
+	}
+
+	mbFastForward = FParse::Param(FCommandLine::Get(), TEXT("CSDebugAutoPilotFastForward"));
+	mbFailOnHitch = FParse::Param(FCommandLine::Get(), TEXT("CSDebugAutoPilotBatchFailOnHitch"));
+	mbIgnoreLaneDiverged = FParse::Param(FCommandLine::Get(), TEXT("CSDebugAutoPilotBatchIgnoreLaneDiverged"));
+	mRoundIndex = 0;
+	mFailedNum = 0;
+	mbCreatedPlayer = false;
+	mStateBeginSec = FPlatformTime::Seconds();
+	mState = EState::WaitPlayer;
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Batch : %d record Lane %s"), mFileNameList.Num(),
+		*FString::JoinBy(mLaneNumList, TEXT(","), [](const int32 InLaneNum) { return FString::FromInt(InLaneNum); }));
+	if (mFileNameList.Num() == 0)
+	{
+		FinishAll();
+	}
+}
+
+/**
+ * @brief	Tick
+ */
+bool	UCSDebugAutoPilotBatchRunner::DebugTick(float InDeltaSecond)
+{
+	const double NowSec = FPlatformTime::Seconds();
+	const float FrameTimeMs = (mLastTickSec > 0.0) ? static_cast<float>((NowSec - mLastTickSec) * 1000.0) : 0.f;
+	mLastTickSec = NowSec;
+
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	switch (mState)
+	{
+	case EState::WaitPlayer:
+		if (PrepareLaneList())
+		{
+			BeginRound();
+		}
+		else if (NowSec - mStateBeginSec > CSDebugConfig->mAutoPilot_BatchTimeoutSec)
+		{
+			if (mLaneList.Num() > 0)
+			{
+				//画面分割の人数制限等で揃わなければ居る分だけで
+				UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Batch : Lane %d/%d"), mLaneList.Num(), mLaneNumList[mRoundIndex]);
+				BeginRound();
+			}
+			else
+			{
+				UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Batch : NoPlayer"));
+				mFailedNum += mFileNameList.Num();
+				FinishAll();
+			}
+		}
+		break;
+	case EState::Play:
+	{
+		++mRoundFrameNum;
+		mRoundFrameTimeMs += FrameTimeMs;
+		bool bAnyPlay = false;
+		for (FLane& Lane : mLaneList)
+		{
+			UpdateLane(Lane, NowSec, FrameTimeMs);
+			bAnyPlay |= (Lane.mFileIndex != INDEX_NONE);
+		}
+		if (!bAnyPlay)
+		{
+			if (mNextFileIndex >= mFileNameList.Num())
+			{
+				EndRound();
+			}
+			else
+			{
+				//再生できる枠が居なくなったので探し直し
+				mbCreatedPlayer = false;
+				mStateBeginSec = NowSec;
+				mState = EState::WaitPlayer;
+			}
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	return true;
+}
+
+/**
+ * @brief	CSDebugAutoPilotComponentを持ってるPlayerControllerを同時再生数分集める
+ *			足りなければローカルプレイヤーを足す(PlayerControllerのクラスにComponentが付いてる前提)
+ */
+bool	UCSDebugAutoPilotBatchRunner::PrepareLaneList()
+{
+	mLaneList.Reset();
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return false;
+	}
+
+	const int32 LaneNum = mLaneNumList[mRoundIndex];
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (mLaneList.Num() >= LaneNum)
+		{
+			break;
+		}
+		APlayerController* PlayerController = Iterator->Get();
+		if (PlayerController
+			&& PlayerController->GetPawn())
+		{
+			if (UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>())
+			{
+				mLaneList.AddDefaulted_GetRef().mAutoPilotComponent = AutoPilotComponent;
+			}
+		}
+	}
+	if (mLaneList.Num() >= LaneNum)
+	{
+		return true;
+	}
+
+	if (!mbCreatedPlayer
+		&& mLaneList.Num() > 0)
+	{
+		mbCreatedPlayer = true;
+		for (int32 i = World->GetNumPlayerControllers(); i < LaneNum; ++i)
+		{
+			if (UGameplayStatics::CreatePlayer(World, -1, true) == nullptr)
+			{
+				UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Batch : failed to create player %d"), i);
+				break;
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief	今の同時再生数で全入力記録の再生開始
+ */
+void	UCSDebugAutoPilotBatchRunner::BeginRound()
+{
+	const double NowSec = FPlatformTime::Seconds();
+	mNextFileIndex = 0;
+	mRoundBeginSec = NowSec;
+	mRoundSimSec = 0.0;
+	mRoundFrameTimeMs = 0.0;
+	mRoundFrameNum = 0;
+	mRoundFailedNum = 0;
+	mRoundDivergedNum = 0;
+	mState = EState::Play;
+	for (FLane& Lane : mLaneList)
+	{
+		Lane.mStateBeginSec = NowSec;
+		BeginPlayRecord(Lane);
+	}
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Batch : Begin Lane %d"), mLaneList.Num());
+}
+
+/**
+ * @brief	今の同時再生数の集計 次の同時再生数へ
+ */
+void	UCSDebugAutoPilotBatchRunner::EndRound()
+{
+	FCSDebugAutoPilotBatchScalingResult& Scaling = mScalingReport.mList.AddDefaulted_GetRef();
+	Scaling.mLaneNum = mLaneList.Num();
+	Scaling.mRecordNum = mFileNameList.Num();
+	Scaling.mFailedNum = mRoundFailedNum;
+	Scaling.mDivergedNum = mRoundDivergedNum;
+	Scaling.mFrameNum = mRoundFrameNum;
+	Scaling.mFrameTimeAverageMs = (mRoundFrameNum > 0) ? static_cast<float>(mRoundFrameTimeMs / mRoundFrameNum) : 0.f;
+	Scaling.mWallSec = static_cast<float>(FPlatformTime::Seconds() - mRoundBeginSec);
+	Scaling.mSimSec = static_cast<float>(mRoundSimSec);
+	Scaling.mThroughput = (Scaling.mWallSec > 0.f) ? Scaling.mSimSec / Scaling.mWallSec : 0.f;
+	const float BaseThroughput = mScalingReport.mList[0].mThroughput;
+	Scaling.mScaling = (BaseThroughput > 0.f) ? Scaling.mThroughput / BaseThroughput : 0.f;
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Batch : End Lane %d Wall %.2fs Sim %.2fs Throughput x%.2f Scaling %.2f Failed %d Diverged %d"),
+		Scaling.mLaneNum, Scaling.mWallSec, Scaling.mSimSec, Scaling.mThroughput, Scaling.mScaling, Scaling.mFailedNum, Scaling.mDivergedNum);
+
+	mLaneList.Reset();
+	++mRoundIndex;
+	mbCreatedPlayer = false;
+	mStateBeginSec = FPlatformTime::Seconds();
+	mState = EState::WaitPlayer;
+	if (mRoundIndex >= mLaneNumList.Num())
+	{
+		FinishAll();
+	}
+}
+
+/**
+ * @brief	1枠分の再生状態の監視(空いたら次の入力記録へ)
+ */
+void	UCSDebugAutoPilotBatchRunner::UpdateLane(FLane& InLane, const double InNowSec, const float InFrameTimeMs)
+{
+	if (InLane.mFileIndex == INDEX_NONE)
+	{
+		BeginPlayRecord(InLane);
+		return;
+	}
+
+	//再生が始まったら記録の長さで見る(再生しっぱなしで終わらない,チェックサムが来ない時に止まらないように)
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	const double TimeoutSec = InLane.mbPlayBegin ? InLane.mPlayTimeoutSec : CSDebugConfig->mAutoPilot_BatchTimeoutSec;
+	const bool bTimeout = (InNowSec - InLane.mStateBeginSec > TimeoutSec);
+	const UCSDebugAutoPilotComponent* AutoPilotComponent = InLane.mAutoPilotComponent.Get();
+	const UCSDebugAutoPilotModeRecord* ModeRecord = AutoPilotComponent ? AutoPilotComponent->GetModeRecord() : nullptr;
+	if (AutoPilotComponent == nullptr)
+	{
+		EndPlayRecord(InLane, TEXT("NoPlayer"));
+	}
+	else if (ModeRecord == nullptr
+		|| !ModeRecord->IsActivePlayInputRecord())
+	{
+		EndPlayRecord(InLane, TEXT("LoadFailed"));
+	}
+	else if (ModeRecord->IsFinihPlay()
+		&& ModeRecord->GetChecksumResult().mbReported)
+	{
+		EndPlayRecord(InLane, ModeRecord->GetChecksumResult().IsDiverged() ? TEXT("Diverged") : TEXT("Success"));
+	}
+	else if (bTimeout)
+	{
+		EndPlayRecord(InLane, TEXT("Timeout"));
+	}
+	else if (ModeRecord->IsPlayingInputRecord())
+	{
+		//ロード待ちや開始位置へのワープ中は数えない
+		if (!InLane.mbPlayBegin)
+		{
+			InLane.mbPlayBegin = true;
+			InLane.mStateBeginSec = InNowSec;
+		}
+		InLane.mFrameTimeList.Add(InFrameTimeMs);
+		InLane.mPeakUsedPhysical = FMath::Max<uint64>(InLane.mPeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	}
+}
+
+/**
+ * @brief	空いた枠で次の入力記録の再生開始
+ */
+void	UCSDebugAutoPilotBatchRunner::BeginPlayRecord(FLane& InLane)
+{
+	UCSDebugAutoPilotComponent* AutoPilotComponent = InLane.mAutoPilotComponent.Get();
+	if (AutoPilotComponent == nullptr
+		|| mNextFileIndex >= mFileNameList.Num())
+	{
+		return;
+	}
+
+	InLane.mFileIndex = mNextFileIndex;
+	++mNextFileIndex;
+	const FString& FileName = mFileNameList[InLane.mFileIndex];
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Batch : Begin %s (%d/%d) Lane %d"),
+		*FileName, InLane.mFileIndex + 1, mFileNameList.Num(), static_cast<int32>(&InLane - mLaneList.GetData()));
+
+	//計測中に伸ばさないように記録のフレーム数分先に確保しておく
+	const uint32 EndFrame = sReadRecordEndFrame(FileName);
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	InLane.mFrameTimeList.Reset(EndFrame + 1);
+	InLane.mPeakUsedPhysical = 0;
+	InLane.mPlayTimeoutSec = static_cast<double>(EndFrame + 1) / UCSDebugAutoPilotModeRecord::sRecordFrameRate + CSDebugConfig->mAutoPilot_BatchTimeoutSec;
+	InLane.mbPlayBegin = false;
+	InLane.mStateBeginSec = FPlatformTime::Seconds();
+	AutoPilotComponent->SetFastForward(mbFastForward, true);
+	AutoPilotComponent->RequestPlayInputRecord(FileName);
+}
+
+/**
+ * @brief	再生結果を書き出して枠を空ける
+ *			同時再生数を変えて回す時は Result/Lane<N>/ に分ける
+ */
+void	UCSDebugAutoPilotBatchRunner::EndPlayRecord(FLane& InLane, const TCHAR* InResult)
+{
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	FCSDebugAutoPilotBatchResult Result;
+	Result.mFileName = mFileNameList[InLane.mFileIndex];
+	Result.mResult = InResult;
+	Result.mHitchThresholdMs = CSDebugConfig->mAutoPilot_BatchHitchMilliSec;
+	Result.mPeakUsedPhysicalMB = static_cast<float>(static_cast<double>(InLane.mPeakUsedPhysical) / (1024.0 * 1024.0));
+	Result.mLaneNum = mLaneList.Num();
+	Result.mLaneIndex = static_cast<int32>(&InLane - mLaneList.GetData());
+
+	TArray<float>& FrameTimeList = InLane.mFrameTimeList;
+	FrameTimeList.Sort();
+	Result.mFrameNum = FrameTimeList.Num();
+	if (FrameTimeList.Num() > 0)
+	{
+		float TotalMs = 0.f;
+		for (const float FrameTimeMs : FrameTimeList)
+		{
+			TotalMs += FrameTimeMs;
+			if (FrameTimeMs > Result.mHitchThresholdMs)
+			{
+				++Result.mHitchNum;
+			}
+		}
+		Result.mFrameTimeAverageMs = TotalMs / FrameTimeList.Num();
+		Result.mFrameTimeP50Ms = sGetPercentile(FrameTimeList, 0.5f);
+		Result.mFrameTimeP90Ms = sGetPercentile(FrameTimeList, 0.9f);
+		Result.mFrameTimeP95Ms = sGetPercentile(FrameTimeList, 0.95f);
+		Result.mFrameTimeP99Ms = sGetPercentile(FrameTimeList, 0.99f);
+		Result.mFrameTimeMaxMs = FrameTimeList.Last();
+	}
+
+	UCSDebugAutoPilotComponent* AutoPilotComponent = InLane.mAutoPilotComponent.Get();
+	if (const UCSDebugAutoPilotModeRecord* ModeRecord = AutoPilotComponent ? AutoPilotComponent->GetModeRecord() : nullptr)
+	{
+		const UCSDebugAutoPilotModeRecord::FChecksumResult& ChecksumResult = ModeRecord->GetChecksumResult();
+		Result.mFinalChecksum = ChecksumResult.mLastChecksum;
+		Result.mChecksumCheckNum = ChecksumResult.mCheckNum;
+		Result.mChecksumDivergeNum = ChecksumResult.mDivergeNum;
+		Result.mFirstDivergeFrame = ChecksumResult.IsDiverged() ? static_cast<int32>(ChecksumResult.mFirstDivergeFrame) : INDEX_NONE;
+		Result.mSpeedRate = ModeRecord->GetPlaySpeedRate();
+		Result.mSimSec = static_cast<float>(ModeRecord->GetPlaySimSec());
+	}
+	if (AutoPilotComponent)
+	{
+		AutoPilotComponent->RequestIdleRecord();
+	}
+	if (mbFailOnHitch
+		&& Result.mHitchNum > 0
+		&& Result.mResult == TEXT("Success"))
+	{
+		Result.mResult = TEXT("Hitch");
+	}
+
+	const FString ResultDir = (mLaneNumList.Num() > 1) ? FString::Printf(TEXT("Result/Lane%d/"), Result.mLaneNum) : FString(TEXT("Result/"));
+	const FString ResultPath = sGetRecordDir() + ResultDir + FPaths::GetBaseFilename(Result.mFileName) + TEXT(".json");
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(ResultPath), true);
+	FFileHelper::SaveStringToFile(Result.ToJson(), *ResultPath);
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Batch : End %s %s Frame %d P50 %.2fms P99 %.2fms Hitch %d Peak %.1fMB Checksum %08x Lane %d"),
+		*Result.mFileName, *Result.mResult, Result.mFrameNum, Result.mFrameTimeP50Ms, Result.mFrameTimeP99Ms,
+		Result.mHitchNum, Result.mPeakUsedPhysicalMB, Result.mFinalChecksum, Result.mLaneIndex);
+
+	//同時再生は同じワールドでPawn同士が干渉してズレるので 失敗ではなく別に数える
+	if (Result.mLaneNum > 1
+		&& Result.mResult == TEXT("Diverged"))
+	{
+		++mDivergedNum;
+		++mRoundDivergedNum;
+	}
+	else if (Result.mResult != TEXT("Success"))
+	{
+		++mFailedNum;
+		++mRoundFailedNum;
+	}
+	mRoundSimSec += Result.mSimSec;
+
+	InLane.mFileIndex = INDEX_NONE;
+	InLane.mStateBeginSec = FPlatformTime::Seconds();
+}
+
+/**
+ * @brief	全部終わったのでゲームを終了
+ *			同時再生数を変えて回してたら集計も書き出す
+ */
+void	UCSDebugAutoPilotBatchRunner::FinishAll()
+{
+	mState = EState::Finish;
+	if (mScalingReport.mList.Num() > 1
+		|| (mScalingReport.mList.Num() == 1 && mScalingReport.mList[0].mLaneNum > 1))
+	{
+		const FString ScalingPath = sGetRecordDir() + TEXT("Result/Scaling.json");
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(ScalingPath), true);
+		FFileHelper::SaveStringToFile(mScalingReport.ToJson(), *ScalingPath);
+	}
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Batch : Finish %d record Failed %d Diverged(Lane>1) %d"), mFileNameList.Num(), mFailedNum, mDivergedNum);
+	const bool bFailed = (mFailedNum > 0)
+		|| (mDivergedNum > 0 && !mbIgnoreLaneDiverged);
+	FPlatformMisc::RequestExitWithStatus(false, bFailed ? 1 : 0);
+}
+
+#endif//USE_CSDEBUG
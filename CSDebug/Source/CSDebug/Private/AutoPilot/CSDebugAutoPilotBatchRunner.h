@@ -0,0 +1,193 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotBatchRunner.h
+ * @brief 自動入力 入力記録の一括再生(-nullrhi等での夜間計測用)
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Serialization/JsonSerializerMacros.h"
+#include "CSDebugAutoPilotBatchRunner.generated.h"
+
+class UCSDebugAutoPilotComponent;
+
+/* ------------------------------------------------------------
+   !入力記録1つ分の再生結果
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotBatchResult : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE("mFileName", mFileName);
+	JSON_SERIALIZE("mResult", mResult);
+	JSON_SERIALIZE("mFrameNum", mFrameNum);
+	JSON_SERIALIZE("mFrameTimeAverageMs", mFrameTimeAverageMs);
+	JSON_SERIALIZE("mFrameTimeP50Ms", mFrameTimeP50Ms);
+	JSON_SERIALIZE("mFrameTimeP90Ms", mFrameTimeP90Ms);
+	JSON_SERIALIZE("mFrameTimeP95Ms", mFrameTimeP95Ms);
+	JSON_SERIALIZE("mFrameTimeP99Ms", mFrameTimeP99Ms);
+	JSON_SERIALIZE("mFrameTimeMaxMs", mFrameTimeMaxMs);
+	JSON_SERIALIZE("mHitchThresholdMs", mHitchThresholdMs);
+	JSON_SERIALIZE("mHitchNum", mHitchNum);
+	JSON_SERIALIZE("mPeakUsedPhysicalMB", mPeakUsedPhysicalMB);
+	JSON_SERIALIZE("mFinalChecksum", mFinalChecksum);
+	JSON_SERIALIZE("mChecksumCheckNum", mChecksumCheckNum);
+	JSON_SERIALIZE("mChecksumDivergeNum", mChecksumDivergeNum);
+	JSON_SERIALIZE("mFirstDivergeFrame", mFirstDivergeFrame);
+	JSON_SERIALIZE("mSpeedRate", mSpeedRate);
+	JSON_SERIALIZE("mSimSec", mSimSec);
+	JSON_SERIALIZE("mLaneNum", mLaneNum);
+	JSON_SERIALIZE("mLaneIndex", mLaneIndex);
+	END_JSON_SERIALIZER
+
+		FString	mFileName;
+	FString	mResult;//Success,Diverged,Hitch,LoadFailed,Timeout,NoPlayer
+	int32	mFrameNum = 0;
+	float	mFrameTimeAverageMs = 0.f;
+	float	mFrameTimeP50Ms = 0.f;
+	float	mFrameTimeP90Ms = 0.f;
+	float	mFrameTimeP95Ms = 0.f;
+	float	mFrameTimeP99Ms = 0.f;
+	float	mFrameTimeMaxMs = 0.f;
+	float	mHitchThresholdMs = 0.f;
+	int32	mHitchNum = 0;
+	float	mPeakUsedPhysicalMB = 0.f;
+	uint32	mFinalChecksum = 0;
+	uint32	mChecksumCheckNum = 0;
+	uint32	mChecksumDivergeNum = 0;
+	int32	mFirstDivergeFrame = INDEX_NONE;
+	float	mSpeedRate = 0.f;//ゲーム時間/実時間
+	float	mSimSec = 0.f;//再生したゲーム時間
+	int32	mLaneNum = 1;//同時再生数
+	int32	mLaneIndex = 0;//何番目の枠で再生したか
+};
+
+/* ------------------------------------------------------------
+   !同時再生数1回分の集計
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotBatchScalingResult : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE("mLaneNum", mLaneNum);
+	JSON_SERIALIZE("mRecordNum", mRecordNum);
+	JSON_SERIALIZE("mFailedNum", mFailedNum);
+	JSON_SERIALIZE("mDivergedNum", mDivergedNum);
+	JSON_SERIALIZE("mFrameNum", mFrameNum);
+	JSON_SERIALIZE("mFrameTimeAverageMs", mFrameTimeAverageMs);
+	JSON_SERIALIZE("mWallSec", mWallSec);
+	JSON_SERIALIZE("mSimSec", mSimSec);
+	JSON_SERIALIZE("mThroughput", mThroughput);
+	JSON_SERIALIZE("mScaling", mScaling);
+	END_JSON_SERIALIZER
+
+		int32	mLaneNum = 0;
+	int32	mRecordNum = 0;
+	int32	mFailedNum = 0;
+	int32	mDivergedNum = 0;//同時再生時のズレ(Pawn同士が干渉するので失敗には数えない)
+	int32	mFrameNum = 0;
+	float	mFrameTimeAverageMs = 0.f;
+	float	mWallSec = 0.f;
+	float	mSimSec = 0.f;//全枠で再生したゲーム時間の合計
+	float	mThroughput = 0.f;//mSimSec/mWallSec
+	float	mScaling = 0.f;//最初の集計に対するmThroughputの倍率
+};
+
+/* ------------------------------------------------------------
+   !同時再生数毎の集計一覧(Result/Scaling.json)
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotBatchScalingReport : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE_ARRAY_SERIALIZABLE("mScalingList", mList, FCSDebugAutoPilotBatchScalingResult);
+	END_JSON_SERIALIZER
+
+		TArray<FCSDebugAutoPilotBatchScalingResult>	mList;
+};
+
+/**
+ * 起動引数 -CSDebugAutoPilotBatch[=A,B.csrec] で指定された入力記録を順番に再生して
+ * Saved/CSDebug/AutoPilot/Result/ に1ファイルずつ結果を書き出す
+ * ファイル指定が無ければ Saved/CSDebug/AutoPilot/ の入力記録全部
+ * 全部終わったら終了する(ズレや失敗があれば終了コード1)
+ * -CSDebugAutoPilotFastForward で早送り(描画も止める)
+ * -CSDebugAutoPilotBatchFailOnHitch でヒッチがあれば失敗扱い(入力記録の縮小の判定用)
+ * -CSDebugAutoPilotBatchLane=N で同じワールドのN人のローカルプレイヤーに別々の入力記録を同時に再生させる
+ * -CSDebugAutoPilotBatchScaling で同時再生数1,2,4,8で順に全部再生して Result/Scaling.json に集計を書き出す
+ * (ワールドのTickはゲームスレッドでしか回せないので 1プロセスで並べるのはワールドではなくプレイヤー)
+ * (同時再生時は1枠1コントローラの入力記録を使う Pawn同士がぶつかるとズレとして出るので負荷計測向け)
+ * (Scaling.jsonのThroughput/Scalingは独立したワールドの並列ではなく 同じワールドの分割画面プレイヤーを増やした時の値)
+ * (同時再生数2以上のズレは失敗に数えず集計のmDivergedNumに分けて出すが 終了コードは1にする)
+ * -CSDebugAutoPilotBatchIgnoreLaneDiverged で同時再生数2以上のズレでは終了コードを1にしない
+ */
+UCLASS()
+class CSDEBUG_API UCSDebugAutoPilotBatchRunner : public UObject
+{
+	GENERATED_BODY()
+
+	/* ------------------------------------------------------------
+	   !状態
+	------------------------------------------------------------ */
+	enum class EState : uint8
+	{
+		WaitPlayer,
+		Play,
+		Finish,
+	};
+	/* ------------------------------------------------------------
+	   !同時再生の1枠分(ローカルプレイヤー1人)
+	------------------------------------------------------------ */
+	struct FLane
+	{
+		TWeakObjectPtr<UCSDebugAutoPilotComponent>	mAutoPilotComponent;
+		TArray<float>	mFrameTimeList;//再生中のフレーム時間(ms)
+		double	mStateBeginSec = 0.0;
+		double	mPlayTimeoutSec = 0.0;//再生が始まってからのタイムアウト(記録の長さ+余裕)
+		uint64	mPeakUsedPhysical = 0;
+		int32	mFileIndex = INDEX_NONE;//再生中の入力記録(INDEX_NONEなら空き)
+		bool	mbPlayBegin = false;//ロード,開始位置へのワープが終わって再生が始まった
+	};
+	static const int32	sMaxLaneNum = 8;
+
+#if USE_CSDEBUG
+public:
+	static bool	sIsRequested();
+
+	void	Init();
+	bool	DebugTick(float InDeltaSecond);
+	bool	IsFinish() const { return mState == EState::Finish; }
+
+protected:
+	bool	PrepareLaneList();
+	void	BeginRound();
+	void	EndRound();
+	void	UpdateLane(FLane& InLane, const double InNowSec, const float InFrameTimeMs);
+	void	BeginPlayRecord(FLane& InLane);
+	void	EndPlayRecord(FLane& InLane, const TCHAR* InResult);
+	void	FinishAll();
+
+private:
+	TArray<FString>	mFileNameList;
+	TArray<int32>	mLaneNumList;//同時再生数(集計する時は1,2,4,8)
+	TArray<FLane>	mLaneList;
+	FCSDebugAutoPilotBatchScalingReport	mScalingReport;
+	double	mLastTickSec = 0.0;
+	double	mStateBeginSec = 0.0;
+	double	mRoundBeginSec = 0.0;
+	double	mRoundSimSec = 0.0;
+	double	mRoundFrameTimeMs = 0.0;
+	int32	mRoundFrameNum = 0;
+	int32	mRoundFailedNum = 0;
+	int32	mRoundDivergedNum = 0;
+	int32	mRoundIndex = 0;
+	int32	mNextFileIndex = 0;
+	int32	mFailedNum = 0;
+	int32	mDivergedNum = 0;
+	bool	mbFastForward = false;
+	bool	mbFailOnHitch = false;
+	bool	mbIgnoreLaneDiverged = false;//同時再生数2以上のズレを終了コードに入れない
+	bool	mbCreatedPlayer = false;
+	EState	mState = EState::WaitPlayer;
+#endif//USE_CSDEBUG
+};
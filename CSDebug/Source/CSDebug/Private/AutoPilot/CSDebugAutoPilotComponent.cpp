@@ -9,11 +9,22 @@
 
 #include "AutoPilot/CSDebugAutoPilotComponent.h"
 #include "AutoPilot/CSDebugAutoPilotModeRecord.h"
+#include "AutoPilot/CSDebugAutoPilotModeRollingRecord.h"
+#include "AutoPilot/CSDebugAutoPilotModeRandom.h"
+#include "AutoPilot/CSDebugAutoPilotModeCommand.h"
+#include "AutoPilot/CSDebugAutoPilotModeAutoPlay.h"
+#include "CSDebug_Config.h"
+#include "CSDebug_Subsystem.h"
 
 #include "Kismet/GameplayStatics.h"
 #include "Debug/DebugDrawService.h"
 #include "GameFramework/PlayerInput.h"
+#include "GameFramework/PlayerController.h"
 #include "InputCoreTypes.h"
+#include "Engine/GameViewportClient.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 
 // Sets default values for this component's properties
 UCSDebugAutoPilotComponent::UCSDebugAutoPilotComponent()
@@ -32,12 +43,38 @@ void UCSDebugAutoPilotComponent::BeginPlay()
 	Super::BeginPlay();
 
 	RequestDebugDraw(true);
+
+	//常時記録の自動開始(設定か起動引数 ローカルプレイヤー毎)
+	const APlayerController* LocalPlayerController = Cast<APlayerController>(GetOwner());
+	if (LocalPlayerController
+		&& LocalPlayerController->IsLocalPlayerController()
+		&& (GetDefault<UCSDebug_Config>()->mAutoPilot_bRollingRecordAutoStart
+			|| FParse::Param(FCommandLine::Get(), TEXT("CSDebugAutoPilotRollingRecord"))))
+	{
+		RequestBeginRollingRecord();
+	}
+
+	//起動引数で経路の自動移動(GameInstanceで一度だけ 最初のローカルプレイヤーで)
+	const UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	UCSDebug_Subsystem* CSDebugSubsystem = GameInstance ? GameInstance->GetSubsystem<UCSDebug_Subsystem>() : nullptr;
+	if (CSDebugSubsystem
+		&& LocalPlayerController
+		&& LocalPlayerController->IsLocalPlayerController()
+		&& CSDebugSubsystem->TakeAutoPilotRouteCommandLine())
+	{
+		FString RouteName;
+		if (FParse::Value(FCommandLine::Get(), TEXT("-CSDebugAutoPilotRoute="), RouteName))
+		{
+			RequestBeginAutoPlay(RouteName, FParse::Param(FCommandLine::Get(), TEXT("CSDebugAutoPilotRouteQuit")));
+		}
+	}
 }
 void UCSDebugAutoPilotComponent::BeginDestroy()
 {
 	Super::BeginDestroy();
 
 	RequestDebugDraw(false);
+	RequestEndRollingRecord();
  	SetFixFrameRate(false);
  	SetIgnoreDefaultInput(false);
 }
@@ -72,6 +109,11 @@ void UCSDebugAutoPilotComponent::PostProcessInput(float DeltaTime)
  	{
  		mActiveMode->PostProcessInput(DeltaTime);
  	}
+	//再生等で入った入力も含めて記録する
+	if (mRollingRecord)
+	{
+		mRollingRecord->PostProcessInput(DeltaTime);
+	}
 }
 
 /**
@@ -107,6 +149,15 @@ void UCSDebugAutoPilotComponent::SetMode(ECSDebugAutoPilotMode InMode)
 	case ECSDebugAutoPilotMode::Record:
 		mActiveMode = NewObject<UCSDebugAutoPilotModeBase>(this, UCSDebugAutoPilotModeRecord::StaticClass());
 		break;
+	case ECSDebugAutoPilotMode::Random:
+		mActiveMode = NewObject<UCSDebugAutoPilotModeBase>(this, UCSDebugAutoPilotModeRandom::StaticClass());
+		break;
+	case ECSDebugAutoPilotMode::Command:
+		mActiveMode = NewObject<UCSDebugAutoPilotModeBase>(this, UCSDebugAutoPilotModeCommand::StaticClass());
+		break;
+	case ECSDebugAutoPilotMode::AutoPlay:
+		mActiveMode = NewObject<UCSDebugAutoPilotModeBase>(this, UCSDebugAutoPilotModeAutoPlay::StaticClass());
+		break;
 	default:
 		break;
 	}
@@ -159,6 +210,54 @@ bool UCSDebugAutoPilotComponent::IsFinishPlayRecord() const
 	return false;
 }
 
+/**
+ * @brief 再生中の入力記録を指定秒数進める/戻す(近いキーフレームから再開)
+ */
+void UCSDebugAutoPilotComponent::SeekPlayRecord(const float InOffsetSec)
+{
+	if (UCSDebugAutoPilotModeRecord* ModeRecord = Cast<UCSDebugAutoPilotModeRecord>(mActiveMode))
+	{
+		ModeRecord->RequestSeekOffset(FMath::RoundToInt(InOffsetSec * UCSDebugAutoPilotModeRecord::sRecordFrameRate));
+	}
+}
+
+/**
+ * @brief 早送り再生のon/off
+ *			記録時と同じ固定デルタで進めるが フレームレート制限を外して処理できる限り速く回す
+ *			bInSkipRenderならワールドの描画とデバッグ表示も止める
+ */
+void UCSDebugAutoPilotComponent::SetFastForward(const bool bInFastForward, const bool bInSkipRender)
+{
+	const bool bFixFrameRate = IsFixFrameRateMode();
+	if (bFixFrameRate)
+	{
+		SetFixFrameRate(false);
+	}
+	mbFastForward = bInFastForward;
+	mbFastForwardSkipRender = (bInFastForward && bInSkipRender);
+	if (bFixFrameRate)
+	{
+		SetFixFrameRate(true);
+	}
+	RequestDebugDraw(!mbFastForwardSkipRender);
+}
+
+/**
+ * @brief モードの状態に合わせてフレームレート固定を掛け直す(時間基準の再生等で固定しない時用)
+ */
+void UCSDebugAutoPilotComponent::RefreshFixFrameRate()
+{
+	SetFixFrameRate(IsFixFrameRateMode());
+}
+
+/**
+ * @brief 再生,記録中のModeを取得(結果の参照用)
+ */
+const UCSDebugAutoPilotModeRecord* UCSDebugAutoPilotComponent::GetModeRecord() const
+{
+	return Cast<UCSDebugAutoPilotModeRecord>(mActiveMode);
+}
+
 /**
  * @brief コマンド収録開始
  */
@@ -189,6 +288,167 @@ void UCSDebugAutoPilotComponent::RequestIdleRecord()
 	ModeRecord->RequestIdle();
 }
 
+/* ------------------------------------------------------------
+   !常時記録
+------------------------------------------------------------ */
+/**
+ * @brief 直近の入力の常時記録開始
+ *			他のモードとは別に持つので 記録,再生,ランダム入力等に切り替えても続ける
+ */
+void UCSDebugAutoPilotComponent::RequestBeginRollingRecord()
+{
+	if (mRollingRecord != nullptr)
+	{
+		return;
+	}
+	mRollingRecord = NewObject<UCSDebugAutoPilotModeRollingRecord>(this);
+	mRollingRecord->SetParent(this);
+}
+
+/**
+ * @brief 常時記録終了
+ */
+void UCSDebugAutoPilotComponent::RequestEndRollingRecord()
+{
+	if (mRollingRecord == nullptr)
+	{
+		return;
+	}
+	mRollingRecord->MarkPendingKill();
+	mRollingRecord = nullptr;
+}
+
+/**
+ * @brief 常時記録してる直近の入力を再生できる形で保存
+ */
+bool UCSDebugAutoPilotComponent::DumpRollingRecord(const FString& InFileName)
+{
+	if (mRollingRecord)
+	{
+		return mRollingRecord->DumpRecord(InFileName);
+	}
+	return false;
+}
+
+/* ------------------------------------------------------------
+   !ランダム入力
+------------------------------------------------------------ */
+/**
+ * @brief ランダム入力開始(InSeedが0ならConfigか開始時刻 流した入力はInRecordFileNameへ記録)
+ */
+void UCSDebugAutoPilotComponent::RequestBeginRandom(const int32 InSeed, const FString& InRecordFileName)
+{
+	SetMode(ECSDebugAutoPilotMode::Random);
+	UCSDebugAutoPilotModeRandom* ModeRandom = Cast<UCSDebugAutoPilotModeRandom>(mActiveMode);
+	ModeRandom->RequestBegin(InSeed, InRecordFileName);
+}
+
+/**
+ * @brief ランダム入力終了
+ */
+void UCSDebugAutoPilotComponent::RequestEndRandom()
+{
+	if (mMode == ECSDebugAutoPilotMode::Random)
+	{
+		SetMode(ECSDebugAutoPilotMode::Invalid);
+	}
+}
+
+/* ------------------------------------------------------------
+   !コマンドスクリプト
+------------------------------------------------------------ */
+/**
+ * @brief コマンドスクリプト実行開始(Saved/CSDebug/AutoPilot/Script/以下)
+ */
+bool UCSDebugAutoPilotComponent::RequestCommandScript(const FString& InFileName)
+{
+	SetMode(ECSDebugAutoPilotMode::Command);
+	UCSDebugAutoPilotModeCommand* ModeCommand = Cast<UCSDebugAutoPilotModeCommand>(mActiveMode);
+	return ModeCommand->RequestScript(InFileName);
+}
+
+/**
+ * @brief コマンドスクリプト実行終了
+ */
+void UCSDebugAutoPilotComponent::RequestEndCommand()
+{
+	if (mMode == ECSDebugAutoPilotMode::Command)
+	{
+		SetMode(ECSDebugAutoPilotMode::Invalid);
+	}
+}
+
+/**
+ * @brief コマンドスクリプトが最後まで進んだかどうか
+ */
+bool UCSDebugAutoPilotComponent::IsFinishCommand() const
+{
+	if (const UCSDebugAutoPilotModeCommand* ModeCommand = Cast<UCSDebugAutoPilotModeCommand>(mActiveMode))
+	{
+		return ModeCommand->IsFinish();
+	}
+	return true;
+}
+
+/**
+ * @brief	コマンドスクリプトのWaitUntilで使う条件の登録
+ */
+void	UCSDebugAutoPilotComponent::AddCommandConditionDelegate(const FName& InName, const FCSDebugAutoPilotCommandConditionDelegate& InDelegate)
+{
+	mCommandConditionMap.Add(InName, InDelegate);
+}
+
+/* ------------------------------------------------------------
+   !経路の自動移動
+------------------------------------------------------------ */
+/**
+ * @brief 経路の自動移動開始(Saved/CSDebug/AutoPilot/Route/以下 bInQuitOnFinishなら終わったらアプリ終了)
+ */
+bool UCSDebugAutoPilotComponent::RequestBeginAutoPlay(const FString& InRouteName, const bool bInQuitOnFinish)
+{
+	SetMode(ECSDebugAutoPilotMode::AutoPlay);
+	UCSDebugAutoPilotModeAutoPlay* ModeAutoPlay = Cast<UCSDebugAutoPilotModeAutoPlay>(mActiveMode);
+	return ModeAutoPlay->RequestRoute(InRouteName, bInQuitOnFinish);
+}
+
+/**
+ * @brief 経路の自動移動終了
+ */
+void UCSDebugAutoPilotComponent::RequestEndAutoPlay()
+{
+	if (mMode == ECSDebugAutoPilotMode::AutoPlay)
+	{
+		SetMode(ECSDebugAutoPilotMode::Invalid);
+	}
+}
+
+/**
+ * @brief 経路を最後まで進んだかどうか
+ */
+bool UCSDebugAutoPilotComponent::IsFinishAutoPlay() const
+{
+	if (const UCSDebugAutoPilotModeAutoPlay* ModeAutoPlay = Cast<UCSDebugAutoPilotModeAutoPlay>(mActiveMode))
+	{
+		return ModeAutoPlay->IsFinish();
+	}
+	return true;
+}
+
+/**
+ * @brief	入力記録のチェックサムに混ぜる値の登録
+ */
+void	UCSDebugAutoPilotComponent::AddChecksumDelegate(const FCSDebugAutoPilotChecksumDelegate& InDelegate)
+{
+	mChecksumDelegateList.Add(InDelegate);
+}
+/**
+ * @brief	入力記録のチェックサムに混ぜる値の登録解除
+ */
+void	UCSDebugAutoPilotComponent::ClearChecksumDelegate()
+{
+	mChecksumDelegateList.Empty();
+}
+
 /**
  * @brief	Draw登録のon/off
  */
@@ -224,6 +484,11 @@ void	UCSDebugAutoPilotComponent::DebugDraw(UCanvas* InCanvas, APlayerController*
 	{
 		mActiveMode->DebugDraw(InCanvas);
 	}
+	else if (mRollingRecord)
+	{
+		//他のモードの表示と重なるので常時記録だけの時に
+		mRollingRecord->DebugDraw(InCanvas);
+	}
 }
 
 /**
@@ -237,8 +502,11 @@ void UCSDebugAutoPilotComponent::OnBeginMode()
 		SetFixFrameRate(true);
 		break;
 	case ECSDebugAutoPilotMode::Random:
+		SetFixFrameRate(true);
+		SetIgnoreDefaultInput(true);
 		break;
 	case ECSDebugAutoPilotMode::Command:
+	case ECSDebugAutoPilotMode::AutoPlay:
 		SetIgnoreDefaultInput(true);
 		break;
 	default:
@@ -257,8 +525,26 @@ void UCSDebugAutoPilotComponent::OnEndMode()
 		SetFixFrameRate(false);
 		break;
 	case ECSDebugAutoPilotMode::Random:
+		//他のモードへ切り替わる時も記録を閉じる
+		if (UCSDebugAutoPilotModeRandom* ModeRandom = Cast<UCSDebugAutoPilotModeRandom>(mActiveMode))
+		{
+			ModeRandom->RequestEnd();
+		}
+		SetFixFrameRate(false);
+		SetIgnoreDefaultInput(false);
 		break;
 	case ECSDebugAutoPilotMode::Command:
+		if (UCSDebugAutoPilotModeCommand* ModeCommand = Cast<UCSDebugAutoPilotModeCommand>(mActiveMode))
+		{
+			ModeCommand->RequestEnd();
+		}
+		SetIgnoreDefaultInput(false);
+		break;
+	case ECSDebugAutoPilotMode::AutoPlay:
+		if (UCSDebugAutoPilotModeAutoPlay* ModeAutoPlay = Cast<UCSDebugAutoPilotModeAutoPlay>(mActiveMode))
+		{
+			ModeAutoPlay->RequestEnd();
+		}
 		SetIgnoreDefaultInput(false);
 		break;
 	default:
@@ -274,90 +560,77 @@ void UCSDebugAutoPilotComponent::SetFixFrameRate(bool InFix)
 #if 1//4.21で固定方法が変わった？
 	if (GEngine)
 	{
-		GEngine->bUseFixedFrameRate = InFix;
+		GEngine->bUseFixedFrameRate = (InFix && !mbFastForward);
 		GEngine->FixedFrameRate = 30.f;
 	}
 #else
 	FApp::SetUseFixedTimeStep(true);
 	FApp::SetFixedDeltaTime(0.008888);
 #endif
-}
-
-
-#if 0
-
-/**
- * @brief	ランダムインプット開始
- */
-void UCSDebugAutoPilotComponent::RequestBeginRandom()
-{
-	SetMode(ECSDebugAutoPilotMode::Random);
-	UAutoPilotModeRandom* ModeRandom = Cast<UAutoPilotModeRandom>(mActiveMode);
-	ModeRandom->RequestBegin();
-	SetIgnoreDefaultInput(true);
 
-	UDebugCommandManager* DebugCommandManager = GetDebugCommandManager();
-	if (DebugCommandManager)
+	//早送りは固定タイムステップにしてフレーム待ちを無くす(-benchmarkと同じ)
+	//プロセス全体の設定なので 早送り終了時は元の値に戻す
+	const bool bFixedTimeStep = (InFix && mbFastForward);
+	if (mbFixedTimeStep != bFixedTimeStep)
 	{
-		DebugCommandManager->SetSleep(true);
+		mbFixedTimeStep = bFixedTimeStep;
+		if (bFixedTimeStep)
+		{
+			mbPrevUseFixedTimeStep = FApp::UseFixedTimeStep();
+			mPrevFixedDeltaTime = FApp::GetFixedDeltaTime();
+			FApp::SetUseFixedTimeStep(true);
+			FApp::SetFixedDeltaTime(1.0 / 30.0);
+		}
+		else
+		{
+			FApp::SetUseFixedTimeStep(mbPrevUseFixedTimeStep);
+			FApp::SetFixedDeltaTime(mPrevFixedDeltaTime);
+		}
 	}
-}
-
-/**
- * @brief	ランダムインプット終了
- */
-void UCSDebugAutoPilotComponent::RequestEndRandom()
-{
-	SetMode(ECSDebugAutoPilotMode::Random);
-	UAutoPilotModeRandom* ModeRandom = Cast<UAutoPilotModeRandom>(mActiveMode);
-	ModeRandom->RequestEnd();
-	SetIgnoreDefaultInput(false);
 
-	UDebugCommandManager* DebugCommandManager = GetDebugCommandManager();
-	if (DebugCommandManager)
+	const bool bSkipRender = (InFix && mbFastForwardSkipRender);
+	if (mbSkipRender != bSkipRender)
 	{
-		DebugCommandManager->SetSleep(false);
+		UWorld* World = GetWorld();
+		if (UGameViewportClient* GameViewportClient = World ? World->GetGameViewport() : nullptr)
+		{
+			mbSkipRender = bSkipRender;
+			if (bSkipRender)
+			{
+				mbPrevDisableWorldRendering = GameViewportClient->bDisableWorldRendering;
+				GameViewportClient->bDisableWorldRendering = true;
+			}
+			else
+			{
+				GameViewportClient->bDisableWorldRendering = mbPrevDisableWorldRendering;
+			}
+		}
 	}
 }
 
-/**
- * @brief	AutoPlay開始
- */
-void UCSDebugAutoPilotComponent::RequestBeginAutoPlay()
-{
-	_LOG(LogAI, Log, TEXT("BeginAutoPlay"));
-
-	SetMode(ECSDebugAutoPilotMode::AutoPlay);
-	UAutoPilotModeAutoPlay* ModeAutoPlay = Cast<UAutoPilotModeAutoPlay>(mActiveMode);
-	ModeAutoPlay->RequestBegin();
-	SetIgnoreDefaultInput(true);
-
-	UDebugCommandManager* DebugCommandManager = GetDebugCommandManager();
-	if (DebugCommandManager)
-	{
-		DebugCommandManager->SetSleep(true);
-	}
-}
 
 /**
- * @brief	AutoPlay終了
+ * @brief	フレームレートを固定するモードか
  */
-void UCSDebugAutoPilotComponent::RequestEndAutoPlay()
+bool UCSDebugAutoPilotComponent::IsFixFrameRateMode() const
 {
-	if (UAutoPilotModeAutoPlay* ModeAutoPlay = Cast<UAutoPilotModeAutoPlay>(mActiveMode))
+	switch (mMode)
 	{
-		ModeAutoPlay->RequestEnd();
+	case ECSDebugAutoPilotMode::Record:
+		if (const UCSDebugAutoPilotModeRecord* ModeRecord = Cast<UCSDebugAutoPilotModeRecord>(mActiveMode))
+		{
+			return ModeRecord->IsFixFrameRate();
+		}
+		return true;
+	case ECSDebugAutoPilotMode::Random:
+		return true;
+	default:
+		return false;
 	}
-	SetIgnoreDefaultInput(false);
+}
 
-	SetMode(ECSDebugAutoPilotMode::Invalid);
 
-	UDebugCommandManager* DebugCommandManager = GetDebugCommandManager();
-	if (DebugCommandManager)
-	{
-		DebugCommandManager->SetSleep(false);
-	}
-}
+#if 0
 
 /**
  * @brief	SemiAutoPlay開始
@@ -500,28 +773,6 @@ bool UCSDebugAutoPilotComponent::IsFinishLastCommand()
 	}
 	return false;
 }
-/**
- * @brief	全コマンド終了かどうか
- */
-bool UCSDebugAutoPilotComponent::IsFinishAllCommand()
-{
-	UAutoPilotModeCommand* ModeCommand = Cast<UAutoPilotModeCommand>(mActiveMode);
-	if (ModeCommand)
-	{
-		return !ModeCommand->IsOwnCommand();
-	}
-	return true;
-}
-/**
- * @brief	CommandScriptリクエスト
- */
-bool UCSDebugAutoPilotComponent::RequestCommandScript(FString InPath)
-{
-	SetMode(ECSDebugAutoPilotMode::Command);
-	UAutoPilotModeCommand* ModeCommand = Cast<UAutoPilotModeCommand>(mActiveMode);
-	ModeCommand->RequestCommandScript(InPath);
-	return true;
-}
 /**
  * @brief	Moveモードの移動先取得
  */
@@ -0,0 +1,597 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotModeAutoPlay.cpp
+ * @brief 自動入力 経路(ウェイポイント列)をナビメッシュに沿って歩かせるモード
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotModeAutoPlay.h"
+#include "AutoPilot/CSDebugAutoPilotComponent.h"
+#include "CSDebug_Subsystem.h"
+#include "CSDebug_Config.h"
+
+#include "NavigationSystem.h"
+#include "NavigationPath.h"
+#include "Components/SplineComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotBeginAutoPlayCommand(
+	TEXT("CSDebug.AutoPilot.BeginAutoPlay"),
+	TEXT("CSDebug.AutoPilot.BeginAutoPlay RouteName : Saved/CSDebug/AutoPilot/Route/RouteName.json(無ければ同名のスプラインを持つアクター)の経路を歩かせる"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+		if (AutoPilotComponent == nullptr
+			|| InArgs.Num() < 1)
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("BeginAutoPlay : UCSDebugAutoPilotComponent or RouteName not found"));
+			return;
+		}
+		AutoPilotComponent->RequestBeginAutoPlay(InArgs[0]);
+	})
+);
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotEndAutoPlayCommand(
+	TEXT("CSDebug.AutoPilot.EndAutoPlay"),
+	TEXT("CSDebug.AutoPilot.EndAutoPlay : 経路の自動移動を止める(そこまでの結果を書き出す)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		if (UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr)
+		{
+			AutoPilotComponent->RequestEndAutoPlay();
+		}
+	})
+);
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotAddRouteWaypointCommand(
+	TEXT("CSDebug.AutoPilot.AddRouteWaypoint"),
+	TEXT("CSDebug.AutoPilot.AddRouteWaypoint RouteName : 今のPawnの位置とカメラの向きを経路の最後に追加"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		const APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		if (PlayerController == nullptr
+			|| InArgs.Num() < 1)
+		{
+			return;
+		}
+		UCSDebugAutoPilotModeAutoPlay::sAddWaypoint(InArgs[0], *PlayerController);
+	})
+);
+
+namespace
+{
+	const float	sPathPointAcceptRadius = 50.f;//ナビメッシュの経路の途中の点を通過したとみなす距離
+	const float	sStuckProgressDistance = 10.f;//これ以上近づいたら進んでるとみなす
+
+	float	sGetPercentile(const TArray<float>& InSortedList, const float InRate)
+	{
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(InRate * InSortedList.Num()) - 1, 0, InSortedList.Num() - 1);
+		return InSortedList[Index];
+	}
+
+	FString	sGetRoutePath(const FString& InRouteName)
+	{
+		FString Path = UCSDebugAutoPilotModeAutoPlay::sGetRouteDir() + InRouteName;
+		if (FPaths::GetExtension(InRouteName).IsEmpty())
+		{
+			Path += TEXT(".json");
+		}
+		return Path;
+	}
+
+	void	sWarpPawn(APawn& InPawn, const FVector& InPos)
+	{
+		//経路の点は足元なのでコリジョンの半分だけ上げる
+		const FVector Pos = InPos + FVector(0.f, 0.f, InPawn.GetSimpleCollisionHalfHeight());
+		InPawn.SetActorLocation(Pos, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+}
+
+/**
+ * @brief	経路のディレクトリ
+ */
+FString	UCSDebugAutoPilotModeAutoPlay::sGetRouteDir()
+{
+	return FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/Route/");
+}
+
+/**
+ * @brief	今の位置とカメラの向きを経路の最後に追加(経路作成用)
+ */
+bool	UCSDebugAutoPilotModeAutoPlay::sAddWaypoint(const FString& InRouteName, const APlayerController& InPlayerController)
+{
+	const APawn* Pawn = InPlayerController.GetPawn();
+	if (Pawn == nullptr)
+	{
+		return false;
+	}
+
+	const FString Path = sGetRoutePath(InRouteName);
+	FCSDebugAutoPilotRoute Route;
+	FString Text;
+	if (FFileHelper::LoadFileToString(Text, *Path))
+	{
+		Route.FromJson(Text);
+	}
+
+	const FVector Pos = Pawn->GetActorLocation() - FVector(0.f, 0.f, Pawn->GetSimpleCollisionHalfHeight());
+	const FRotator CameraRot = InPlayerController.GetControlRotation();
+	FCSDebugAutoPilotRouteWaypoint Waypoint;
+	Waypoint.mPosX = Pos.X;
+	Waypoint.mPosY = Pos.Y;
+	Waypoint.mPosZ = Pos.Z;
+	Waypoint.mbCamera = true;
+	Waypoint.mCameraPitch = CameraRot.Pitch;
+	Waypoint.mCameraYaw = CameraRot.Yaw;
+	Route.mWaypointList.Add(Waypoint);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	const bool bSave = FFileHelper::SaveStringToFile(Route.ToJson(), *Path);
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot AddRouteWaypoint %s : %d (%.0f, %.0f, %.0f)"), *InRouteName, Route.mWaypointList.Num() - 1, Pos.X, Pos.Y, Pos.Z);
+	return bSave;
+}
+
+/**
+ * @brief	PlayerInputの処理前
+ */
+void	UCSDebugAutoPilotModeAutoPlay::PreProcessInput(float DeltaTime)
+{
+	APlayerController* PlayerControler = GetPlayerController();
+	if (IsFinish()
+		|| PlayerControler == nullptr)
+	{
+		return;
+	}
+
+	PlayerControler->InputAxis(EKeys::Gamepad_LeftX, 0.f, DeltaTime, 1, true);
+	PlayerControler->InputAxis(EKeys::Gamepad_LeftY, 0.f, DeltaTime, 1, true);
+	PlayerControler->InputAxis(EKeys::Gamepad_RightX, 0.f, DeltaTime, 1, true);
+	PlayerControler->InputAxis(EKeys::Gamepad_RightY, 0.f, DeltaTime, 1, true);
+
+	APawn* Pawn = PlayerControler->GetPawn();
+	switch (mState)
+	{
+	case EState::WaitPawn:
+		if (Pawn)
+		{
+			//経路探索の同期処理が最初の周の区間のフレーム時間に入らないよう、計測開始前に全区間分を探しておく
+			PrepareAllPath(Pawn->GetActorLocation());
+			mBeginSec = FPlatformTime::Seconds();
+			mLastFrameSec = 0.0;
+			mLoop = 0;
+			mFromIndex = INDEX_NONE;
+			if (mRoute.mbWarpToStart)
+			{
+				//最初の通過点に着いた所から
+				sWarpPawn(*Pawn, mRoute.mWaypointList[0].GetPos());
+				mToIndex = 0;
+				mStateSec = 0.f;
+				mState = EState::Wait;
+			}
+			else
+			{
+				BeginSegment(0, Pawn->GetActorLocation());
+			}
+		}
+		break;
+	case EState::Move:
+		CaptureFrame();
+		UpdateMove(*PlayerControler, DeltaTime);
+		break;
+	case EState::Wait:
+	{
+		CaptureFrame();
+		mStateSec += DeltaTime;
+		const FCSDebugAutoPilotRouteWaypoint& Waypoint = mRoute.mWaypointList[mToIndex];
+		bool bCameraReady = true;
+		if (Waypoint.mbCamera)
+		{
+			const FRotator CameraRot(Waypoint.mCameraPitch, Waypoint.mCameraYaw, 0.f);
+			UpdateCamera(*PlayerControler, CameraRot, DeltaTime);
+			bCameraReady = PlayerControler->GetControlRotation().Equals(CameraRot, 1.f);
+		}
+		if (bCameraReady
+			&& mStateSec >= Waypoint.mWaitSec)
+		{
+			NextWaypoint();
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	if (mState == EState::Move)
+	{
+		PlayerControler->InputAxis(EKeys::Gamepad_LeftX, mMoveStick.X, DeltaTime, 1, true);
+		PlayerControler->InputAxis(EKeys::Gamepad_LeftY, mMoveStick.Y, DeltaTime, 1, true);
+	}
+}
+
+/**
+ * @brief	Draw
+ */
+void	UCSDebugAutoPilotModeAutoPlay::DebugDraw(class UCanvas* InCanvas)
+{
+	if (IsFinish())
+	{
+		return;
+	}
+
+	if (mState == EState::Move)
+	{
+		AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(ECSDebugAutoPilotKey::LeftStickX, mMoveStick.X));
+		AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(ECSDebugAutoPilotKey::LeftStickY, mMoveStick.Y));
+	}
+	DebugDrawPad(InCanvas);
+
+	mInfoWindow.ClearString();
+	mInfoWindow.SetWindowName(FString::Printf(TEXT("AutoPilot AutoPlay : %s"), *mRouteName));
+	mInfoWindow.AddText(FString::Printf(TEXT("Waypoint : %d -> %d / %d"), mFromIndex, mToIndex, mRoute.mWaypointList.Num()));
+	mInfoWindow.AddText(FString::Printf(TEXT("Loop : %d / %d"), mLoop, mRoute.mLoopNum));
+	if (mPath)
+	{
+		mInfoWindow.AddText(FString::Printf(TEXT("PathPoint : %d / %d%s"), mPathPointIndex, mPath->mPointList.Num(), mPath->mbNavigation ? TEXT("") : TEXT(" (Direct)")));
+	}
+	mInfoWindow.AddText(FString::Printf(TEXT("PathQuery : %d (Cache %d)"), mResult.mPathQueryNum, mResult.mPathCacheHitNum));
+	mInfoWindow.AddText(FString::Printf(TEXT("Stuck : %d"), mResult.mStuckNum));
+	mInfoWindow.FittingWindowExtent(InCanvas);
+	mInfoWindow.Draw(InCanvas, 0.05f, 0.1f);
+}
+
+/**
+ * @brief	経路の自動移動開始
+ *			Route/InRouteName.json が無ければ同名のスプラインを持つアクターの制御点を通過点にする
+ */
+bool	UCSDebugAutoPilotModeAutoPlay::RequestRoute(const FString& InRouteName, const bool bInQuitOnFinish)
+{
+	RequestEnd();
+
+	mRoute = FCSDebugAutoPilotRoute();
+	FString Text;
+	if (FFileHelper::LoadFileToString(Text, *sGetRoutePath(InRouteName)))
+	{
+		mRoute.FromJson(Text);
+	}
+	else
+	{
+		MakeRouteFromSpline(InRouteName);
+	}
+	if (mRoute.mWaypointList.Num() == 0)
+	{
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot AutoPlay %s : route not found"), *InRouteName);
+		mState = EState::Idle;
+		return false;
+	}
+
+	const UWorld* World = GetPlayerController() ? GetPlayerController()->GetWorld() : nullptr;
+	mRouteName = InRouteName;
+	mResult = FCSDebugAutoPilotRouteResult();
+	mResult.mRouteName = InRouteName;
+	mResult.mMapName = World ? World->GetMapName() : FString();
+	mPathCacheMap.Reset();
+	mPath = nullptr;
+	mBeginSec = 0.0;
+	mFrameTimeList.Reset(60 * 60);
+	mbQuitOnFinish = bInQuitOnFinish;
+	mState = EState::WaitPawn;
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot AutoPlay %s : Begin (%d waypoints)"), *mRouteName, mRoute.mWaypointList.Num());
+	return true;
+}
+
+/**
+ * @brief	途中で止める(そこまでの結果は書き出す)
+ */
+void	UCSDebugAutoPilotModeAutoPlay::RequestEnd()
+{
+	if (!IsFinish())
+	{
+		Finish();
+	}
+}
+
+/**
+ * @brief	スプラインの制御点から経路を作る
+ */
+bool	UCSDebugAutoPilotModeAutoPlay::MakeRouteFromSpline(const FString& InActorName)
+{
+	UWorld* World = GetPlayerController() ? GetPlayerController()->GetWorld() : nullptr;
+	if (World == nullptr)
+	{
+		return false;
+	}
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (It->GetName() != InActorName)
+		{
+			continue;
+		}
+		const USplineComponent* Spline = It->FindComponentByClass<USplineComponent>();
+		if (Spline == nullptr)
+		{
+			return false;
+		}
+		const int32 PointNum = Spline->GetNumberOfSplinePoints();
+		for (int32 i = 0; i < PointNum; ++i)
+		{
+			const FVector Pos = Spline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
+			FCSDebugAutoPilotRouteWaypoint Waypoint;
+			Waypoint.mPosX = Pos.X;
+			Waypoint.mPosY = Pos.Y;
+			Waypoint.mPosZ = Pos.Z;
+			mRoute.mWaypointList.Add(Waypoint);
+		}
+		mRoute.mLoopNum = Spline->IsClosedLoop() ? 0 : 1;
+		return (PointNum > 0);
+	}
+	return false;
+}
+
+/**
+ * @brief	通過点の組の経路(無ければナビゲーションシステムで探してキャッシュ)
+ *			開始位置からの最初の区間はInFromIndexがINDEX_NONE
+ */
+const UCSDebugAutoPilotModeAutoPlay::FPathCache&	UCSDebugAutoPilotModeAutoPlay::FindPath(const int32 InFromIndex, const int32 InToIndex, const FVector& InStartPos)
+{
+	const uint64 Key = (static_cast<uint64>(static_cast<uint32>(InFromIndex)) << 32) | static_cast<uint32>(InToIndex);
+	if (const FPathCache* Cache = mPathCacheMap.Find(Key))
+	{
+		++mResult.mPathCacheHitNum;
+		return *Cache;
+	}
+
+	++mResult.mPathQueryNum;
+	FPathCache& Cache = mPathCacheMap.Add(Key);
+	const FVector GoalPos = mRoute.mWaypointList[InToIndex].GetPos();
+	APlayerController* PlayerControler = GetPlayerController();
+	UWorld* World = PlayerControler->GetWorld();
+	UNavigationSystemV1* NavSys = mRoute.mbNavigation ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+	if (NavSys)
+	{
+		const UNavigationPath* NavPath = NavSys->FindPathToLocationSynchronously(World, InStartPos, GoalPos, PlayerControler->GetPawn());
+		if (NavPath
+			&& NavPath->IsValid()
+			&& NavPath->PathPoints.Num() > 1)
+		{
+			//先頭は開始位置なので除く
+			Cache.mPointList.Append(NavPath->PathPoints.GetData() + 1, NavPath->PathPoints.Num() - 1);
+			Cache.mbNavigation = true;
+			return Cache;
+		}
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot AutoPlay %s : no navigation path %d -> %d (go straight)"), *mRouteName, InFromIndex, InToIndex);
+	}
+	Cache.mPointList.Add(GoalPos);
+	return Cache;
+}
+
+/**
+ * @brief	経路中の全ての通過点の組の経路を先に探してキャッシュ
+ *			(探索数には入れて、区間開始時のキャッシュヒット数には入れない)
+ */
+void	UCSDebugAutoPilotModeAutoPlay::PrepareAllPath(const FVector& InStartPos)
+{
+	const int32 WaypointNum = mRoute.mWaypointList.Num();
+	if (!mRoute.mbWarpToStart)
+	{
+		FindPath(INDEX_NONE, 0, InStartPos);
+	}
+	for (int32 i = 0; i < WaypointNum - 1; ++i)
+	{
+		FindPath(i, i + 1, mRoute.mWaypointList[i].GetPos());
+	}
+	if (mRoute.mLoopNum != 1
+		&& WaypointNum > 1)
+	{
+		FindPath(WaypointNum - 1, 0, mRoute.mWaypointList[WaypointNum - 1].GetPos());
+	}
+	mResult.mPathCacheHitNum = 0;
+}
+
+/**
+ * @brief	区間開始
+ */
+void	UCSDebugAutoPilotModeAutoPlay::BeginSegment(const int32 InToIndex, const FVector& InStartPos)
+{
+	mToIndex = InToIndex;
+	mPath = &FindPath(mFromIndex, InToIndex, InStartPos);
+	mPathPointIndex = 0;
+	mFrameTimeList.Reset();
+	mGameThreadMsSum = 0.0;
+	mRenderThreadMsSum = 0.0;
+	mSegmentBeginSec = FPlatformTime::Seconds();
+	mNearestDistance = MAX_flt;
+	mStuckSec = 0.f;
+	mbStuck = false;
+	mState = EState::Move;
+}
+
+/**
+ * @brief	区間終了(通過点で留まった時間も含めて集計)
+ */
+void	UCSDebugAutoPilotModeAutoPlay::EndSegment()
+{
+	if (mPath == nullptr)
+	{
+		return;
+	}
+
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	FCSDebugAutoPilotRouteSegmentResult& Segment = mResult.mSegmentList.AddDefaulted_GetRef();
+	Segment.mLoop = mLoop;
+	Segment.mFromIndex = mFromIndex;
+	Segment.mToIndex = mToIndex;
+	Segment.mSec = static_cast<float>(FPlatformTime::Seconds() - mSegmentBeginSec);
+	Segment.mPathPointNum = mPath->mPointList.Num();
+	Segment.mbNavigation = mPath->mbNavigation;
+	Segment.mbStuck = mbStuck;
+	Segment.mFrameNum = mFrameTimeList.Num();
+	if (mFrameTimeList.Num() > 0)
+	{
+		float TotalMs = 0.f;
+		for (const float FrameTimeMs : mFrameTimeList)
+		{
+			TotalMs += FrameTimeMs;
+			if (FrameTimeMs > CSDebugConfig->mAutoPilot_BatchHitchMilliSec)
+			{
+				++Segment.mHitchNum;
+			}
+		}
+		mFrameTimeList.Sort();
+		Segment.mFrameTimeAverageMs = TotalMs / mFrameTimeList.Num();
+		Segment.mFrameTimeP95Ms = sGetPercentile(mFrameTimeList, 0.95f);
+		Segment.mFrameTimeMaxMs = mFrameTimeList.Last();
+		Segment.mGameThreadAverageMs = static_cast<float>(mGameThreadMsSum / mFrameTimeList.Num());
+		Segment.mRenderThreadAverageMs = static_cast<float>(mRenderThreadMsSum / mFrameTimeList.Num());
+	}
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot AutoPlay %s : Segment %d -> %d Loop %d %.2fs Frame %d Avg %.2fms P95 %.2fms Max %.2fms Hitch %d%s"),
+		*mRouteName, Segment.mFromIndex, Segment.mToIndex, Segment.mLoop, Segment.mSec, Segment.mFrameNum,
+		Segment.mFrameTimeAverageMs, Segment.mFrameTimeP95Ms, Segment.mFrameTimeMaxMs, Segment.mHitchNum, Segment.mbStuck ? TEXT(" Stuck") : TEXT(""));
+	mPath = nullptr;
+}
+
+/**
+ * @brief	次の通過点へ(最後まで行ったら先頭へ戻るか終了)
+ */
+void	UCSDebugAutoPilotModeAutoPlay::NextWaypoint()
+{
+	EndSegment();
+
+	const int32 FromIndex = mToIndex;
+	int32 ToIndex = FromIndex + 1;
+	if (ToIndex >= mRoute.mWaypointList.Num())
+	{
+		++mLoop;
+		if (mRoute.mLoopNum > 0
+			&& mLoop >= mRoute.mLoopNum)
+		{
+			Finish();
+			return;
+		}
+		ToIndex = 0;
+	}
+	if (ToIndex == FromIndex)
+	{
+		Finish();
+		return;
+	}
+	mFromIndex = FromIndex;
+	BeginSegment(ToIndex, mRoute.mWaypointList[FromIndex].GetPos());
+}
+
+/**
+ * @brief	経路の次の点へ向けて左スティックを倒す
+ *			近づけない時間が続いたら点へワープして詰まりとして記録
+ */
+void	UCSDebugAutoPilotModeAutoPlay::UpdateMove(APlayerController& InPlayerController, const float InDeltaTime)
+{
+	APawn* Pawn = InPlayerController.GetPawn();
+	if (Pawn == nullptr
+		|| mPath == nullptr)
+	{
+		mMoveStick = FVector2D::ZeroVector;
+		return;
+	}
+
+	const FVector& TargetPos = mPath->mPointList[mPathPointIndex];
+	const bool bLastPoint = (mPathPointIndex == mPath->mPointList.Num() - 1);
+	const float AcceptRadius = bLastPoint ? mRoute.mWaypointList[mToIndex].mAcceptRadius : sPathPointAcceptRadius;
+	const FVector Delta = TargetPos - Pawn->GetActorLocation();
+	const float Distance = FVector2D(Delta.X, Delta.Y).Size();
+	if (Distance <= AcceptRadius)
+	{
+		mNearestDistance = MAX_flt;
+		mStuckSec = 0.f;
+		if (!bLastPoint)
+		{
+			++mPathPointIndex;
+			return;
+		}
+		mMoveStick = FVector2D::ZeroVector;
+		mStateSec = 0.f;
+		mState = EState::Wait;
+		return;
+	}
+
+	if (Distance < mNearestDistance - sStuckProgressDistance)
+	{
+		mNearestDistance = Distance;
+		mStuckSec = 0.f;
+	}
+	else
+	{
+		mStuckSec += InDeltaTime;
+		if (mRoute.mStuckSec > 0.f
+			&& mStuckSec > mRoute.mStuckSec)
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot AutoPlay %s : stuck %d -> %d at (%.0f, %.0f, %.0f)"),
+				*mRouteName, mFromIndex, mToIndex, TargetPos.X, TargetPos.Y, TargetPos.Z);
+			sWarpPawn(*Pawn, TargetPos);
+			++mResult.mStuckNum;
+			mbStuck = true;
+			mNearestDistance = MAX_flt;
+			mStuckSec = 0.f;
+			return;
+		}
+	}
+
+	mMoveStick = sCalcMoveStick(InPlayerController, Delta);
+	if (mRoute.mCameraTurnSpeed > 0.f)
+	{
+		const FRotator NowRot = InPlayerController.GetControlRotation();
+		UpdateCamera(InPlayerController, FRotator(NowRot.Pitch, Delta.Rotation().Yaw, 0.f), InDeltaTime);
+	}
+}
+
+/**
+ * @brief	カメラ(ControlRotation)を一定速度で目標へ向ける(速度0なら即座に)
+ */
+void	UCSDebugAutoPilotModeAutoPlay::UpdateCamera(APlayerController& InPlayerController, const FRotator& InTargetRot, const float InDeltaTime)
+{
+	const FRotator NowRot = InPlayerController.GetControlRotation();
+	const FRotator NewRot = (mRoute.mCameraTurnSpeed > 0.f) ? FMath::RInterpConstantTo(NowRot, InTargetRot, InDeltaTime, mRoute.mCameraTurnSpeed) : InTargetRot;
+	InPlayerController.SetControlRotation(NewRot);
+}
+
+/**
+ * @brief	1フレーム分の負荷を今の区間へ
+ */
+void	UCSDebugAutoPilotModeAutoPlay::CaptureFrame()
+{
+	const double NowSec = FPlatformTime::Seconds();
+	if (mLastFrameSec > 0.0)
+	{
+		mFrameTimeList.Add(static_cast<float>((NowSec - mLastFrameSec) * 1000.0));
+		mGameThreadMsSum += FPlatformTime::ToMilliseconds(GGameThreadTime);
+		mRenderThreadMsSum += FPlatformTime::ToMilliseconds(GRenderThreadTime);
+		++mResult.mFrameNum;
+	}
+	mLastFrameSec = NowSec;
+}
+
+/**
+ * @brief	終了して結果をRoute/Result/へ
+ */
+void	UCSDebugAutoPilotModeAutoPlay::Finish()
+{
+	EndSegment();
+	mState = EState::Finish;
+	mResult.mSec = (mBeginSec > 0.0) ? static_cast<float>(FPlatformTime::Seconds() - mBeginSec) : 0.f;
+
+	const FString ResultPath = sGetRouteDir() + TEXT("Result/") + FPaths::GetBaseFilename(mRouteName) + TEXT(".json");
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(ResultPath), true);
+	FFileHelper::SaveStringToFile(mResult.ToJson(), *ResultPath);
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot AutoPlay %s : End %.2fs Frame %d Segment %d PathQuery %d (Cache %d) Stuck %d -> %s"),
+		*mRouteName, mResult.mSec, mResult.mFrameNum, mResult.mSegmentList.Num(), mResult.mPathQueryNum, mResult.mPathCacheHitNum, mResult.mStuckNum, *ResultPath);
+
+	if (mbQuitOnFinish)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, (mResult.mStuckNum > 0) ? 1 : 0);
+	}
+}
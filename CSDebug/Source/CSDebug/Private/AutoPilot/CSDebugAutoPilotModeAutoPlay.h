@@ -0,0 +1,212 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotModeAutoPlay.h
+ * @brief 自動入力 経路(ウェイポイント列)をナビメッシュに沿って歩かせるモード
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AutoPilot/CSDebugAutoPilotModeBase.h"
+#include "ScreenWindow/CSDebug_ScreenWindowText.h"
+#include "Serialization/JsonSerializerMacros.h"
+#include "CSDebugAutoPilotModeAutoPlay.generated.h"
+
+class UCanvas;
+
+/* ------------------------------------------------------------
+   !経路の通過点
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotRouteWaypoint : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE("mPosX", mPosX);
+	JSON_SERIALIZE("mPosY", mPosY);
+	JSON_SERIALIZE("mPosZ", mPosZ);
+	JSON_SERIALIZE("mAcceptRadius", mAcceptRadius);
+	JSON_SERIALIZE("mWaitSec", mWaitSec);
+	JSON_SERIALIZE("mbCamera", mbCamera);
+	JSON_SERIALIZE("mCameraPitch", mCameraPitch);
+	JSON_SERIALIZE("mCameraYaw", mCameraYaw);
+	END_JSON_SERIALIZER
+
+		float	mPosX = 0.f;
+	float	mPosY = 0.f;
+	float	mPosZ = 0.f;
+	float	mAcceptRadius = 100.f;//到着とみなす距離
+	float	mWaitSec = 0.f;//到着後に留まる時間
+	bool	mbCamera = false;//到着後にカメラをmCameraPitch,mCameraYawへ向ける
+	float	mCameraPitch = 0.f;
+	float	mCameraYaw = 0.f;
+
+	FVector	GetPos() const { return FVector(mPosX, mPosY, mPosZ); }
+};
+
+/* ------------------------------------------------------------
+   !経路(Saved/CSDebug/AutoPilot/Route/<Name>.json)
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotRoute : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE_ARRAY_SERIALIZABLE("mWaypointList", mWaypointList, FCSDebugAutoPilotRouteWaypoint);
+	JSON_SERIALIZE("mLoopNum", mLoopNum);
+	JSON_SERIALIZE("mbNavigation", mbNavigation);
+	JSON_SERIALIZE("mbWarpToStart", mbWarpToStart);
+	JSON_SERIALIZE("mCameraTurnSpeed", mCameraTurnSpeed);
+	JSON_SERIALIZE("mStuckSec", mStuckSec);
+	END_JSON_SERIALIZER
+
+		TArray<FCSDebugAutoPilotRouteWaypoint>	mWaypointList;
+	int32	mLoopNum = 1;//最後まで行ったら先頭へ戻る回数(0なら無限)
+	bool	mbNavigation = true;//ナビメッシュで経路探索(falseなら直線)
+	bool	mbWarpToStart = true;//開始時に最初の通過点へワープ(毎回同じ所から始める)
+	float	mCameraTurnSpeed = 180.f;//移動中にカメラを進行方向へ回す速さ(度/秒 0なら回さない)
+	float	mStuckSec = 5.f;//近づけない時間がこれを超えたら次の点へワープ
+};
+
+/* ------------------------------------------------------------
+   !区間(通過点の間)1つ分の負荷計測結果
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotRouteSegmentResult : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE("mLoop", mLoop);
+	JSON_SERIALIZE("mFromIndex", mFromIndex);
+	JSON_SERIALIZE("mToIndex", mToIndex);
+	JSON_SERIALIZE("mFrameNum", mFrameNum);
+	JSON_SERIALIZE("mSec", mSec);
+	JSON_SERIALIZE("mFrameTimeAverageMs", mFrameTimeAverageMs);
+	JSON_SERIALIZE("mFrameTimeP95Ms", mFrameTimeP95Ms);
+	JSON_SERIALIZE("mFrameTimeMaxMs", mFrameTimeMaxMs);
+	JSON_SERIALIZE("mGameThreadAverageMs", mGameThreadAverageMs);
+	JSON_SERIALIZE("mRenderThreadAverageMs", mRenderThreadAverageMs);
+	JSON_SERIALIZE("mHitchNum", mHitchNum);
+	JSON_SERIALIZE("mPathPointNum", mPathPointNum);
+	JSON_SERIALIZE("mbNavigation", mbNavigation);
+	JSON_SERIALIZE("mbStuck", mbStuck);
+	END_JSON_SERIALIZER
+
+		int32	mLoop = 0;
+	int32	mFromIndex = INDEX_NONE;//INDEX_NONEなら開始位置から
+	int32	mToIndex = 0;
+	int32	mFrameNum = 0;
+	float	mSec = 0.f;
+	float	mFrameTimeAverageMs = 0.f;
+	float	mFrameTimeP95Ms = 0.f;
+	float	mFrameTimeMaxMs = 0.f;
+	float	mGameThreadAverageMs = 0.f;
+	float	mRenderThreadAverageMs = 0.f;
+	int32	mHitchNum = 0;
+	int32	mPathPointNum = 0;
+	bool	mbNavigation = false;//ナビメッシュの経路が取れたか
+	bool	mbStuck = false;//途中でワープしたか
+};
+
+/* ------------------------------------------------------------
+   !経路1回分の結果(Route/Result/<Name>.json)
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotRouteResult : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE("mRouteName", mRouteName);
+	JSON_SERIALIZE("mMapName", mMapName);
+	JSON_SERIALIZE("mSec", mSec);
+	JSON_SERIALIZE("mFrameNum", mFrameNum);
+	JSON_SERIALIZE("mPathQueryNum", mPathQueryNum);
+	JSON_SERIALIZE("mPathCacheHitNum", mPathCacheHitNum);
+	JSON_SERIALIZE("mStuckNum", mStuckNum);
+	JSON_SERIALIZE_ARRAY_SERIALIZABLE("mSegmentList", mSegmentList, FCSDebugAutoPilotRouteSegmentResult);
+	END_JSON_SERIALIZER
+
+		FString	mRouteName;
+	FString	mMapName;
+	float	mSec = 0.f;
+	int32	mFrameNum = 0;
+	int32	mPathQueryNum = 0;
+	int32	mPathCacheHitNum = 0;
+	int32	mStuckNum = 0;
+	TArray<FCSDebugAutoPilotRouteSegmentResult>	mSegmentList;
+};
+
+/**
+ * 経路の通過点へ順に 合成した左スティック入力で向かわせる
+ * 通過点間の経路はナビゲーションシステムで探して通過点の組毎にキャッシュ(2周目以降は探索無し)
+ * 区間毎のフレーム時間を計測して 終わったらRoute/Result/<Name>.jsonへ
+ * 通過点はjsonの他 スプラインを持つアクター名を指定すればその制御点から作る
+ * 起動引数 -CSDebugAutoPilotRoute=Name で開始時に実行 -CSDebugAutoPilotRouteQuit で終わったら終了(詰まりがあれば終了コード1)
+ */
+UCLASS()
+class CSDEBUG_API UCSDebugAutoPilotModeAutoPlay : public UCSDebugAutoPilotModeBase
+{
+	GENERATED_BODY()
+
+	/* ------------------------------------------------------------
+	   !状態
+	------------------------------------------------------------ */
+	enum class EState : uint8
+	{
+		Idle,
+		WaitPawn,
+		Move,
+		Wait,//通過点で留まる
+		Finish,
+	};
+	/* ------------------------------------------------------------
+	   !通過点の組毎の経路
+	------------------------------------------------------------ */
+	struct FPathCache
+	{
+		TArray<FVector>	mPointList;
+		bool	mbNavigation = false;
+	};
+
+public:
+	virtual void	PreProcessInput(float DeltaTime) override;
+	virtual void	DebugDraw(class UCanvas* InCanvas) override;
+
+	bool	RequestRoute(const FString& InRouteName, const bool bInQuitOnFinish);
+	void	RequestEnd();
+	bool	IsFinish() const { return mState == EState::Idle || mState == EState::Finish; }
+	const FCSDebugAutoPilotRouteResult&	GetResult() const { return mResult; }
+
+	static FString	sGetRouteDir();
+	static bool	sAddWaypoint(const FString& InRouteName, const APlayerController& InPlayerController);
+
+private:
+	bool	MakeRouteFromSpline(const FString& InActorName);
+	const FPathCache&	FindPath(const int32 InFromIndex, const int32 InToIndex, const FVector& InStartPos);
+	void	PrepareAllPath(const FVector& InStartPos);
+	void	BeginSegment(const int32 InToIndex, const FVector& InStartPos);
+	void	EndSegment();
+	void	NextWaypoint();
+	void	UpdateMove(APlayerController& InPlayerController, const float InDeltaTime);
+	void	UpdateCamera(APlayerController& InPlayerController, const FRotator& InTargetRot, const float InDeltaTime);
+	void	CaptureFrame();
+	void	Finish();
+
+private:
+	FCSDebugAutoPilotRoute	mRoute;
+	FCSDebugAutoPilotRouteResult	mResult;
+	TMap<uint64, FPathCache>	mPathCacheMap;//(From,To)で引く
+	const FPathCache*	mPath = nullptr;//今の区間(mPathCacheMapへの追加は区間開始時だけ)
+	TArray<float>	mFrameTimeList;//今の区間のフレーム時間(区間毎にResetで使い回し)
+	FCSDebug_ScreenWindowText	mInfoWindow;
+	FString	mRouteName;
+	FVector2D	mMoveStick = FVector2D::ZeroVector;
+	double	mBeginSec = 0.0;
+	double	mSegmentBeginSec = 0.0;
+	double	mLastFrameSec = 0.0;
+	double	mGameThreadMsSum = 0.0;
+	double	mRenderThreadMsSum = 0.0;
+	float	mStateSec = 0.f;
+	float	mStuckSec = 0.f;
+	float	mNearestDistance = 0.f;//今向かってる点に一番近づいた距離(詰まり判定用)
+	int32	mFromIndex = INDEX_NONE;
+	int32	mToIndex = 0;
+	int32	mPathPointIndex = 0;
+	int32	mLoop = 0;
+	bool	mbStuck = false;
+	bool	mbQuitOnFinish = false;
+	EState	mState = EState::Idle;
+};
@@ -15,6 +15,7 @@
 #include "Engine/Canvas.h"
 #include "Engine/Engine.h"
 #include "GameFramework/PlayerInput.h"
+#include "GameFramework/PlayerController.h"
 
 /**
  * @brief	親としてComponentをセット
@@ -30,41 +31,104 @@ void	UCSDebugAutoPilotModeBase::SetParent(UCSDebugAutoPilotComponent* InParentCo
 }
 
 /**
- * @brief	パッド入力値取得
+ * @brief	Key
  */
-float	UCSDebugAutoPilotModeBase::GetDebugDrawPadInfoAxisValue(ECSDebugAutoPilotKey InKey) const
+const FKey&	UCSDebugAutoPilotModeBase::GetKey(ECSDebugAutoPilotKey InKey) const
 {
-	for (const FCSDebugAutoPilotDebugDrawPadInfo& Info : mDebugDrawPadInfoList)
+	check(InKey < ECSDebugAutoPilotKey::Num);
+	return mKeyList[static_cast<int32>(InKey)];
+}
+
+/**
+ * @brief	パッド入力取得(スティックはデッドゾーン考慮 ボタンは押してたら1)
+ */
+bool	UCSDebugAutoPilotModeBase::GetPadInputValue(ECSDebugAutoPilotKey InKey, float& OutAxisValue) const
+{
+	return GetPadInputValue(*GetPlayerController(), InKey, OutAxisValue);
+}
+/**
+ * @brief	指定PlayerControllerのパッド入力値取得(画面分割等で自分以外も見る時用)
+ */
+bool	UCSDebugAutoPilotModeBase::GetPadInputValue(const APlayerController& InPlayerController, ECSDebugAutoPilotKey InKey, float& OutAxisValue) const
+{
+	OutAxisValue = 0.f;
+	const APlayerController* PlayerControler = &InPlayerController;
+	const FKey& Key = GetKey(InKey);
+	if (FCSDebugAutoPilotPadSnapshot::sGetAxisIndex(InKey) != INDEX_NONE)
 	{
-		if (Info.mKey == InKey)
+		const float PadDeadZone = GetPadDeadZone(InKey);
+		if (PadDeadZone < 0.f)
+		{
+			return false;
+		}
+		float AxisValue = PlayerControler->GetInputAnalogKeyState(Key);
+		if (AxisValue > 0.f)
+		{
+			AxisValue = AxisValue * (1.0f - PadDeadZone) + PadDeadZone;
+		}
+		else if (AxisValue < 0.f)
+		{
+			AxisValue = AxisValue * (1.0f - PadDeadZone) - PadDeadZone;
+		}
+		if (FMath::Abs(AxisValue) > PadDeadZone)
 		{
-			return Info.mAxisValue;
+			OutAxisValue = AxisValue;
+			return true;
 		}
+		return false;
 	}
-	return 0.f;
+
+	if (PlayerControler->IsInputKeyDown(Key))
+	{
+		OutAxisValue = 1.f;
+		return true;
+	}
+	return false;
 }
 
 /**
- * @brief	Key
+ * @brief	全キーの入力状態をまとめて取得
  */
-FKey	UCSDebugAutoPilotModeBase::GetKey(ECSDebugAutoPilotKey InKey) const
+void	UCSDebugAutoPilotModeBase::CapturePadSnapshot(FCSDebugAutoPilotPadSnapshot& OutSnapshot) const
 {
-	if (InKey == ECSDebugAutoPilotKey::Invalid
-		|| InKey == ECSDebugAutoPilotKey::Num)
-	{
-		return FKey();
-	}
-	const FKey* Key = mKeyMap.Find(InKey);
-	if (Key == nullptr)
+	CapturePadSnapshot(*GetPlayerController(), OutSnapshot);
+}
+/**
+ * @brief	指定PlayerControllerの全キーの入力状態をまとめて取得
+ */
+void	UCSDebugAutoPilotModeBase::CapturePadSnapshot(const APlayerController& InPlayerController, FCSDebugAutoPilotPadSnapshot& OutSnapshot) const
+{
+	OutSnapshot = FCSDebugAutoPilotPadSnapshot();
+	for (uint32 i = 1; i < static_cast<uint32>(ECSDebugAutoPilotKey::Num); ++i)
 	{
-		return FKey();
+		const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(i);
+		float AxisValue = 0.f;
+		if (!GetPadInputValue(InPlayerController, KeyId, AxisValue))
+		{
+			continue;
+		}
+		OutSnapshot.mInputBits |= (1u << i);
+		const int32 AxisIndex = FCSDebugAutoPilotPadSnapshot::sGetAxisIndex(KeyId);
+		if (AxisIndex != INDEX_NONE)
+		{
+			OutSnapshot.mAxisList[AxisIndex] = AxisValue;
+		}
 	}
+}
 
-	return *Key;
+/**
+ * @brief	ワールドの向きへ進む左スティックの値(カメラの向き基準 X:右 Y:前)
+ */
+FVector2D	UCSDebugAutoPilotModeBase::sCalcMoveStick(const APlayerController& InPlayerController, const FVector& InDir)
+{
+	const FRotator YawRot(0.f, InPlayerController.GetControlRotation().Yaw, 0.f);
+	const FVector LocalDir = YawRot.UnrotateVector(FVector(InDir.X, InDir.Y, 0.f).GetSafeNormal());
+	return FVector2D(LocalDir.Y, LocalDir.X);
 }
 
 /**
  * @brief	パッド入力状態デバッグ表示
+ *			表示状態は固定長配列を上書きするだけで 表示の度に履歴へ積んで0に戻す(メモリ確保無し)
  */
 void	UCSDebugAutoPilotModeBase::DebugDrawPad(UCanvas* InCanvas)
 {
@@ -171,7 +235,12 @@ void	UCSDebugAutoPilotModeBase::DebugDrawPad(UCanvas* InCanvas)
 		}
 	}
 
-	mDebugDrawPadInfoList.Reset();
+	mDebugDrawPadHistoryList[mDebugDrawPadHistoryIndex] = mDebugDrawPadBits;
+	mDebugDrawPadHistoryIndex = (mDebugDrawPadHistoryIndex + 1) % sDebugDrawPadHistoryNum;
+	DebugDrawPadHistory(InCanvas, ScreenPos + FVector2D(0.f, Extent.Y + VirtualGridLen * 0.5f), FVector2D(Extent.X, VirtualGridLen * 4.f));
+
+	FMemory::Memzero(mDebugDrawPadValueList);
+	mDebugDrawPadBits = 0;
 }
 
 /**
@@ -179,32 +248,31 @@ void	UCSDebugAutoPilotModeBase::DebugDrawPad(UCanvas* InCanvas)
  */
 void UCSDebugAutoPilotModeBase::InitializeKeyMap()
 {
-	if (mKeyMap.Num() != 0)
+	if (mbInitializedKeyList)
 	{
 		return;
 	}
+	mbInitializedKeyList = true;
 
-	mKeyMap.Reserve((int32)ECSDebugAutoPilotKey::Num);
-
-	mKeyMap.Add(ECSDebugAutoPilotKey::LeftStickX, EKeys::Gamepad_LeftX);
-	mKeyMap.Add(ECSDebugAutoPilotKey::LeftStickY, EKeys::Gamepad_LeftY);
-	mKeyMap.Add(ECSDebugAutoPilotKey::RightStickX, EKeys::Gamepad_RightX);
-	mKeyMap.Add(ECSDebugAutoPilotKey::RightStickY, EKeys::Gamepad_RightY);
-	mKeyMap.Add(ECSDebugAutoPilotKey::Up, EKeys::Gamepad_DPad_Up);
-	mKeyMap.Add(ECSDebugAutoPilotKey::Down, EKeys::Gamepad_DPad_Down);
-	mKeyMap.Add(ECSDebugAutoPilotKey::Left, EKeys::Gamepad_DPad_Left);
-	mKeyMap.Add(ECSDebugAutoPilotKey::Right, EKeys::Gamepad_DPad_Right);
-	mKeyMap.Add(ECSDebugAutoPilotKey::L1, EKeys::Gamepad_LeftShoulder);
-	mKeyMap.Add(ECSDebugAutoPilotKey::L2, EKeys::Gamepad_LeftTrigger);
-	mKeyMap.Add(ECSDebugAutoPilotKey::L3, EKeys::Gamepad_LeftThumbstick);
-	mKeyMap.Add(ECSDebugAutoPilotKey::R1, EKeys::Gamepad_RightShoulder);
-	mKeyMap.Add(ECSDebugAutoPilotKey::R2, EKeys::Gamepad_RightTrigger);
-	mKeyMap.Add(ECSDebugAutoPilotKey::R3, EKeys::Gamepad_RightThumbstick);
-	mKeyMap.Add(ECSDebugAutoPilotKey::Sankaku, EKeys::Gamepad_FaceButton_Top);
-	mKeyMap.Add(ECSDebugAutoPilotKey::Shikaku, EKeys::Gamepad_FaceButton_Left);
-	mKeyMap.Add(ECSDebugAutoPilotKey::Batsu, EKeys::Gamepad_FaceButton_Bottom);
-	mKeyMap.Add(ECSDebugAutoPilotKey::Maru, EKeys::Gamepad_FaceButton_Right);
-	//mKeyMap.Add(&EKeys::Gamepad_Special_Right, ECSDebugAutoPilotKey::Option, );
+	mKeyList[(int32)ECSDebugAutoPilotKey::LeftStickX] = EKeys::Gamepad_LeftX;
+	mKeyList[(int32)ECSDebugAutoPilotKey::LeftStickY] = EKeys::Gamepad_LeftY;
+	mKeyList[(int32)ECSDebugAutoPilotKey::RightStickX] = EKeys::Gamepad_RightX;
+	mKeyList[(int32)ECSDebugAutoPilotKey::RightStickY] = EKeys::Gamepad_RightY;
+	mKeyList[(int32)ECSDebugAutoPilotKey::Up] = EKeys::Gamepad_DPad_Up;
+	mKeyList[(int32)ECSDebugAutoPilotKey::Down] = EKeys::Gamepad_DPad_Down;
+	mKeyList[(int32)ECSDebugAutoPilotKey::Left] = EKeys::Gamepad_DPad_Left;
+	mKeyList[(int32)ECSDebugAutoPilotKey::Right] = EKeys::Gamepad_DPad_Right;
+	mKeyList[(int32)ECSDebugAutoPilotKey::L1] = EKeys::Gamepad_LeftShoulder;
+	mKeyList[(int32)ECSDebugAutoPilotKey::L2] = EKeys::Gamepad_LeftTrigger;
+	mKeyList[(int32)ECSDebugAutoPilotKey::L3] = EKeys::Gamepad_LeftThumbstick;
+	mKeyList[(int32)ECSDebugAutoPilotKey::R1] = EKeys::Gamepad_RightShoulder;
+	mKeyList[(int32)ECSDebugAutoPilotKey::R2] = EKeys::Gamepad_RightTrigger;
+	mKeyList[(int32)ECSDebugAutoPilotKey::R3] = EKeys::Gamepad_RightThumbstick;
+	mKeyList[(int32)ECSDebugAutoPilotKey::Sankaku] = EKeys::Gamepad_FaceButton_Top;
+	mKeyList[(int32)ECSDebugAutoPilotKey::Shikaku] = EKeys::Gamepad_FaceButton_Left;
+	mKeyList[(int32)ECSDebugAutoPilotKey::Batsu] = EKeys::Gamepad_FaceButton_Bottom;
+	mKeyList[(int32)ECSDebugAutoPilotKey::Maru] = EKeys::Gamepad_FaceButton_Right;
+	//mKeyList[(int32)ECSDebugAutoPilotKey::Option] = EKeys::Gamepad_Special_Right;
 }
 
 /**
@@ -212,21 +280,31 @@ void UCSDebugAutoPilotModeBase::InitializeKeyMap()
  */
 void UCSDebugAutoPilotModeBase::InitializePadDeadZoneMap()
 {
-	if (mPadDeadZoneMap.Num() > 0)
+	for (float& PadDeadZone : mPadDeadZoneList)
 	{
-		return;
+		PadDeadZone = -1.f;
 	}
 
 	const APlayerController* PlayerControler = GetPlayerController();
-	if (const UPlayerInput* PlayerInput = PlayerControler->PlayerInput)
+	const UPlayerInput* PlayerInput = PlayerControler->PlayerInput;
+	if (PlayerInput == nullptr)
+	{
+		return;
+	}
+	for (uint32 i = 1; i < static_cast<uint32>(ECSDebugAutoPilotKey::Num); ++i)
 	{
+		const FKey& Key = mKeyList[i];
+		if (!Key.IsAxis1D())
+		//if (!Key.IsFloatAxis())
+		{
+			continue;
+		}
 		for (const FInputAxisConfigEntry& AxisConfigEntry : PlayerInput->AxisConfig)
 		{
-			const FKey AxisKey = AxisConfigEntry.AxisKeyName;
-			if (AxisKey.IsAxis1D())
-			//if (AxisKey.IsFloatAxis())
+			if (Key == FKey(AxisConfigEntry.AxisKeyName))
 			{
-				mPadDeadZoneMap.Add(AxisKey, AxisConfigEntry.AxisProperties.DeadZone);
+				mPadDeadZoneList[i] = AxisConfigEntry.AxisProperties.DeadZone;
+				break;
 			}
 		}
 	}
@@ -257,6 +335,76 @@ void	UCSDebugAutoPilotModeBase::DebugDrawPadSheet(UCanvas* InCanvas, const FVect
 		InCanvas->DrawItem(TileItem);
 	}
 }
+namespace
+{
+	constexpr uint32	sGetPadBit(const ECSDebugAutoPilotKey InKey)
+	{
+		return 1u << static_cast<uint32>(InKey);
+	}
+}
+
+/**
+ * @brief	入力履歴の帯(左が古い キー毎の行で入力中の区間をまとめて塗る)
+ */
+void	UCSDebugAutoPilotModeBase::DebugDrawPadHistory(UCanvas* InCanvas, const FVector2D& InBasePos, const FVector2D& InExtent)
+{
+	static const uint32 sRowMaskList[] =
+	{
+		sGetPadBit(ECSDebugAutoPilotKey::LeftStickX) | sGetPadBit(ECSDebugAutoPilotKey::LeftStickY),
+		sGetPadBit(ECSDebugAutoPilotKey::RightStickX) | sGetPadBit(ECSDebugAutoPilotKey::RightStickY),
+		sGetPadBit(ECSDebugAutoPilotKey::Up),
+		sGetPadBit(ECSDebugAutoPilotKey::Down),
+		sGetPadBit(ECSDebugAutoPilotKey::Left),
+		sGetPadBit(ECSDebugAutoPilotKey::Right),
+		sGetPadBit(ECSDebugAutoPilotKey::L1),
+		sGetPadBit(ECSDebugAutoPilotKey::L2),
+		sGetPadBit(ECSDebugAutoPilotKey::L3),
+		sGetPadBit(ECSDebugAutoPilotKey::R1),
+		sGetPadBit(ECSDebugAutoPilotKey::R2),
+		sGetPadBit(ECSDebugAutoPilotKey::R3),
+		sGetPadBit(ECSDebugAutoPilotKey::Sankaku),
+		sGetPadBit(ECSDebugAutoPilotKey::Shikaku),
+		sGetPadBit(ECSDebugAutoPilotKey::Batsu),
+		sGetPadBit(ECSDebugAutoPilotKey::Maru),
+		sGetPadBit(ECSDebugAutoPilotKey::Option),
+	};
+	const int32 RowNum = UE_ARRAY_COUNT(sRowMaskList);
+
+	DebugDrawPadSheet(InCanvas, InBasePos, InExtent);
+
+	const FLinearColor InputColor(1.f, 0.5f, 0.f);
+	const float RowHeight = InExtent.Y / static_cast<float>(RowNum);
+	const float FrameWidth = InExtent.X / static_cast<float>(sDebugDrawPadHistoryNum);
+	for (int32 Row = 0; Row < RowNum; ++Row)
+	{
+		const uint32 RowMask = sRowMaskList[Row];
+		const float PosY = InBasePos.Y + RowHeight * Row;
+		int32 BeginOrder = INDEX_NONE;
+		for (int32 Order = 0; Order <= sDebugDrawPadHistoryNum; ++Order)
+		{
+			const bool bInput = (Order < sDebugDrawPadHistoryNum)
+				&& (mDebugDrawPadHistoryList[(mDebugDrawPadHistoryIndex + Order) % sDebugDrawPadHistoryNum] & RowMask) != 0;
+			if (bInput)
+			{
+				if (BeginOrder == INDEX_NONE)
+				{
+					BeginOrder = Order;
+				}
+				continue;
+			}
+			if (BeginOrder != INDEX_NONE)
+			{
+				const FVector2D Pos(InBasePos.X + FrameWidth * BeginOrder, PosY + 0.5f);
+				const FVector2D Size(FrameWidth * (Order - BeginOrder), FMath::Max(RowHeight - 1.f, 1.f));
+				FCanvasTileItem TileItem(Pos, GWhiteTexture, Size, InputColor);
+				TileItem.BlendMode = SE_BLEND_Translucent;
+				InCanvas->DrawItem(TileItem);
+				BeginOrder = INDEX_NONE;
+			}
+		}
+	}
+}
+
 /**
  * @brief	2D矢印表示
  */
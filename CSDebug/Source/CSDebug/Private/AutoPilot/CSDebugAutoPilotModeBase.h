@@ -1,7 +1,7 @@
 // Copyright 2021 SensyuGames.
 /**
  * @file CSDebugAutoPilotModeBase.h
- * @brief ͓⏕e[h̃x[X
+ * @brief 自動入力等を補助する各モード処理のベース
  * @author SensyuGames
  * @date 2021/12/28
  */
@@ -16,6 +16,7 @@
 
 class UCanvas;
 class UCSDebugAutoPilotComponent;
+class APlayerController;
 
 enum class ECSDebugAutoPilotKey : uint8 {
 	Invalid,
@@ -51,11 +52,63 @@ struct FCSDebugAutoPilotDebugDrawPadInfo
 	{}
 };
 
+/* ------------------------------------------------------------
+   !1フレーム分のパッド入力
+   入力中のキーはビット スティックは値も持つ
+   前フレームとの差分で変化したキーだけ処理できるように
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotPadSnapshot
+{
+	static const int32	sAxisKeyNum = 4;//LeftStickX～RightStickY
+
+	float	mAxisList[sAxisKeyNum] = {};
+	uint32	mInputBits = 0;
+
+	static int32	sGetAxisIndex(const ECSDebugAutoPilotKey InKey)
+	{
+		const int32 AxisIndex = static_cast<int32>(InKey) - static_cast<int32>(ECSDebugAutoPilotKey::LeftStickX);
+		return (AxisIndex >= 0 && AxisIndex < sAxisKeyNum) ? AxisIndex : INDEX_NONE;
+	}
+	bool	IsInput(const ECSDebugAutoPilotKey InKey) const
+	{
+		return (mInputBits & (1u << static_cast<uint32>(InKey))) != 0;
+	}
+	//入力値(ボタンは押してたら1)
+	float	GetValue(const ECSDebugAutoPilotKey InKey) const
+	{
+		if (!IsInput(InKey))
+		{
+			return 0.f;
+		}
+		const int32 AxisIndex = sGetAxisIndex(InKey);
+		return (AxisIndex != INDEX_NONE) ? mAxisList[AxisIndex] : 1.f;
+	}
+	//入力の有無か値が変わったキーのビット
+	uint32	GetChangedBits(const FCSDebugAutoPilotPadSnapshot& InBefore) const
+	{
+		uint32 ChangedBits = mInputBits ^ InBefore.mInputBits;
+		const uint32 BothInputBits = mInputBits & InBefore.mInputBits;
+		for (int32 i = 0; i < sAxisKeyNum; ++i)
+		{
+			const uint32 KeyBit = 1u << (static_cast<uint32>(ECSDebugAutoPilotKey::LeftStickX) + i);
+			if ((BothInputBits & KeyBit)
+				&& mAxisList[i] != InBefore.mAxisList[i])
+			{
+				ChangedBits |= KeyBit;
+			}
+		}
+		return ChangedBits;
+	}
+};
+static_assert(static_cast<int32>(ECSDebugAutoPilotKey::Num) <= 32, "FCSDebugAutoPilotPadSnapshot::mInputBits");
+
 UCLASS()
 class CSDEBUG_API UCSDebugAutoPilotModeBase : public UObject
 {
 	GENERATED_BODY()
 
+	static const int32	sDebugDrawPadHistoryNum = 90;//入力履歴の帯に出す表示フレーム数
+
 public:
 	void	SetParent(UCSDebugAutoPilotComponent* InParentComponent);
 
@@ -68,13 +121,24 @@ protected:
 	virtual void	OnSetParent() {}
 	UCSDebugAutoPilotComponent* GetParent() { return mAutoPilotComponent; }
 	class APlayerController* GetPlayerController() const { return mPlayerController; }
-	float	GetDebugDrawPadInfoAxisValue(ECSDebugAutoPilotKey InKey) const;
-	const TMap<FKey, float>& GetPadDeadZoneMap() const { return mPadDeadZoneMap; }
-	FKey GetKey(ECSDebugAutoPilotKey InKey) const;
-
+	float	GetDebugDrawPadInfoAxisValue(ECSDebugAutoPilotKey InKey) const { return mDebugDrawPadValueList[static_cast<int32>(InKey)]; }
+	const FKey&	GetKey(ECSDebugAutoPilotKey InKey) const;
+	float	GetPadDeadZone(ECSDebugAutoPilotKey InKey) const { return mPadDeadZoneList[static_cast<int32>(InKey)]; }
+	bool	GetPadInputValue(ECSDebugAutoPilotKey InKey, float& OutAxisValue) const;
+	bool	GetPadInputValue(const APlayerController& InPlayerController, ECSDebugAutoPilotKey InKey, float& OutAxisValue) const;
+	void	CapturePadSnapshot(FCSDebugAutoPilotPadSnapshot& OutSnapshot) const;
+	void	CapturePadSnapshot(const APlayerController& InPlayerController, FCSDebugAutoPilotPadSnapshot& OutSnapshot) const;
+	static FVector2D	sCalcMoveStick(const APlayerController& InPlayerController, const FVector& InDir);
+
+	//同じキーを何度入れても上書きなので 表示しない間も溜まらない
 	void	AddDebugDrawPadInfo(const FCSDebugAutoPilotDebugDrawPadInfo& InInfo)
 	{
-		mDebugDrawPadInfoList.Add(InInfo);
+		const int32 KeyIndex = static_cast<int32>(InInfo.mKey);
+		mDebugDrawPadValueList[KeyIndex] = InInfo.mAxisValue;
+		if (InInfo.mAxisValue != 0.f)
+		{
+			mDebugDrawPadBits |= (1u << KeyIndex);
+		}
 	}
 
 	void	DebugDrawPad(UCanvas* InCanvas);
@@ -84,15 +148,20 @@ private:
 	void	InitializePadDeadZoneMap();
 
 	void	DebugDrawPadSheet(UCanvas* InCanvas, const FVector2D& InBasePos, const FVector2D& InExtent);
+	void	DebugDrawPadHistory(UCanvas* InCanvas, const FVector2D& InBasePos, const FVector2D& InExtent);
 	void	DebugDrawArrow2D(UCanvas* InCanvas, const FVector2D& InStartPos, const FVector2D& InGoalPos, const FLinearColor& InColor, float InArrowLen);
 	void	DebugDrawButton(UCanvas* InCanvas, ECSDebugAutoPilotKey InKey, const FVector2D& InPos, const FVector2D& InExtent);
 	void	DebugDrawStick(UCanvas* InCanvas, const FVector2D& InAxisV, const FVector2D& InPos, const float InRadius);
 
 
 private:
-	TMap<ECSDebugAutoPilotKey, FKey>	mKeyMap;
-	TMap<FKey, float>	mPadDeadZoneMap;
-	TArray<FCSDebugAutoPilotDebugDrawPadInfo>	mDebugDrawPadInfoList;//pbh͂̃fobO\p
+	FKey	mKeyList[static_cast<int32>(ECSDebugAutoPilotKey::Num)];//ECSDebugAutoPilotKeyで引く
+	float	mPadDeadZoneList[static_cast<int32>(ECSDebugAutoPilotKey::Num)];//AxisConfigに無いスティックは負
+	bool	mbInitializedKeyList = false;
+	float	mDebugDrawPadValueList[static_cast<int32>(ECSDebugAutoPilotKey::Num)] = {};//パッド入力のデバッグ表示用に(ECSDebugAutoPilotKeyで引く 表示毎に0へ)
+	uint32	mDebugDrawPadBits = 0;//mDebugDrawPadValueListが0以外のキー
+	uint32	mDebugDrawPadHistoryList[sDebugDrawPadHistoryNum] = {};//表示毎のmDebugDrawPadBits(循環)
+	int32	mDebugDrawPadHistoryIndex = 0;//次に書く所(=一番古い所)
 	UCSDebugAutoPilotComponent* mAutoPilotComponent = nullptr;
 	APlayerController*	mPlayerController = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,430 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotModeCommand.cpp
+ * @brief 自動入力 コマンドスクリプトを実行するモード
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotModeCommand.h"
+#include "AutoPilot/CSDebugAutoPilotComponent.h"
+#include "CSDebug_Subsystem.h"
+
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotRunScriptCommand(
+	TEXT("CSDebug.AutoPilot.RunScript"),
+	TEXT("CSDebug.AutoPilot.RunScript FileName : Saved/CSDebug/AutoPilot/Script/以下のコマンドスクリプトを実行(拡張子省略で.txt)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+		if (AutoPilotComponent == nullptr
+			|| InArgs.Num() < 1)
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("RunScript : UCSDebugAutoPilotComponent or FileName not found"));
+			return;
+		}
+		AutoPilotComponent->RequestCommandScript(InArgs[0]);
+	})
+);
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotStopScriptCommand(
+	TEXT("CSDebug.AutoPilot.StopScript"),
+	TEXT("CSDebug.AutoPilot.StopScript : コマンドスクリプトの実行を止める"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		if (UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr)
+		{
+			AutoPilotComponent->RequestEndCommand();
+		}
+	})
+);
+
+/**
+ * @brief	PlayerInputの処理前
+ *			前フレームで終わったキーを離す→命令を進める→入力中のキーを流す
+ */
+void	UCSDebugAutoPilotModeCommand::PreProcessInput(float DeltaTime)
+{
+	APlayerController* PlayerControler = GetPlayerController();
+	if (!mbRunning
+		|| PlayerControler == nullptr)
+	{
+		return;
+	}
+
+	PlayerControler->InputAxis(EKeys::Gamepad_LeftX, 0.f, DeltaTime, 1, true);
+	PlayerControler->InputAxis(EKeys::Gamepad_LeftY, 0.f, DeltaTime, 1, true);
+	PlayerControler->InputAxis(EKeys::Gamepad_RightX, 0.f, DeltaTime, 1, true);
+	PlayerControler->InputAxis(EKeys::Gamepad_RightY, 0.f, DeltaTime, 1, true);
+
+	for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+	{
+		const FActiveKey& ActiveKey = mActiveKeyList[i];
+		if (ActiveKey.mbActive
+			&& ActiveKey.mbPressed
+			&& ActiveKey.mRemainSec <= 0.f)
+		{
+			EndKey(i);
+		}
+	}
+
+	const TArray<FCSDebugAutoPilotScriptOp>& OpList = mScript.GetOpList();
+	int32 OpNum = 0;
+	while (mbRunning)
+	{
+		if (++OpNum > sMaxOpPerFrame)
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Command %s : %d ops in 1 frame (line %d) Loop without Wait?"), *mFileName, sMaxOpPerFrame, OpList[mOpIndex].mLine);
+			break;
+		}
+		if (!ExecuteOp(OpList[mOpIndex]))
+		{
+			mOpSec += DeltaTime;
+			break;
+		}
+	}
+
+	for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+	{
+		FActiveKey& ActiveKey = mActiveKeyList[i];
+		if (!ActiveKey.mbActive)
+		{
+			continue;
+		}
+		const FKey& Key = GetKey(static_cast<ECSDebugAutoPilotKey>(i));
+		if (Key.IsAxis1D())
+		{
+			PlayerControler->InputAxis(Key, ActiveKey.mValue, DeltaTime, 1, true);
+		}
+		else
+		{
+			PlayerControler->InputKey(Key, ActiveKey.mbPressed ? EInputEvent::IE_Repeat : EInputEvent::IE_Pressed, 1.f, true);
+		}
+		ActiveKey.mbPressed = true;
+		ActiveKey.mRemainSec -= DeltaTime;
+	}
+	if (mbMove)
+	{
+		PlayerControler->InputAxis(EKeys::Gamepad_LeftX, mMoveStick.X, DeltaTime, 1, true);
+		PlayerControler->InputAxis(EKeys::Gamepad_LeftY, mMoveStick.Y, DeltaTime, 1, true);
+	}
+
+	++mFrame;
+}
+
+/**
+ * @brief	Draw
+ */
+void	UCSDebugAutoPilotModeCommand::DebugDraw(class UCanvas* InCanvas)
+{
+	if (!mbRunning)
+	{
+		return;
+	}
+
+	for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+	{
+		const FActiveKey& ActiveKey = mActiveKeyList[i];
+		if (ActiveKey.mbActive)
+		{
+			AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(static_cast<ECSDebugAutoPilotKey>(i), ActiveKey.mValue));
+		}
+	}
+	if (mbMove)
+	{
+		AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(ECSDebugAutoPilotKey::LeftStickX, mMoveStick.X));
+		AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(ECSDebugAutoPilotKey::LeftStickY, mMoveStick.Y));
+	}
+	DebugDrawPad(InCanvas);
+
+	const FCSDebugAutoPilotScriptOp& Op = mScript.GetOpList()[mOpIndex];
+	mInfoWindow.ClearString();
+	mInfoWindow.SetWindowName(FString::Printf(TEXT("AutoPilot Command : %s"), *mFileName));
+	mInfoWindow.AddText(FString::Printf(TEXT("Line : %d"), Op.mLine));
+	mInfoWindow.AddText(FString::Printf(TEXT("Frame : %u"), mFrame));
+	mInfoWindow.AddText(FString::Printf(TEXT("Time : %.2fs"), FPlatformTime::Seconds() - mBeginSec));
+	for (int32 i = 0; i < mLoopStateList.Num(); ++i)
+	{
+		mInfoWindow.AddText(FString::Printf(TEXT("Loop%d : %d"), i, mLoopStateList[i].mCount));
+	}
+	mInfoWindow.FittingWindowExtent(InCanvas);
+	mInfoWindow.Draw(InCanvas, 0.05f, 0.1f);
+}
+
+/**
+ * @brief	スクリプト実行開始(Saved/CSDebug/AutoPilot/Script/以下 拡張子省略で.txt)
+ */
+bool	UCSDebugAutoPilotModeCommand::RequestScript(const FString& InFileName)
+{
+	RequestEnd();
+
+	FString Path = FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/Script/") + InFileName;
+	if (FPaths::GetExtension(InFileName).IsEmpty())
+	{
+		Path += TEXT(".txt");
+	}
+	FString Error;
+	if (!mScript.LoadFile(Path, Error))
+	{
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Command %s : %s"), *InFileName, *Error);
+		return false;
+	}
+
+	//実行中に文字列やループ状態を作らないように先に用意
+	mConditionNameList.Reset();
+	for (const FCSDebugAutoPilotScriptOp& Op : mScript.GetOpList())
+	{
+		if (Op.mOp == ECSDebugAutoPilotScriptOp::WaitUntil)
+		{
+			mConditionNameList.SetNum(FMath::Max(mConditionNameList.Num(), Op.mArg + 1));
+			mConditionNameList[Op.mArg] = FName(*mScript.GetString(Op.mArg));
+		}
+	}
+	mLoopStateList.Reset();
+	mLoopStateList.SetNum(mScript.GetLoopNum());
+
+	mFileName = InFileName;
+	mBeginSec = FPlatformTime::Seconds();
+	mFrame = 0;
+	mbMove = false;
+	mbRunning = true;
+	NextOp(0);
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Command %s : Begin (%d ops)"), *mFileName, mScript.GetOpList().Num());
+	return true;
+}
+
+/**
+ * @brief	実行終了(入力中のキーを離す)
+ */
+void	UCSDebugAutoPilotModeCommand::RequestEnd()
+{
+	if (!mbRunning)
+	{
+		return;
+	}
+	for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+	{
+		if (mActiveKeyList[i].mbActive)
+		{
+			EndKey(i);
+		}
+	}
+	mbMove = false;
+	mbRunning = false;
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Command %s : End %.2fs %u frames"), *mFileName, FPlatformTime::Seconds() - mBeginSec, mFrame);
+}
+
+/**
+ * @brief	命令を1つ処理
+ *			終わったら次の命令へ進めてtrue 待ちならfalse
+ */
+bool	UCSDebugAutoPilotModeCommand::ExecuteOp(const FCSDebugAutoPilotScriptOp& InOp)
+{
+	switch (InOp.mOp)
+	{
+	case ECSDebugAutoPilotScriptOp::Press:
+		BeginKey(InOp.mKeyId, InOp.mSec, InOp.mValue);
+		break;
+	case ECSDebugAutoPilotScriptOp::Hold:
+		if (!mbOpStarted)
+		{
+			BeginKey(InOp.mKeyId, InOp.mSec, InOp.mValue);
+			mbOpStarted = true;
+			return false;
+		}
+		if (mActiveKeyList[InOp.mKeyId].mbActive)
+		{
+			return false;
+		}
+		break;
+	case ECSDebugAutoPilotScriptOp::Move:
+		if (!UpdateMove(InOp))
+		{
+			return false;
+		}
+		break;
+	case ECSDebugAutoPilotScriptOp::Wait:
+		if (mOpSec < InOp.mSec)
+		{
+			return false;
+		}
+		break;
+	case ECSDebugAutoPilotScriptOp::WaitUntil:
+		if (!CheckCondition(InOp))
+		{
+			if (InOp.mSec <= 0.f
+				|| mOpSec < InOp.mSec)
+			{
+				return false;
+			}
+			UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Command %s : line %d WaitUntil %s timeout"), *mFileName, InOp.mLine, *mScript.GetString(InOp.mArg));
+		}
+		break;
+	case ECSDebugAutoPilotScriptOp::Warp:
+		if (APawn* Pawn = GetPlayerController()->GetPawn())
+		{
+			Pawn->SetActorLocation(InOp.mPos, false, nullptr, ETeleportType::TeleportPhysics);
+			if (InOp.mArg != 0)
+			{
+				const FRotator Rot(0.f, InOp.mValue, 0.f);
+				Pawn->SetActorRotation(Rot);
+				GetPlayerController()->SetControlRotation(Rot);
+			}
+			if (const ACharacter* Character = Cast<ACharacter>(Pawn))
+			{
+				Character->GetCharacterMovement()->StopMovementImmediately();
+			}
+		}
+		break;
+	case ECSDebugAutoPilotScriptOp::Exec:
+		GetPlayerController()->ConsoleCommand(mScript.GetString(InOp.mArg));
+		break;
+	case ECSDebugAutoPilotScriptOp::Loop:
+	{
+		FLoopState& LoopState = mLoopStateList[InOp.mLoopIndex];
+		LoopState.mBeginSec = FPlatformTime::Seconds();
+		LoopState.mBeginFrame = mFrame;
+		LoopState.mCount = 0;
+		break;
+	}
+	case ECSDebugAutoPilotScriptOp::EndLoop:
+	{
+		FLoopState& LoopState = mLoopStateList[InOp.mLoopIndex];
+		const FCSDebugAutoPilotScriptOp& LoopOp = mScript.GetOpList()[InOp.mArg];
+		const double NowSec = FPlatformTime::Seconds();
+		const uint32 FrameNum = mFrame + 1 - LoopState.mBeginFrame;
+		++LoopState.mCount;
+		UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Command %s : Loop(line %d) %d/%d %.2fs %u frames (avg %.2fms)"),
+			*mFileName, LoopOp.mLine, LoopState.mCount, LoopOp.mArg, NowSec - LoopState.mBeginSec, FrameNum, (NowSec - LoopState.mBeginSec) * 1000.0 / FrameNum);
+		if (LoopOp.mArg == 0
+			|| LoopState.mCount < LoopOp.mArg)
+		{
+			LoopState.mBeginSec = NowSec;
+			LoopState.mBeginFrame = mFrame + 1;
+			NextOp(InOp.mArg + 1);
+			return true;
+		}
+		break;
+	}
+	case ECSDebugAutoPilotScriptOp::End:
+		RequestEnd();
+		return false;
+	default:
+		break;
+	}
+
+	NextOp(mOpIndex + 1);
+	return true;
+}
+
+/**
+ * @brief	次に実行する命令
+ */
+void	UCSDebugAutoPilotModeCommand::NextOp(const int32 InOpIndex)
+{
+	mOpIndex = InOpIndex;
+	mOpSec = 0.f;
+	mbOpStarted = false;
+}
+
+/**
+ * @brief	目的地へ向けて左スティックを倒す(カメラの向き基準)
+ *			着いたかタイムアウトでtrue
+ */
+bool	UCSDebugAutoPilotModeCommand::UpdateMove(const FCSDebugAutoPilotScriptOp& InOp)
+{
+	const APlayerController* PlayerControler = GetPlayerController();
+	const APawn* Pawn = PlayerControler->GetPawn();
+	mbMove = false;
+	if (Pawn == nullptr)
+	{
+		return (InOp.mSec > 0.f && mOpSec >= InOp.mSec);
+	}
+
+	const FVector Delta = InOp.mPos - Pawn->GetActorLocation();
+	const FVector2D Delta2D(Delta.X, Delta.Y);
+	if (Delta2D.SizeSquared() <= FMath::Square(InOp.mValue))
+	{
+		return true;
+	}
+	if (InOp.mSec > 0.f
+		&& mOpSec >= InOp.mSec)
+	{
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Command %s : line %d Move timeout (%.1fcm left)"), *mFileName, InOp.mLine, Delta2D.Size());
+		return true;
+	}
+
+	mMoveStick = sCalcMoveStick(*PlayerControler, Delta);
+	mbMove = true;
+	return false;
+}
+
+/**
+ * @brief	WaitUntilの条件
+ *			Grounded:着地してる Stopped:止まってる それ以外はComponentに登録された条件
+ */
+bool	UCSDebugAutoPilotModeCommand::CheckCondition(const FCSDebugAutoPilotScriptOp& InOp) const
+{
+	static const FName sGroundedName(TEXT("Grounded"));
+	static const FName sStoppedName(TEXT("Stopped"));
+
+	const FName& ConditionName = mConditionNameList[InOp.mArg];
+	const APawn* Pawn = GetPlayerController()->GetPawn();
+	if (ConditionName == sGroundedName)
+	{
+		const ACharacter* Character = Cast<ACharacter>(Pawn);
+		return (Character && Character->GetCharacterMovement()->IsMovingOnGround());
+	}
+	if (ConditionName == sStoppedName)
+	{
+		return (Pawn && Pawn->GetVelocity().SizeSquared() < 1.f);
+	}
+
+	const UCSDebugAutoPilotComponent* AutoPilotComponent = Cast<UCSDebugAutoPilotComponent>(GetOuter());
+	const FCSDebugAutoPilotCommandConditionDelegate* Delegate = AutoPilotComponent ? AutoPilotComponent->FindCommandConditionDelegate(ConditionName) : nullptr;
+	if (Delegate == nullptr
+		|| !Delegate->IsBound())
+	{
+		//待ち続けて止まるよりは進める
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Command %s : line %d unknown condition %s"), *mFileName, InOp.mLine, *ConditionName.ToString());
+		return true;
+	}
+	return Delegate->Execute();
+}
+
+/**
+ * @brief	キー入力開始(入力中なら時間と値を上書き)
+ */
+void	UCSDebugAutoPilotModeCommand::BeginKey(const uint8 InKeyId, const float InSec, const float InValue)
+{
+	FActiveKey& ActiveKey = mActiveKeyList[InKeyId];
+	ActiveKey.mRemainSec = InSec;
+	ActiveKey.mValue = InValue;
+	if (!ActiveKey.mbActive)
+	{
+		ActiveKey.mbPressed = false;
+		ActiveKey.mbActive = true;
+	}
+}
+
+/**
+ * @brief	キー入力終了
+ */
+void	UCSDebugAutoPilotModeCommand::EndKey(const uint8 InKeyId)
+{
+	const FKey& Key = GetKey(static_cast<ECSDebugAutoPilotKey>(InKeyId));
+	APlayerController* PlayerControler = GetPlayerController();
+	if (PlayerControler
+		&& !Key.IsAxis1D()
+		&& mActiveKeyList[InKeyId].mbPressed)
+	{
+		PlayerControler->InputKey(Key, EInputEvent::IE_Released, 1.f, true);
+	}
+	mActiveKeyList[InKeyId].mbActive = false;
+}
@@ -0,0 +1,79 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotModeCommand.h
+ * @brief 自動入力 コマンドスクリプトを実行するモード
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AutoPilot/CSDebugAutoPilotModeBase.h"
+#include "AutoPilot/CSDebugAutoPilotScript.h"
+#include "ScreenWindow/CSDebug_ScreenWindowText.h"
+#include "CSDebugAutoPilotModeCommand.generated.h"
+
+class UCanvas;
+
+/**
+ * 解析済みの命令配列をIndexで進めるだけなので 実行中の毎フレームのメモリ確保は無し
+ * 同じルートを何周もさせる負荷計測等に(ループ毎の時間をログに出す)
+ */
+UCLASS()
+class CSDEBUG_API UCSDebugAutoPilotModeCommand : public UCSDebugAutoPilotModeBase
+{
+	GENERATED_BODY()
+
+	static const int32	sMaxOpPerFrame = 256;//待ちの無いループで固まらないように1フレームで進める命令数の上限
+	/* ------------------------------------------------------------
+	   !入力中のキー
+	------------------------------------------------------------ */
+	struct FActiveKey
+	{
+		float	mRemainSec = 0.f;//0以下になった次のフレームで離す
+		float	mValue = 0.f;
+		bool	mbPressed = false;//IE_Pressedを送ったか
+		bool	mbActive = false;
+	};
+	/* ------------------------------------------------------------
+	   !ループの実行状態
+	------------------------------------------------------------ */
+	struct FLoopState
+	{
+		double	mBeginSec = 0.0;
+		uint32	mBeginFrame = 0;
+		int32	mCount = 0;
+	};
+
+public:
+	virtual void	PreProcessInput(float DeltaTime) override;
+	virtual void	DebugDraw(class UCanvas* InCanvas) override;
+
+	bool	RequestScript(const FString& InFileName);
+	void	RequestEnd();
+	bool	IsFinish() const { return !mbRunning; }
+
+private:
+	bool	ExecuteOp(const FCSDebugAutoPilotScriptOp& InOp);
+	void	NextOp(const int32 InOpIndex);
+	bool	UpdateMove(const FCSDebugAutoPilotScriptOp& InOp);
+	bool	CheckCondition(const FCSDebugAutoPilotScriptOp& InOp) const;
+	void	BeginKey(const uint8 InKeyId, const float InSec, const float InValue);
+	void	EndKey(const uint8 InKeyId);
+
+private:
+	FCSDebugAutoPilotScript	mScript;
+	TArray<FName>	mConditionNameList;//スクリプトの文字列IndexでWaitUntilの条件名を引く
+	TArray<FLoopState>	mLoopStateList;
+	FActiveKey	mActiveKeyList[static_cast<int32>(ECSDebugAutoPilotKey::Num)];//ECSDebugAutoPilotKeyで引く
+	FCSDebug_ScreenWindowText	mInfoWindow;
+	FString	mFileName;
+	FVector2D	mMoveStick = FVector2D::ZeroVector;
+	double	mBeginSec = 0.0;
+	uint32	mFrame = 0;
+	int32	mOpIndex = 0;
+	float	mOpSec = 0.f;//今の命令で待った時間
+	bool	mbOpStarted = false;
+	bool	mbMove = false;
+	bool	mbRunning = false;
+};
@@ -0,0 +1,410 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotModeRandom.cpp
+ * @brief 自動入力 シード固定のランダムなパッド入力を流すモード
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotModeRandom.h"
+#include "AutoPilot/CSDebugAutoPilotComponent.h"
+#include "CSDebug_Subsystem.h"
+#include "CSDebug_Config.h"
+
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotBeginRandomCommand(
+	TEXT("CSDebug.AutoPilot.BeginRandom"),
+	TEXT("CSDebug.AutoPilot.BeginRandom [Seed] [FileName] : ランダム入力開始(Seed0ならConfigか開始時刻 入力はFileNameへ記録)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+		if (AutoPilotComponent == nullptr)
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("BeginRandom : UCSDebugAutoPilotComponent not found"));
+			return;
+		}
+		const int32 Seed = (InArgs.Num() > 0) ? FCString::Atoi(*InArgs[0]) : 0;
+		const FString FileName = (InArgs.Num() > 1) ? InArgs[1] : FString();
+		AutoPilotComponent->RequestBeginRandom(Seed, FileName);
+	})
+);
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotEndRandomCommand(
+	TEXT("CSDebug.AutoPilot.EndRandom"),
+	TEXT("CSDebug.AutoPilot.EndRandom : ランダム入力終了"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		if (UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr)
+		{
+			AutoPilotComponent->RequestEndRandom();
+		}
+	})
+);
+
+/**
+ * @brief	親セット時(Configから入力の選び方を作る)
+ */
+void	UCSDebugAutoPilotModeRandom::OnSetParent()
+{
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	mKeyWeightList.Reset();
+	if (CSDebugConfig->mAutoPilot_RandomKeyList.Num() == 0)
+	{
+		const FCSDebugAutoPilotRandomKey DefaultConfig;
+		for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+		{
+			const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(i);
+			if (GetKey(KeyId).IsValid())
+			{
+				AddKeyWeight(KeyId, DefaultConfig);
+			}
+		}
+	}
+	else
+	{
+		for (const FCSDebugAutoPilotRandomKey& Config : CSDebugConfig->mAutoPilot_RandomKeyList)
+		{
+			ECSDebugAutoPilotKey KeyId = ECSDebugAutoPilotKey::Invalid;
+			for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+			{
+				if (GetKey(static_cast<ECSDebugAutoPilotKey>(i)) == Config.mKey)
+				{
+					KeyId = static_cast<ECSDebugAutoPilotKey>(i);
+					break;
+				}
+			}
+			if (KeyId == ECSDebugAutoPilotKey::Invalid)
+			{
+				UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Random : %s is not pad key"), *Config.mKey.ToString());
+				continue;
+			}
+			AddKeyWeight(KeyId, Config);
+		}
+	}
+
+	mInputPerFrame = FMath::Max(CSDebugConfig->mAutoPilot_RandomInputPerSec, 0.f) / static_cast<float>(sFrameRate);
+}
+
+/**
+ * @brief	PlayerInputの処理前
+ *			離す→新しく始める→入力中のキーを流す の順 記録も同じ順に積む
+ */
+void	UCSDebugAutoPilotModeRandom::PreProcessInput(float DeltaTime)
+{
+	APlayerController* PlayerControler = GetPlayerController();
+	if (!mbActive
+		|| PlayerControler == nullptr)
+	{
+		return;
+	}
+
+	PlayerControler->InputAxis(EKeys::Gamepad_LeftX, 0.f, DeltaTime, 1, true);
+	PlayerControler->InputAxis(EKeys::Gamepad_LeftY, 0.f, DeltaTime, 1, true);
+	PlayerControler->InputAxis(EKeys::Gamepad_RightX, 0.f, DeltaTime, 1, true);
+	PlayerControler->InputAxis(EKeys::Gamepad_RightY, 0.f, DeltaTime, 1, true);
+
+	for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+	{
+		const FActiveKey& ActiveKey = mActiveKeyList[i];
+		if (ActiveKey.mbActive
+			&& ActiveKey.mEndFrame < mFrame)
+		{
+			EndKey(static_cast<ECSDebugAutoPilotKey>(i));
+		}
+	}
+
+	if (mKeyWeightList.Num() > 0)
+	{
+		const int32 InputNum = FMath::FloorToInt(mInputPerFrame);
+		const int32 BeginNum = InputNum + ((mRandomStream.FRand() < mInputPerFrame - static_cast<float>(InputNum)) ? 1 : 0);
+		for (int32 i = 0; i < BeginNum; ++i)
+		{
+			const FKeyWeight& KeyWeight = ChooseKey();
+			if (!mActiveKeyList[static_cast<int32>(KeyWeight.mKey)].mbActive)
+			{
+				BeginKey(KeyWeight, DeltaTime);
+			}
+		}
+	}
+
+	for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+	{
+		const FActiveKey& ActiveKey = mActiveKeyList[i];
+		if (!ActiveKey.mbActive)
+		{
+			continue;
+		}
+		const FKey& Key = GetKey(static_cast<ECSDebugAutoPilotKey>(i));
+		if (Key.IsAxis1D())
+		{
+			PlayerControler->InputAxis(Key, ActiveKey.mAxisValue, ActiveKey.mDeltaTime, 1, true);
+		}
+		else if (mFrame == ActiveKey.mBeginFrame)
+		{
+			PlayerControler->InputKey(Key, EInputEvent::IE_Pressed, 1.f, true);
+		}
+		else
+		{
+			PlayerControler->InputKey(Key, EInputEvent::IE_Repeat, 1.f, true);
+		}
+	}
+
+	++mFrame;
+}
+
+/**
+ * @brief	Draw
+ */
+void	UCSDebugAutoPilotModeRandom::DebugDraw(class UCanvas* InCanvas)
+{
+	if (!mbActive)
+	{
+		return;
+	}
+
+	//表示する時だけ入力中のキーから作る
+	for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+	{
+		const FActiveKey& ActiveKey = mActiveKeyList[i];
+		if (ActiveKey.mbActive)
+		{
+			AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(static_cast<ECSDebugAutoPilotKey>(i), ActiveKey.mAxisValue));
+		}
+	}
+	DebugDrawPad(InCanvas);
+
+	mInfoWindow.ClearString();
+	mInfoWindow.SetWindowName(TEXT("AutoPilot Random"));
+	mInfoWindow.AddText(FString::Printf(TEXT("Seed : %d"), mSeed));
+	mInfoWindow.AddText(FString::Printf(TEXT("Frame : %u"), mFrame));
+	mInfoWindow.AddText(FString::Printf(TEXT("Input : %u"), mInputNum));
+	if (mRecordWriter.IsRunning())
+	{
+		mInfoWindow.AddText(FString::Printf(TEXT("Record : %s"), *FPaths::GetCleanFilename(mRecordPath)));
+	}
+	mInfoWindow.FittingWindowExtent(InCanvas);
+	mInfoWindow.Draw(InCanvas, 0.05f, 0.1f);
+}
+
+/**
+ * @brief	ランダム入力開始
+ *			InSeedが0ならConfigのシード それも0なら開始時刻から決める
+ *			InRecordFileNameが空ならRandom_<Seed>.csrec
+ */
+void	UCSDebugAutoPilotModeRandom::RequestBegin(const int32 InSeed, const FString& InRecordFileName)
+{
+	RequestEnd();
+
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	mSeed = (InSeed != 0) ? InSeed : CSDebugConfig->mAutoPilot_RandomSeed;
+	if (mSeed == 0)
+	{
+		mSeed = static_cast<int32>(FPlatformTime::Cycles() & MAX_int32) | 1;
+	}
+	mRandomStream.Initialize(mSeed);
+	for (FActiveKey& ActiveKey : mActiveKeyList)
+	{
+		ActiveKey = FActiveKey();
+	}
+	mFrame = 0;
+	mInputNum = 0;
+	mbActive = true;
+
+	if (CSDebugConfig->mAutoPilot_bRandomRecord)
+	{
+		const FString FileName = InRecordFileName.IsEmpty() ? FString::Printf(TEXT("Random_%d"), mSeed) : InRecordFileName;
+		BeginRecord(FileName);
+	}
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot BeginRandom : Seed %d Key %d Record %s"), mSeed, mKeyWeightList.Num(), mRecordWriter.IsRunning() ? *mRecordPath : TEXT("None"));
+}
+
+/**
+ * @brief	ランダム入力終了(入力中のキーを離して記録を閉じる)
+ */
+void	UCSDebugAutoPilotModeRandom::RequestEnd()
+{
+	if (!mbActive)
+	{
+		return;
+	}
+
+	for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+	{
+		if (mActiveKeyList[i].mbActive)
+		{
+			EndKey(static_cast<ECSDebugAutoPilotKey>(i));
+		}
+	}
+	if (mRecordWriter.IsRunning())
+	{
+		mRecordWriter.Finish(mFrame);
+	}
+	mbActive = false;
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot EndRandom : Seed %d Frame %u Input %u"), mSeed, mFrame, mInputNum);
+}
+
+/**
+ * @brief	入力の選び方を追加
+ */
+void	UCSDebugAutoPilotModeRandom::AddKeyWeight(const ECSDebugAutoPilotKey InKey, const FCSDebugAutoPilotRandomKey& InConfig)
+{
+	if (InConfig.mWeight <= 0.f)
+	{
+		return;
+	}
+	FKeyWeight KeyWeight;
+	KeyWeight.mKey = InKey;
+	KeyWeight.mWeightSum = InConfig.mWeight + ((mKeyWeightList.Num() > 0) ? mKeyWeightList.Last().mWeightSum : 0.f);
+	KeyWeight.mHoldMinFrame = static_cast<uint32>(FMath::Max(FMath::RoundToInt(InConfig.mHoldMinSec * sFrameRate), 1));
+	KeyWeight.mHoldMaxFrame = static_cast<uint32>(FMath::Max(FMath::RoundToInt(InConfig.mHoldMaxSec * sFrameRate), 1));
+	KeyWeight.mHoldMaxFrame = FMath::Max(KeyWeight.mHoldMaxFrame, KeyWeight.mHoldMinFrame);
+	KeyWeight.mbExponential = (InConfig.mHoldType == ECSDebugAutoPilotRandomHoldType::Exponential);
+	mKeyWeightList.Add(KeyWeight);
+}
+
+/**
+ * @brief	重みに従ってキーを選ぶ
+ */
+const UCSDebugAutoPilotModeRandom::FKeyWeight&	UCSDebugAutoPilotModeRandom::ChooseKey() const
+{
+	const float Value = mRandomStream.FRand() * mKeyWeightList.Last().mWeightSum;
+	int32 Low = 0;
+	int32 High = mKeyWeightList.Num() - 1;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (mKeyWeightList[Mid].mWeightSum <= Value)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return mKeyWeightList[Low];
+}
+
+/**
+ * @brief	押しっぱなしにするフレーム数を選ぶ
+ *			Exponentialは平均が幅の1/3の指数分布をMaxで切る
+ */
+uint32	UCSDebugAutoPilotModeRandom::ChooseHoldFrame(const FKeyWeight& InKeyWeight)
+{
+	const float Rand = mRandomStream.FRand();
+	const uint32 HoldRange = InKeyWeight.mHoldMaxFrame - InKeyWeight.mHoldMinFrame;
+	if (!InKeyWeight.mbExponential)
+	{
+		return InKeyWeight.mHoldMinFrame + FMath::Min(static_cast<uint32>(Rand * static_cast<float>(HoldRange + 1)), HoldRange);
+	}
+	const float Mean = static_cast<float>(HoldRange) / 3.f;
+	const float Offset = -FMath::Loge(1.f - Rand) * Mean;
+	return InKeyWeight.mHoldMinFrame + FMath::Min(static_cast<uint32>(Offset), HoldRange);
+}
+
+/**
+ * @brief	入力開始
+ *			スティックはデッドゾーンより外の値で向きもランダム
+ */
+void	UCSDebugAutoPilotModeRandom::BeginKey(const FKeyWeight& InKeyWeight, const float InDeltaTime)
+{
+	const uint32 HoldFrame = ChooseHoldFrame(InKeyWeight);
+	float AxisValue = 1.f;
+	if (FCSDebugAutoPilotPadSnapshot::sGetAxisIndex(InKeyWeight.mKey) != INDEX_NONE)
+	{
+		const float PadDeadZone = FMath::Clamp(GetPadDeadZone(InKeyWeight.mKey), 0.f, 0.99f);
+		const float Rand = mRandomStream.FRand();
+		AxisValue = FMath::Lerp(PadDeadZone, 1.f, mRandomStream.FRand());
+		if (Rand < 0.5f)
+		{
+			AxisValue = -AxisValue;
+		}
+	}
+
+	FActiveKey& ActiveKey = mActiveKeyList[static_cast<int32>(InKeyWeight.mKey)];
+	ActiveKey.mBeginFrame = mFrame;
+	ActiveKey.mEndFrame = mFrame + HoldFrame - 1;
+	ActiveKey.mAxisValue = AxisValue;
+	ActiveKey.mDeltaTime = InDeltaTime;
+	ActiveKey.mbActive = true;
+	++mInputNum;
+	PushRecordEvent(InKeyWeight.mKey, true, AxisValue, InDeltaTime);
+}
+
+/**
+ * @brief	入力終了
+ */
+void	UCSDebugAutoPilotModeRandom::EndKey(const ECSDebugAutoPilotKey InKey)
+{
+	const FKey& Key = GetKey(InKey);
+	APlayerController* PlayerControler = GetPlayerController();
+	if (PlayerControler
+		&& !Key.IsAxis1D())
+	{
+		PlayerControler->InputKey(Key, EInputEvent::IE_Released, 1.f, true);
+	}
+	mActiveKeyList[static_cast<int32>(InKey)].mbActive = false;
+	PushRecordEvent(InKey, false, 0.f, 0.f);
+}
+
+/**
+ * @brief	流した入力の記録開始(開始位置は今のPawn)
+ */
+bool	UCSDebugAutoPilotModeRandom::BeginRecord(const FString& InRecordFileName)
+{
+	FCSDebugAutoPilotCommandList Header;
+	const APlayerController* PlayerControler = GetPlayerController();
+	if (const APawn* Pawn = PlayerControler ? PlayerControler->GetPawn() : nullptr)
+	{
+		const FVector Pos = Pawn->GetActorLocation();
+		const FRotator Rot = Pawn->GetActorRotation();
+		const FRotator CameraRot = PlayerControler->GetControlRotation();
+		Header.mStartPosX = Pos.X;
+		Header.mStartPosY = Pos.Y;
+		Header.mStartPosZ = Pos.Z;
+		Header.mStartRotatorPitch = Rot.Pitch;
+		Header.mStartRotatorYaw = Rot.Yaw;
+		Header.mStartRotatorRoll = Rot.Roll;
+		Header.mStartCameraRotatorPitch = CameraRot.Pitch;
+		Header.mStartCameraRotatorYaw = CameraRot.Yaw;
+		Header.mStartCameraRotatorRoll = CameraRot.Roll;
+		Header.mStartControllerPitch = CameraRot.Pitch;
+	}
+
+	mRecordPath = FPaths::ChangeExtension(FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/") + InRecordFileName, TEXT("csrec"));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(mRecordPath), true);
+	if (!mRecordWriter.Start(mRecordPath, Header))
+	{
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot BeginRandom : failed to open %s"), *mRecordPath);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief	入力の開始/終了を書き込みスレッドへ
+ */
+void	UCSDebugAutoPilotModeRandom::PushRecordEvent(const ECSDebugAutoPilotKey InKey, const bool bInBegin, const float InAxisValue, const float InDeltaTime)
+{
+	if (!mRecordWriter.IsRunning())
+	{
+		return;
+	}
+	FCSDebugAutoPilotRecordEvent Event;
+	Event.mFrame = mFrame;
+	Event.mKeyId = static_cast<uint8>(InKey);
+	Event.mbBegin = bInBegin;
+	if (bInBegin)
+	{
+		Event.mAxisValue = InAxisValue;
+		Event.mDeltaTime = InDeltaTime;
+		Event.mInputEventId = static_cast<uint8>(EInputEvent::IE_Pressed);
+	}
+	mRecordWriter.PushEvent(Event);
+}
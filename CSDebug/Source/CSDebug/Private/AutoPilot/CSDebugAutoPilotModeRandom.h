@@ -0,0 +1,88 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotModeRandom.h
+ * @brief 自動入力 シード固定のランダムなパッド入力を流すモード
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AutoPilot/CSDebugAutoPilotModeBase.h"
+#include "AutoPilot/CSDebugAutoPilotRecordFile.h"
+#include "ScreenWindow/CSDebug_ScreenWindowText.h"
+#include "Math/RandomStream.h"
+#include "CSDebugAutoPilotModeRandom.generated.h"
+
+class UCanvas;
+struct FCSDebugAutoPilotRandomKey;
+
+/**
+ * 乱数はフレーム毎に決まった回数だけ引くのでゲームの状態に依存しない
+ * 同じシードと固定フレームレートなら同じ入力列になる
+ * 流した入力は入力記録と同じ形式で書き出すので そのまま再生,縮小に使える
+ */
+UCLASS()
+class CSDEBUG_API UCSDebugAutoPilotModeRandom : public UCSDebugAutoPilotModeBase
+{
+	GENERATED_BODY()
+
+	/* ------------------------------------------------------------
+	   !入力の選び方(Configから作る)
+	------------------------------------------------------------ */
+	struct FKeyWeight
+	{
+		ECSDebugAutoPilotKey	mKey = ECSDebugAutoPilotKey::Invalid;
+		float	mWeightSum = 0.f;//ここまでの重みの累計(選ぶ時の二分探索用)
+		uint32	mHoldMinFrame = 1;
+		uint32	mHoldMaxFrame = 1;
+		bool	mbExponential = false;
+	};
+	/* ------------------------------------------------------------
+	   !入力中のキー
+	------------------------------------------------------------ */
+	struct FActiveKey
+	{
+		uint32	mBeginFrame = 0;
+		uint32	mEndFrame = 0;//この後のフレームで離す
+		float	mAxisValue = 0.f;
+		float	mDeltaTime = 0.f;
+		bool	mbActive = false;
+	};
+
+public:
+	static const int32	sFrameRate = 30;//入力の長さや頻度をフレームに直す時のフレームレート(記録と同じ)
+
+	virtual void	PreProcessInput(float DeltaTime) override;
+	virtual void	DebugDraw(class UCanvas* InCanvas) override;
+
+	void	RequestBegin(const int32 InSeed, const FString& InRecordFileName);
+	void	RequestEnd();
+	bool	IsActive() const { return mbActive; }
+	int32	GetSeed() const { return mSeed; }
+
+protected:
+	virtual void	OnSetParent() override;
+
+private:
+	void	AddKeyWeight(const ECSDebugAutoPilotKey InKey, const FCSDebugAutoPilotRandomKey& InConfig);
+	const FKeyWeight&	ChooseKey() const;
+	uint32	ChooseHoldFrame(const FKeyWeight& InKeyWeight);
+	void	BeginKey(const FKeyWeight& InKeyWeight, const float InDeltaTime);
+	void	EndKey(const ECSDebugAutoPilotKey InKey);
+	bool	BeginRecord(const FString& InRecordFileName);
+	void	PushRecordEvent(const ECSDebugAutoPilotKey InKey, const bool bInBegin, const float InAxisValue, const float InDeltaTime);
+
+private:
+	FRandomStream	mRandomStream;
+	TArray<FKeyWeight>	mKeyWeightList;
+	FActiveKey	mActiveKeyList[static_cast<int32>(ECSDebugAutoPilotKey::Num)];//ECSDebugAutoPilotKeyで引く
+	FCSDebugAutoPilotRecordStreamWriter	mRecordWriter;
+	FString	mRecordPath;
+	FCSDebug_ScreenWindowText	mInfoWindow;
+	uint32	mFrame = 0;
+	uint32	mInputNum = 0;//開始した入力の総数
+	int32	mSeed = 0;
+	float	mInputPerFrame = 0.f;
+	bool	mbActive = false;
+};
@@ -7,10 +7,129 @@
  */
 #include "AutoPilot/CSDebugAutoPilotModeRecord.h"
 #include "AutoPilot/CSDebugAutoPilotComponent.h"
+#include "AutoPilot/CSDebugAutoPilotRecordTool.h"
+
+#include "CSDebug_Subsystem.h"
+#include "CSDebug_Config.h"
 
 #include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Character.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Async/Async.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+static FAutoConsoleCommand sCSDebugAutoPilotBenchmarkPlaybackCommand(
+	TEXT("CSDebug.AutoPilot.BenchmarkPlayback"),
+	TEXT("CSDebug.AutoPilot.BenchmarkPlayback [NodeNum] : 合成した入力記録で再生処理の1フレーム当たりのコストを計測"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+	{
+		const int32 NodeNum = (InArgs.Num() > 0) ? FCString::Atoi(*InArgs[0]) : 100000;
+		UCSDebugAutoPilotModeRecord::sBenchmarkPlayTimeline(FMath::Max(NodeNum, 1));
+	})
+);
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotBenchmarkRecordCaptureCommand(
+	TEXT("CSDebug.AutoPilot.BenchmarkRecordCapture"),
+	TEXT("CSDebug.AutoPilot.BenchmarkRecordCapture [FrameNum] : 入力記録の1フレーム当たりのコストを計測(PlayerControllerにCSDebugAutoPilotComponentが必要)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+		if (AutoPilotComponent == nullptr)
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("BenchmarkRecordCapture : UCSDebugAutoPilotComponent not found"));
+			return;
+		}
+		const int32 FrameNum = (InArgs.Num() > 0) ? FCString::Atoi(*InArgs[0]) : 100000;
+		UCSDebugAutoPilotModeRecord* ModeRecord = NewObject<UCSDebugAutoPilotModeRecord>(AutoPilotComponent);
+		ModeRecord->SetParent(AutoPilotComponent);
+		ModeRecord->BenchmarkRecordCapture(FMath::Max(FrameNum, 1));
+		ModeRecord->MarkPendingKill();
+	})
+);
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotExportTelemetryCommand(
+	TEXT("CSDebug.AutoPilot.ExportTelemetry"),
+	TEXT("CSDebug.AutoPilot.ExportTelemetry Name.csv|Name.cstl : 直前の再生の負荷計測をTelemetry/以下に書き出し(拡張子で判定)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		const UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+		const UCSDebugAutoPilotModeRecord* ModeRecord = AutoPilotComponent ? AutoPilotComponent->GetModeRecord() : nullptr;
+		if (ModeRecord == nullptr
+			|| InArgs.Num() < 1)
+		{
+			return;
+		}
+		ModeRecord->ExportTelemetry(InArgs[0]);
+	})
+);
+static FAutoConsoleCommandWithWorldAndArgs sCSDebugAutoPilotFastForwardCommand(
+	TEXT("CSDebug.AutoPilot.FastForward"),
+	TEXT("CSDebug.AutoPilot.FastForward 1|0 [SkipRender 1|0] : 入力記録の再生をフレーム待ち無しで回す"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& InArgs, UWorld* InWorld)
+	{
+		APlayerController* PlayerController = InWorld ? InWorld->GetFirstPlayerController() : nullptr;
+		UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+		if (AutoPilotComponent == nullptr)
+		{
+			return;
+		}
+		const bool bFastForward = (InArgs.Num() > 0) ? FCString::ToBool(*InArgs[0]) : !AutoPilotComponent->IsFastForward();
+		const bool bSkipRender = (InArgs.Num() > 1) && FCString::ToBool(*InArgs[1]);
+		AutoPilotComponent->SetFastForward(bFastForward, bSkipRender);
+	})
+);
+static FAutoConsoleCommand sCSDebugAutoPilotConvertRecordCommand(
+	TEXT("CSDebug.AutoPilot.ConvertRecord"),
+	TEXT("CSDebug.AutoPilot.ConvertRecord Src.csrec Dst.json : 入力記録の形式変換(拡張子で判定 差分確認用にjson書き出し等)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+	{
+		if (InArgs.Num() < 2)
+		{
+			return;
+		}
+		const FString BasePath = FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/");
+		FCSDebugAutoPilotCommandList CommandList;
+		if (!FCSDebugAutoPilotRecordFile::LoadFile(BasePath + InArgs[0], CommandList))
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("ConvertRecord : failed to load %s"), *InArgs[0]);
+			return;
+		}
+		FCSDebugAutoPilotRecordFile::SaveFile(BasePath + InArgs[1], CommandList);
+	})
+);
+static FAutoConsoleCommand sCSDebugAutoPilotDiffRecordCommand(
+	TEXT("CSDebug.AutoPilot.DiffRecord"),
+	TEXT("CSDebug.AutoPilot.DiffRecord A.csrec B.csrec : 入力記録2つのコマンドの違いをログ出力(縮小はCSDebugAutoPilotRecordコマンドレット)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+	{
+		if (InArgs.Num() < 2)
+		{
+			return;
+		}
+		const FString BasePath = FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/");
+		FCSDebugAutoPilotCommandList ListA;
+		FCSDebugAutoPilotCommandList ListB;
+		if (!FCSDebugAutoPilotRecordFile::LoadFile(BasePath + InArgs[0], ListA)
+			|| !FCSDebugAutoPilotRecordFile::LoadFile(BasePath + InArgs[1], ListB))
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("DiffRecord : failed to load %s or %s"), *InArgs[0], *InArgs[1]);
+			return;
+		}
+		FCSDebugAutoPilotRecordDiffResult Result;
+		FCSDebugAutoPilotRecordTool::Diff(Result, ListA, ListB, 32);
+		FCSDebugAutoPilotRecordTool::LogDiff(Result, ListA, ListB);
+	})
+);
 
 /**
  * @brief	PlayerInputの処理前
@@ -30,6 +149,11 @@ void	UCSDebugAutoPilotModeRecord::PreProcessInput(float DeltaTime)
  */
 void	UCSDebugAutoPilotModeRecord::PostProcessInput(float DeltaTime)
 {
+	if (mMode == ECommandMode::PlayInputRecord)
+	{
+		VerifyPlayChecksum();
+		UpdateTelemetry();
+	}
 	UpdateInputRecord(DeltaTime);
 }
 
@@ -39,6 +163,49 @@ void	UCSDebugAutoPilotModeRecord::PostProcessInput(float DeltaTime)
 void	UCSDebugAutoPilotModeRecord::DebugDraw(class UCanvas* InCanvas)
 {
 	DebugDrawPad(InCanvas);
+	DebugDrawInfo(InCanvas);
+}
+
+/**
+ * @brief	再生状態の表示
+ */
+void	UCSDebugAutoPilotModeRecord::DebugDrawInfo(UCanvas* InCanvas)
+{
+	if (mMode != ECommandMode::PlayInputRecord)
+	{
+		return;
+	}
+
+	mInfoWindow.ClearString();
+	mInfoWindow.SetWindowName(FString::Printf(TEXT("AutoPilot Record : %s"), *mFileName));
+	if (mPlayInputRecordState == EPlayInputRecordState::Load)
+	{
+		mInfoWindow.AddText(TEXT("Loading..."));
+	}
+	else
+	{
+		mInfoWindow.AddText(FString::Printf(TEXT("Frame : %d / %d"), mPlayFrame, mCommand.mEndFrame));
+		mInfoWindow.AddText(FString::Printf(TEXT("LoadTime : %.2fms"), mLoadSec * 1000.0));
+		mInfoWindow.AddText(FString::Printf(TEXT("FileSize : %.1fKB"), static_cast<float>(mLoadFileSize) / 1024.f));
+		mInfoWindow.AddText(FString::Printf(TEXT("DecodedSize : %.1fKB"), static_cast<float>(mLoadDecodedSize) / 1024.f));
+		if (mChecksumResult.IsDiverged())
+		{
+			mInfoWindow.AddText(FString::Printf(TEXT("Checksum : Diverged %u/%u (First %u : %.2fcm)"),
+				mChecksumResult.mDivergeNum, mChecksumResult.mCheckNum, mChecksumResult.mFirstDivergeFrame, mChecksumResult.mFirstDivergeDistance));
+		}
+		else
+		{
+			mInfoWindow.AddText(FString::Printf(TEXT("Checksum : OK %u"), mChecksumResult.mCheckNum));
+		}
+		mInfoWindow.AddText(FString::Printf(TEXT("ChecksumCost : %.3fus"), mChecksumCostSec * 1000000.0));
+		mInfoWindow.AddText(FString::Printf(TEXT("Speed : x%.2f"), GetPlaySpeedRate()));
+		if (mbPlayTimeBased)
+		{
+			mInfoWindow.AddText(FString::Printf(TEXT("TimeBased : Record %.2fs / Play %.2fs"), mPlayRecordSec, mPlaySimSec));
+		}
+	}
+	mInfoWindow.FittingWindowExtent(InCanvas);
+	mInfoWindow.Draw(InCanvas, 0.05f, 0.1f);
 }
 
 /**
@@ -54,6 +221,7 @@ void	UCSDebugAutoPilotModeRecord::SetMode(ECommandMode InMode)
 	if (mMode == ECommandMode::PlayInputRecord)
 	{
 		GetParent()->SetIgnoreDefaultInput(false);
+		mTelemetry.End();
 	}
 
 	mMode = InMode;
@@ -63,6 +231,25 @@ void	UCSDebugAutoPilotModeRecord::SetMode(ECommandMode InMode)
 	{
 		GetParent()->SetIgnoreDefaultInput(true);
 	}
+	GetParent()->RefreshFixFrameRate();
+}
+
+/**
+ * @brief	フレームレートを固定するか(可変フレームレートの記録と時間基準の再生以外)
+ */
+bool	UCSDebugAutoPilotModeRecord::IsFixFrameRate() const
+{
+	switch (mMode)
+	{
+	case ECommandMode::PlayInputRecord:
+		return !mbPlayTimeBased;
+	case ECommandMode::BeginRecord:
+	case ECommandMode::Record:
+	case ECommandMode::EndRecord:
+		return !GetDefault<UCSDebug_Config>()->mAutoPilot_bRecordVariableFrameRate;
+	default:
+		return true;
+	}
 }
 
 /**
@@ -70,9 +257,11 @@ void	UCSDebugAutoPilotModeRecord::SetMode(ECommandMode InMode)
  */
 void UCSDebugAutoPilotModeRecord::RequestPlayInputRecord(const FString& InFileName)
 {
+	mbPlayTimeBased = GetDefault<UCSDebug_Config>()->mAutoPilot_bPlayTimeBased;
 	SetMode(ECommandMode::PlayInputRecord);
 	mFileName = InFileName;
 	mPlayFrame = 0;
+	mLoadFuture = TFuture<FPlayLoadResultPtr>();//前回のロード結果は捨てる
 	mPlayInputRecordState = EPlayInputRecordState::Load;
 }
 /**
@@ -112,14 +301,43 @@ void UCSDebugAutoPilotModeRecord::RequestIdle()
 	SetMode(ECommandMode::Idle);
 }
 
+/**
+ * @brief	再生中に指定フレーム数進める/戻す
+ *			次の再生フレームの頭で近いキーフレームへ飛ぶ
+ */
+void UCSDebugAutoPilotModeRecord::RequestSeekOffset(const int32 InFrameOffset)
+{
+	if (!IsPlayingInputRecord())
+	{
+		return;
+	}
+	mSeekOffset += InFrameOffset;
+	mbSeekRequest = true;
+}
+
 /**
  * @brief	出力ファイルパス取得
+ *			拡張子の指定があればそれで形式を決める(.csrec:バイナリ .json:json)
+ *			指定無しならバイナリ ただし再生時に古いjsonしか無ければそちら
  */
 FString	UCSDebugAutoPilotModeRecord::GetFilePath() const
 {
 	FString SavedPath = FPaths::ProjectSavedDir();
-	SavedPath += "CSDebug/AutoPilot/" + mFileName + ".json";
-	return SavedPath;
+	SavedPath += "CSDebug/AutoPilot/" + mFileName;
+	if (!FPaths::GetExtension(mFileName).IsEmpty())
+	{
+		return SavedPath;
+	}
+
+	const FString BinaryPath = SavedPath + ".csrec";
+	const FString JsonPath = SavedPath + ".json";
+	if (mMode == ECommandMode::PlayInputRecord
+		&& !FPaths::FileExists(BinaryPath)
+		&& FPaths::FileExists(JsonPath))
+	{
+		return JsonPath;
+	}
+	return BinaryPath;
 }
 
 /**
@@ -127,12 +345,20 @@ FString	UCSDebugAutoPilotModeRecord::GetFilePath() const
  */
 bool UCSDebugAutoPilotModeRecord::UpdatePlayInputRecord(float DeltaTime)
 {
-	APlayerController* PlayerControler = GetPlayerController();
-	//PlayerControler->FlushPressedKeys();
-	PlayerControler->InputAxis(EKeys::Gamepad_LeftX, 0.f, DeltaTime, 1, true);
-	PlayerControler->InputAxis(EKeys::Gamepad_LeftY, 0.f, DeltaTime, 1, true);
-	PlayerControler->InputAxis(EKeys::Gamepad_RightX, 0.f, DeltaTime, 1, true);
-	PlayerControler->InputAxis(EKeys::Gamepad_RightY, 0.f, DeltaTime, 1, true);
+	const int32 ControllerNum = FMath::Max(mControllerList.Num(), 1);
+	for (int32 ControllerId = 0; ControllerId < ControllerNum; ++ControllerId)
+	{
+		APlayerController* PlayerControler = GetControllerPlayerController(ControllerId);
+		if (PlayerControler == nullptr)
+		{
+			continue;
+		}
+		//PlayerControler->FlushPressedKeys();
+		PlayerControler->InputAxis(EKeys::Gamepad_LeftX, 0.f, DeltaTime, 1, true);
+		PlayerControler->InputAxis(EKeys::Gamepad_LeftY, 0.f, DeltaTime, 1, true);
+		PlayerControler->InputAxis(EKeys::Gamepad_RightX, 0.f, DeltaTime, 1, true);
+		PlayerControler->InputAxis(EKeys::Gamepad_RightY, 0.f, DeltaTime, 1, true);
+	}
 
 	switch (mPlayInputRecordState)
 	{
@@ -145,13 +371,34 @@ bool UCSDebugAutoPilotModeRecord::UpdatePlayInputRecord(float DeltaTime)
 	case EPlayInputRecordState::WaitReady:
 		if (!WaitPlayInputRecordFile(DeltaTime))
 		{
+			const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+			mTelemetry.Begin(GetParent()->GetWorld(), CSDebugConfig->mAutoPilot_TelemetryFrameNum);
+			mPlayBeginSec = FPlatformTime::Seconds();
+			mPlayWallSec = 0.0;
+			mPlaySimSec = 0.0;
+			mPlayRecordSec = 0.0;
 			mPlayInputRecordState = EPlayInputRecordState::Play;
 		}
 		break;
 	case EPlayInputRecordState::Play:
+		if (mbSeekRequest)
+		{
+			int64 SeekFrame = FMath::Max<int64>(static_cast<int64>(mPlayFrame) + mSeekOffset, 0);
+			if (mCommand.mEndFrame > 0)
+			{
+				SeekFrame = FMath::Min<int64>(SeekFrame, mCommand.mEndFrame);
+			}
+			SeekPlayFrame(static_cast<uint32>(SeekFrame), mSeekOffset > 0);
+			mSeekOffset = 0;
+			mbSeekRequest = false;
+		}
+		mPlaySimSec += DeltaTime;
 		if (!PlayInputRecordFile(DeltaTime))
 		{
+			mPlayWallSec = FPlatformTime::Seconds() - mPlayBeginSec;
 			mPlayInputRecordState = EPlayInputRecordState::Finish;
+			UE_LOG(CSDebugLog, Log, TEXT("AutoPilot PlayRecord %s : Frame %u Sim %.2fs Real %.2fs Speed x%.2f"),
+				*mFileName, mPlayFrame, mPlaySimSec, mPlayWallSec, GetPlaySpeedRate());
 		}
 		break;
 	case EPlayInputRecordState::Finish:
@@ -167,42 +414,105 @@ bool UCSDebugAutoPilotModeRecord::UpdatePlayInputRecord(float DeltaTime)
 
 /**
  * @brief	記録した入力をロード
+ *			ファイル読み込みとデコードはスレッドプールで行い 終わるまでLoad状態で待つ
  */
 bool UCSDebugAutoPilotModeRecord::LoadInputRecordFile(float DeltaTime)
 {
-	mPlayFrame = 0;
-	mCommand.mList.Empty();
-	mWarpInterval = 1.f;
+	if (!mLoadFuture.IsValid())
+	{
+		mPlayFrame = 0;
+		mCommand.mList.Empty();
+		mPlayTimeline.Reset();
+		mChecksumResult = FChecksumResult();
+		mbSeekChecksumLog = false;
+		mWarpInterval = 1.f;
+
+		const FString SavedPath = GetFilePath();
+		if (!FPaths::FileExists(SavedPath))
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot LoadRecord : not found %s"), *SavedPath);
+			SetMode(ECommandMode::Invalid);
+			return false;
+		}
+		mLoadFuture = Async(EAsyncExecution::ThreadPool, [SavedPath]()
+		{
+			return sLoadPlayRecord(SavedPath);
+		});
+		return false;
+	}
+
+	if (!mLoadFuture.IsReady())
+	{
+		return false;
+	}
 
-	const FString SavedPath = GetFilePath();
-	FString JsonString;
-	if (!FFileHelper::LoadFileToString(JsonString, *SavedPath))
+	const FPlayLoadResultPtr Result = mLoadFuture.Get();
+	mLoadFuture = TFuture<FPlayLoadResultPtr>();
+	if (!Result.IsValid()
+		|| !Result->mbSuccess)
 	{
+		SetMode(ECommandMode::Invalid);
 		return false;
 	}
 
-	TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(JsonString);
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	mPlayTimeline.mReader = MoveTemp(Result->mTimeline.mReader);
+	mPlayTimeline.mKeyframeList = MoveTemp(Result->mTimeline.mKeyframeList);
+	mCommand.CopyHeader(mPlayTimeline.mReader.GetHeader());
+	mLoadSec = Result->mLoadSec;
+	mLoadFileSize = Result->mFileSize;
+	mLoadDecodedSize = Result->mDecodedSize;
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot LoadRecord %s : %.2fms File %lldByte Decoded %lluByte Controller %u"),
+		*mFileName, mLoadSec * 1000.0, mLoadFileSize, static_cast<uint64>(mLoadDecodedSize), mCommand.mControllerNum);
+	PrepareControllerList(static_cast<int32>(mCommand.mControllerNum), true);
+	return true;
+}
 
-	if (FJsonSerializer::Deserialize(JsonReader, JsonObject)
-		&& JsonObject.IsValid()
-		)
+/**
+ * @brief	入力記録の読み込みとデコード(ワーカースレッドから呼ばれる)
+ *			UObjectには触らない 先頭チャンクのデコードと 以降のチャンクの先読み開始までここで済ませる
+ */
+UCSDebugAutoPilotModeRecord::FPlayLoadResultPtr	UCSDebugAutoPilotModeRecord::sLoadPlayRecord(const FString& InPath)
+{
+	FPlayLoadResultPtr Result = MakeShared<FPlayLoadResult, ESPMode::ThreadSafe>();
+	const double BeginSec = FPlatformTime::Seconds();
+
+	Result->mFileSize = IFileManager::Get().FileSize(*InPath);
+	if (FCSDebugAutoPilotRecordFile::IsBinaryPath(InPath))
 	{
-		mCommand.FromJson(JsonObject);
+		Result->mbSuccess = Result->mTimeline.mReader.Open(InPath);
 	}
 	else
 	{
-		SetMode(ECommandMode::Invalid);
-		return false;
+		FCommandList CommandList;
+		if (FCSDebugAutoPilotRecordFile::LoadJson(InPath, CommandList))
+		{
+			TArray<FCSDebugAutoPilotRecordEvent> EventList;
+			FCSDebugAutoPilotRecordFile::MakeEventList(EventList, CommandList.mList);
+			Result->mTimeline.mReader.OpenMemory(MoveTemp(EventList), CommandList);
+			Result->mbSuccess = true;
+		}
 	}
 
-	if (mCommand.mList.Num() == 0)
+	FCSDebugAutoPilotRecordReader& Reader = Result->mTimeline.mReader;
+	if (Result->mbSuccess
+		&& Reader.PeekEvent() == nullptr)
 	{
-		SetMode(ECommandMode::Invalid);
-		return false;
+		Result->mbSuccess = false;
 	}
 
-	return true;
+	//複数コントローラなら 1番以降の開始位置用に0フレーム目のキーフレームを先に拾っておく
+	if (Result->mbSuccess
+		&& Reader.GetHeader().mControllerNum > 1)
+	{
+		const int64 ChunkPos = Reader.GetChunkPos();
+		const int32 EventCursor = Reader.GetEventCursor();
+		Result->mTimeline.ScanKeyframe(0);
+		Result->mbSuccess = Reader.Seek(ChunkPos, EventCursor);
+	}
+
+	Result->mDecodedSize = Reader.GetAllocatedSize();
+	Result->mLoadSec = FPlatformTime::Seconds() - BeginSec;
+	return Result;
 }
 
 /**
@@ -210,6 +520,41 @@ bool UCSDebugAutoPilotModeRecord::LoadInputRecordFile(float DeltaTime)
  */
 bool UCSDebugAutoPilotModeRecord::WaitPlayInputRecordFile(float DeltaTime)
 {
+	//足りないプレイヤーのPawnが出来るまで待つ
+	if (!PrepareControllerList(static_cast<int32>(mCommand.mControllerNum), false))
+	{
+		return true;
+	}
+
+	//1番以降は0フレーム目のキーフレームの位置へ
+	bool bWarpOtherController = false;
+	if (const FPlayTimeline::FKeyframeIndex* StartKeyframeIndex = mPlayTimeline.FindKeyframe(0))
+	{
+		const int32 KeyframeNum = FMath::Min(StartKeyframeIndex->mControllerKeyframeList.Num(), mControllerList.Num());
+		for (int32 ControllerId = 1; ControllerId < KeyframeNum; ++ControllerId)
+		{
+			const FCSDebugAutoPilotRecordKeyframePtr& KeyframePtr = StartKeyframeIndex->mControllerKeyframeList[ControllerId];
+			APlayerController* PlayerController = GetControllerPlayerController(ControllerId);
+			APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+			if (!KeyframePtr.IsValid()
+				|| Pawn == nullptr)
+			{
+				continue;
+			}
+			if (FVector::DistSquared(KeyframePtr->mPos, Pawn->GetActorLocation()) > FMath::Square(0.1f)
+				|| !KeyframePtr->mRot.Equals(Pawn->GetActorRotation()))
+			{
+				Pawn->SetActorLocationAndRotation(KeyframePtr->mPos, KeyframePtr->mRot, false, nullptr, ETeleportType::TeleportPhysics);
+				PlayerController->SetControlRotation(KeyframePtr->mControlRot);
+				bWarpOtherController = true;
+			}
+		}
+	}
+	if (bWarpOtherController)
+	{
+		return true;
+	}
+
 	APlayerController* PlayerControler = GetPlayerController();
 	ACharacter* Player = Cast<ACharacter>(PlayerControler->GetPawn());
 	if (Player)
@@ -241,54 +586,198 @@ bool UCSDebugAutoPilotModeRecord::WaitPlayInputRecordFile(float DeltaTime)
  */
 bool UCSDebugAutoPilotModeRecord::PlayInputRecordFile(float DeltaTime)
 {
-	UCSDebugAutoPilotComponent* Parent = GetParent();
-	APlayerController* PlayerControler = GetPlayerController();
+	if (mbPlayTimeBased)
+	{
+		return PlayInputRecordTime(DeltaTime);
+	}
+
+	mPlayTimeline.Advance(mPlayFrame);
+
+	//前フレームで終わった入力
+	for (const FCommandNode& InCommand : mPlayTimeline.mReleaseNodeList)
+	{
+		APlayerController* PlayerControler = GetControllerPlayerController(InCommand.mControllerId);
+		if (PlayerControler == nullptr)
+		{
+			continue;
+		}
+		const FKey& Key = GetKey(static_cast<ECSDebugAutoPilotKey>(InCommand.mKeyId));
+		if (!Key.IsAxis1D())
+		//if (!Key.IsFloatAxis())
+		{
+			PlayerControler->InputKey(Key, EInputEvent::IE_Released, 1.f, true);
+		}
+	}
 
-	for (const FCommandNode& InCommand : mCommand.mList)
+	//入力中
+	for (const FCommandNode& InCommand : mPlayTimeline.mActiveNodeList)
 	{
+		APlayerController* PlayerControler = GetControllerPlayerController(InCommand.mControllerId);
+		if (PlayerControler == nullptr)
+		{
+			continue;
+		}
+		const bool bDebugDraw = (InCommand.mControllerId == 0);
 		const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(InCommand.mKeyId);
-		const FKey Key = GetKey(KeyId);
-		if (mPlayFrame >= InCommand.mBeginFrame
-			&& mPlayFrame <= InCommand.mEndFrame)
+		const FKey& Key = GetKey(KeyId);
+		if (Key.IsAxis1D())
+		//if (Key.IsFloatAxis())
 		{
-			if (Key.IsAxis1D())
-			//if (Key.IsFloatAxis())
+			PlayerControler->InputAxis(Key, InCommand.mAxisValue, InCommand.mDeltaTime, 1, true);
+			if (bDebugDraw)
 			{
-				PlayerControler->InputAxis(Key, InCommand.mAxisValue, InCommand.mDeltaTime, 1, true);
 				AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(KeyId, InCommand.mAxisValue));
 			}
+		}
+		else
+		{
+			if (mPlayFrame == InCommand.mBeginFrame)
+			{
+				PlayerControler->InputKey(Key, EInputEvent::IE_Pressed, 1.f, true);
+			}
 			else
 			{
-				if (mPlayFrame == InCommand.mBeginFrame)
-				{
-					PlayerControler->InputKey(Key, EInputEvent::IE_Pressed, 1.f, true);
-				}
-				else
-				{
-					PlayerControler->InputKey(Key, EInputEvent::IE_Repeat, 1.f, true);
-				}
+				PlayerControler->InputKey(Key, EInputEvent::IE_Repeat, 1.f, true);
+			}
+			if (bDebugDraw)
+			{
 				AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(KeyId, 1.f));
 			}
 		}
-		else if (InCommand.mEndFrame + 1 == mPlayFrame)
-		{//前フレームで処理してた
-			if (Key.IsAxis1D())
-			//if (Key.IsFloatAxis())
+	}
+
+	mPlayFrame += 1;
+	return HasPlayFrame();
+}
+
+/**
+ * @brief	記録した入力を時間基準で再生
+ *			このフレームの区間(前回～今回のmPlaySimSec)に始まる記録フレームを全部進めて
+ *			スティックは区間内で入力してた時間で重み付けした平均 ボタンは区間内の押した/離したを全部送る
+ *			60fpsや120fpsの記録でもフレームレートを固定せずに同じ時間分の入力になる
+ */
+bool UCSDebugAutoPilotModeRecord::PlayInputRecordTime(float DeltaTime)
+{
+	const double EndSec = mPlaySimSec;//UpdatePlayInputRecordで今回のDeltaTimeを足した後
+	double NowSec = EndSec - DeltaTime;
+	const uint32 BeginFrame = mPlayFrame;
+	mResampleReleaseNodeList.Reset();
+	while (mPlayRecordSec < EndSec
+		&& HasPlayFrame())
+	{
+		//次の記録フレームまでは今入力中の値のまま
+		if (mPlayRecordSec > NowSec)
+		{
+			AccumulateResampleAxis(static_cast<float>(mPlayRecordSec - NowSec));
+			NowSec = mPlayRecordSec;
+		}
+		mPlayTimeline.Advance(mPlayFrame);
+		mResampleReleaseNodeList.Append(mPlayTimeline.mReleaseNodeList);
+
+		//フレームの時間はチェックサムに入ってる(無いjsonや古い記録は固定フレームレートで記録した物)
+		const FCSDebugAutoPilotRecordEvent& ChecksumEvent = mPlayTimeline.mChecksumEvent;
+		const bool bFrameSec = (mPlayTimeline.mbChecksum && ChecksumEvent.mFrame == mPlayFrame && ChecksumEvent.mDeltaTime > 0.f);
+		mPlayRecordSec += bFrameSec ? ChecksumEvent.mDeltaTime : (1.0 / sRecordFrameRate);
+		++mPlayFrame;
+	}
+	if (EndSec > NowSec)
+	{
+		AccumulateResampleAxis(static_cast<float>(EndSec - NowSec));
+	}
+
+	//スティック
+	const float InvDeltaTime = (DeltaTime > 0.f) ? (1.f / DeltaTime) : 0.f;
+	for (int32 ControllerId = 0; ControllerId < mControllerList.Num(); ++ControllerId)
+	{
+		FControllerState& ControllerState = mControllerList[ControllerId];
+		APlayerController* PlayerControler = GetControllerPlayerController(ControllerId);
+		for (uint32 AxisBits = ControllerState.mResampleAxisBits; AxisBits != 0; AxisBits &= AxisBits - 1)
+		{
+			const int32 KeyIndex = FMath::CountTrailingZeros(AxisBits);
+			const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(KeyIndex);
+			const float AxisValue = ControllerState.mResampleAxisSec[KeyIndex] * InvDeltaTime;
+			ControllerState.mResampleAxisSec[KeyIndex] = 0.f;
+			if (PlayerControler)
 			{
-				//PlayerControler->InputAxis(*Key, InCommand.mAxisValue, InCommand.mDeltaTime, 1, true);
+				PlayerControler->InputAxis(GetKey(KeyId), AxisValue, DeltaTime, 1, true);
 			}
-			else
+			if (ControllerId == 0)
 			{
-				PlayerControler->InputKey(Key, EInputEvent::IE_Released, 1.f, true);
+				AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(KeyId, AxisValue));
 			}
 		}
+		ControllerState.mResampleAxisBits = 0;
 	}
 
-	mPlayFrame += 1;
+	//区間内で離したボタン(区間内で押してたら押してから)
+	for (const FCommandNode& InCommand : mResampleReleaseNodeList)
+	{
+		APlayerController* PlayerControler = GetControllerPlayerController(InCommand.mControllerId);
+		const FKey& Key = GetKey(static_cast<ECSDebugAutoPilotKey>(InCommand.mKeyId));
+		if (PlayerControler == nullptr
+			|| Key.IsAxis1D())
+		{
+			continue;
+		}
+		if (InCommand.mBeginFrame >= BeginFrame)
+		{
+			PlayerControler->InputKey(Key, EInputEvent::IE_Pressed, 1.f, true);
+		}
+		PlayerControler->InputKey(Key, EInputEvent::IE_Released, 1.f, true);
+	}
+
+	//押してるボタン
+	for (const FCommandNode& InCommand : mPlayTimeline.mActiveNodeList)
+	{
+		APlayerController* PlayerControler = GetControllerPlayerController(InCommand.mControllerId);
+		const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(InCommand.mKeyId);
+		const FKey& Key = GetKey(KeyId);
+		if (PlayerControler == nullptr
+			|| Key.IsAxis1D())
+		{
+			continue;
+		}
+		PlayerControler->InputKey(Key, (InCommand.mBeginFrame >= BeginFrame) ? EInputEvent::IE_Pressed : EInputEvent::IE_Repeat, 1.f, true);
+		if (InCommand.mControllerId == 0)
+		{
+			AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(KeyId, 1.f));
+		}
+	}
 
+	return HasPlayFrame();
+}
+
+/**
+ * @brief	まだ再生するフレームがあるか
+ *			記録中に落ちたファイルは終了フレームが無いので読めた所まで
+ */
+bool	UCSDebugAutoPilotModeRecord::HasPlayFrame()
+{
+	if (mCommand.mEndFrame == 0)
+	{
+		return (mPlayTimeline.mReader.PeekEvent() != nullptr);
+	}
 	return (mPlayFrame <= mCommand.mEndFrame);
 }
 
+/**
+ * @brief	時間基準の再生で 入力中のスティックの値×InSecを足し込む
+ */
+void	UCSDebugAutoPilotModeRecord::AccumulateResampleAxis(const float InSec)
+{
+	for (const FCommandNode& InCommand : mPlayTimeline.mActiveNodeList)
+	{
+		if (!mControllerList.IsValidIndex(InCommand.mControllerId)
+			|| !GetKey(static_cast<ECSDebugAutoPilotKey>(InCommand.mKeyId)).IsAxis1D())
+		{
+			continue;
+		}
+		FControllerState& ControllerState = mControllerList[InCommand.mControllerId];
+		ControllerState.mResampleAxisSec[InCommand.mKeyId] += InCommand.mAxisValue * InSec;
+		ControllerState.mResampleAxisBits |= (1u << InCommand.mKeyId);
+	}
+}
+
 /**
  * @brief	入力の記録
  */
@@ -304,8 +793,29 @@ bool UCSDebugAutoPilotModeRecord::UpdateInputRecord(float DeltaTime)
 		break;
 	case ECommandMode::EndRecord:
 	{
+		for (int32 ControllerId = 0; ControllerId < mControllerList.Num(); ++ControllerId)
+		{
+			FControllerState& ControllerState = mControllerList[ControllerId];
+			for (uint32 InputBits = ControllerState.mBeforeFramePad.mInputBits; InputBits != 0; InputBits &= InputBits - 1)
+			{
+				PushRecordEvent(static_cast<uint8>(ControllerId), static_cast<ECSDebugAutoPilotKey>(FMath::CountTrailingZeros(InputBits)), false, 0.f, 0.f);
+			}
+			ControllerState.mBeforeFramePad = FCSDebugAutoPilotPadSnapshot();
+		}
+		mRecordWriter.Finish(mCommand.mEndFrame);
+
+		//jsonが指定されてたら書き終わったバイナリを変換
 		const FString SavedPath = GetFilePath();
-		const bool bSave = FFileHelper::SaveStringToFile(mCommand.ToJson(), *SavedPath);
+		if (!FCSDebugAutoPilotRecordFile::IsBinaryPath(SavedPath))
+		{
+			const FString StreamPath = FPaths::ChangeExtension(SavedPath, TEXT("csrec"));
+			FCommandList CommandList;
+			if (FCSDebugAutoPilotRecordFile::LoadBinary(StreamPath, CommandList)
+				&& FCSDebugAutoPilotRecordFile::SaveJson(SavedPath, CommandList))
+			{
+				IFileManager::Get().Delete(*StreamPath);
+			}
+		}
 		SetMode(ECommandMode::Invalid);
 		break;
 	}
@@ -321,7 +831,13 @@ bool UCSDebugAutoPilotModeRecord::BeginInputRecord(float DeltaTime)
 {
 	APlayerController* PlayerControler = GetPlayerController();
 	mCommand.mList.Empty();
-	mBeforeFrameCommandList.Empty();
+	mCommand.mEndFrame = 0;
+
+	//画面分割等の時は他のローカルプレイヤーも(コントローラ番号は1バイトなので256人まで)
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	PrepareControllerList(CSDebugConfig->mAutoPilot_bRecordAllLocalPlayer ? MAX_uint8 + 1 : 1, false);
+	mCommand.mControllerNum = mControllerList.Num();
+
 	ACharacter* Player = Cast<ACharacter>(PlayerControler->GetPawn());
 	if (Player)
 	{
@@ -339,6 +855,18 @@ bool UCSDebugAutoPilotModeRecord::BeginInputRecord(float DeltaTime)
 		mCommand.mStartControllerPitch = PlayerControler->GetControlRotation().Pitch;
 	}
 
+	mKeyframeIntervalFrame = FMath::Max(FMath::RoundToInt(CSDebugConfig->mAutoPilot_KeyframeIntervalSec * sRecordFrameRate), 1);
+
+	//終わった入力から順次ファイルへ書き出すので 先に開いておく(jsonは最後に変換)
+	const FString StreamPath = FPaths::ChangeExtension(GetFilePath(), TEXT("csrec"));
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(StreamPath), true);
+	if (!mRecordWriter.Start(StreamPath, mCommand))
+	{
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot BeginRecord : failed to open %s"), *StreamPath);
+		SetMode(ECommandMode::Invalid);
+		return false;
+	}
+
 	mPlayFrame = 0;
 	SetMode(ECommandMode::Record);
 
@@ -346,87 +874,70 @@ bool UCSDebugAutoPilotModeRecord::BeginInputRecord(float DeltaTime)
 }
 /**
  * @brief	入力の記録
+ *			コントローラ毎に前フレームとの差分を取って 変化したキーだけ開始/終了を書き込みスレッドへ
  */
 bool UCSDebugAutoPilotModeRecord::RecordingInput(float DeltaTime)
 {
-	UCSDebugAutoPilotComponent* Parent = GetParent();
-	APlayerController* PlayerControler = GetPlayerController();
-	CommandPtrList ActiveCommandPtrList;
-
-	bool bAnyInput = false;
-	for (uint32 i = 0; i < static_cast<uint32>(ECSDebugAutoPilotKey::Num); ++i)
+	for (int32 ControllerId = 0; ControllerId < mControllerList.Num(); ++ControllerId)
 	{
-		const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(i);
-		const FKey Key = GetKey(KeyId);
-		FCommandNode Temp;
-		Temp.mBeginFrame = mPlayFrame;
-		Temp.mEndFrame = mPlayFrame;
-		Temp.mDeltaTime = DeltaTime;
-		Temp.mKeyId = i;
-		bool bInput = false;
-		if (Key.IsAxis1D())
-		//if (Key.IsFloatAxis())
+		FControllerState& ControllerState = mControllerList[ControllerId];
+		FCSDebugAutoPilotPadSnapshot Pad;
+		if (const APlayerController* PlayerController = ControllerState.mPlayerController.Get())
 		{
-			Temp.mAxisValue = PlayerControler->GetInputAnalogKeyState(Key);
-			const float* PadDeadZonePtr = GetPadDeadZoneMap().Find(Key);
-			if (PadDeadZonePtr == nullptr)
-			{
-				continue;
-			}
-			const float PadDeadZone = *PadDeadZonePtr;
-			if (Temp.mAxisValue > 0.f)
-			{
-				Temp.mAxisValue = Temp.mAxisValue * (1.0f - PadDeadZone) + PadDeadZone;
-			}
-			else if (Temp.mAxisValue < 0.f)
-			{
-				Temp.mAxisValue = Temp.mAxisValue * (1.0f - PadDeadZone) - PadDeadZone;
-			}
-			if (FMath::Abs(Temp.mAxisValue) > PadDeadZone)
-			{
-				bInput = true;
-				AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(KeyId, Temp.mAxisValue));
-			}
+			CapturePadSnapshot(*PlayerController, Pad);
 		}
-		else
+
+		const uint8 EventControllerId = static_cast<uint8>(ControllerId);
+		const uint32 ChangedBits = Pad.GetChangedBits(ControllerState.mBeforeFramePad);
+		if (ChangedBits != 0)
 		{
-			if (PlayerControler->IsInputKeyDown(Key))
+			//同フレームの開始より先に終了を書く
+			for (uint32 EndBits = ChangedBits & ControllerState.mBeforeFramePad.mInputBits; EndBits != 0; EndBits &= EndBits - 1)
 			{
-				bInput = true;
-				Temp.mInputEventId = EInputEvent::IE_Pressed;
-				AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(KeyId, 1.f));
+				PushRecordEvent(EventControllerId, static_cast<ECSDebugAutoPilotKey>(FMath::CountTrailingZeros(EndBits)), false, 0.f, 0.f);
+			}
+			for (uint32 BeginBits = ChangedBits & Pad.mInputBits; BeginBits != 0; BeginBits &= BeginBits - 1)
+			{
+				const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(FMath::CountTrailingZeros(BeginBits));
+				PushRecordEvent(EventControllerId, KeyId, true, Pad.GetValue(KeyId), DeltaTime);
 			}
 		}
 
-		if (bInput)
+		if (ControllerId == 0)
 		{
-			bAnyInput = true;
-
-			int32 InputIndex = INDEX_NONE;
-			for (int32 f = 0; f < mBeforeFrameCommandList.Num(); ++f)
-			{
-				if (mBeforeFrameCommandList[f]->IsSameInput(Temp))
-				{
-					InputIndex = mBeforeFrameCommandList[f]->mIndex;
-					break;
-				}
-			}
-			if (InputIndex == INDEX_NONE)
+			for (uint32 InputBits = Pad.mInputBits; InputBits != 0; InputBits &= InputBits - 1)
 			{
-				mCommand.mList.Add(Temp);
-				InputIndex = mCommand.mList.Num() - 1;
+				const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(FMath::CountTrailingZeros(InputBits));
+				AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(KeyId, Pad.GetValue(KeyId)));
 			}
-			FCommandNode* InputCommand = &mCommand.mList[InputIndex];
-			InputCommand->mEndFrame = mPlayFrame;
-			InputCommand->mIndex = InputIndex;
-			ActiveCommandPtrList.Add(InputCommand);
 		}
+		ControllerState.mBeforeFramePad = Pad;
 	}
 
-	++mPlayFrame;
+	//再生時にズレを検出するための状態チェックサム
+	FCSDebugAutoPilotRecordEvent ChecksumEvent;
+	ChecksumEvent.mFrame = mPlayFrame;
+	ChecksumEvent.mChecksum = CalcStateChecksum(ChecksumEvent.mCheckPos);
+	ChecksumEvent.mDeltaTime = DeltaTime;
+	ChecksumEvent.mbChecksum = true;
+	mRecordWriter.PushEvent(ChecksumEvent);
 
-	mBeforeFrameCommandList = ActiveCommandPtrList;
+	//シーク用のキーフレーム(0フレーム目から一定間隔 コントローラ分続けて書く)
+	if (mPlayFrame % mKeyframeIntervalFrame == 0)
+	{
+		for (int32 ControllerId = 0; ControllerId < mControllerList.Num(); ++ControllerId)
+		{
+			const FControllerState& ControllerState = mControllerList[ControllerId];
+			FCSDebugAutoPilotRecordEvent KeyframeEvent;
+			KeyframeEvent.mFrame = mPlayFrame;
+			KeyframeEvent.mControllerId = static_cast<uint8>(ControllerId);
+			KeyframeEvent.mKeyframe = MakeShared<FCSDebugAutoPilotRecordKeyframe, ESPMode::ThreadSafe>();
+			MakeKeyframe(*KeyframeEvent.mKeyframe, ControllerState.mPlayerController.Get(), ControllerState.mBeforeFramePad, DeltaTime, ControllerId == 0);
+			mRecordWriter.PushEvent(KeyframeEvent);
+		}
+	}
 
+	++mPlayFrame;
 	mCommand.mEndFrame = mPlayFrame;
 
 	//何故かWidgetの切り替えでPlayerInputが更新されなくなるので
@@ -439,6 +950,690 @@ bool UCSDebugAutoPilotModeRecord::RecordingInput(float DeltaTime)
 	return true;
 }
 
+/**
+ * @brief	記録中の入力の開始/終了を書き込みスレッドへ
+ */
+void	UCSDebugAutoPilotModeRecord::PushRecordEvent(const uint8 InControllerId, const ECSDebugAutoPilotKey InKey, const bool bInBegin, const float InAxisValue, const float InDeltaTime)
+{
+	FCSDebugAutoPilotRecordEvent Event;
+	Event.mFrame = mPlayFrame;
+	Event.mKeyId = static_cast<uint8>(InKey);
+	Event.mControllerId = InControllerId;
+	Event.mbBegin = bInBegin;
+	if (bInBegin)
+	{
+		Event.mAxisValue = InAxisValue;
+		Event.mDeltaTime = InDeltaTime;
+		Event.mInputEventId = static_cast<uint8>(EInputEvent::IE_Pressed);
+	}
+	mRecordWriter.PushEvent(Event);
+}
+
+/**
+ * @brief	現在の状態からキーフレームを作る
+ *			ユーザー登録の保存処理は1回だけ(0番のコントローラ)
+ */
+void	UCSDebugAutoPilotModeRecord::MakeKeyframe(FCSDebugAutoPilotRecordKeyframe& OutKeyframe, const APlayerController* InPlayerController, const FCSDebugAutoPilotPadSnapshot& InPad, const float InDeltaTime, const bool bInUserState)
+{
+	const APlayerController* PlayerControler = InPlayerController;
+	const APawn* Pawn = PlayerControler ? PlayerControler->GetPawn() : nullptr;
+	if (Pawn)
+	{
+		OutKeyframe.mPos = Pawn->GetActorLocation();
+		OutKeyframe.mRot = Pawn->GetActorRotation();
+		OutKeyframe.mVelocity = Pawn->GetVelocity();
+	}
+	if (PlayerControler)
+	{
+		OutKeyframe.mControlRot = PlayerControler->GetControlRotation();
+	}
+
+	OutKeyframe.mInputBits = InPad.mInputBits;
+	OutKeyframe.mInputValueList.Reset();
+	for (uint32 InputBits = InPad.mInputBits; InputBits != 0; InputBits &= InputBits - 1)
+	{
+		OutKeyframe.mInputValueList.Add(InPad.GetValue(static_cast<ECSDebugAutoPilotKey>(FMath::CountTrailingZeros(InputBits))));
+	}
+	OutKeyframe.mDeltaTime = InDeltaTime;
+
+	const FCSDebugAutoPilotKeyframeDelegate& KeyframeStateDelegate = GetParent()->GetKeyframeStateDelegate();
+	if (bInUserState
+		&& KeyframeStateDelegate.IsBound())
+	{
+		FMemoryWriter Writer(OutKeyframe.mUserState);
+		KeyframeStateDelegate.Execute(Writer);
+	}
+}
+
+/**
+ * @brief	指定フレーム以前で一番近いキーフレームへ飛ぶ
+ *			まだ読んでない所はキーフレームの位置だけ拾いながら読み進める
+ *			進める時に今より前のキーフレームしか無ければ何もしない
+ */
+bool	UCSDebugAutoPilotModeRecord::SeekPlayFrame(const uint32 InFrame, const bool bInForward)
+{
+	FCSDebugAutoPilotRecordReader& Reader = mPlayTimeline.mReader;
+	const int64 SavedChunkPos = Reader.GetChunkPos();
+	const int32 SavedEventCursor = Reader.GetEventCursor();
+	if (mPlayTimeline.mKeyframeList.Num() == 0
+		|| mPlayTimeline.mKeyframeList.Last().mFrame < InFrame)
+	{
+		mPlayTimeline.ScanKeyframe(InFrame);
+	}
+
+	const FPlayTimeline::FKeyframeIndex* KeyframeIndex = mPlayTimeline.FindKeyframe(InFrame);
+	if (KeyframeIndex == nullptr
+		|| (bInForward && KeyframeIndex->mFrame < mPlayFrame))
+	{
+		Reader.Seek(SavedChunkPos, SavedEventCursor);
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Seek %s : no keyframe for frame %u"), *mFileName, InFrame);
+		return false;
+	}
+
+	const uint32 BeforeFrame = mPlayFrame;
+	ApplyKeyframe(*KeyframeIndex);
+	//シーク前の照合結果は別の流れの物なので捨てて キーフレームの次のチェックサムから照合し直す
+	mChecksumResult = FChecksumResult();
+	mbSeekChecksumLog = true;
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Seek %s : %u -> %u (request %u)"), *mFileName, BeforeFrame, mPlayFrame, InFrame);
+	return true;
+}
+
+/**
+ * @brief	キーフレームの状態を復元して その次のフレームから再生を続ける
+ *			キーフレームはmFrameのPostProcessInput後の状態で 読み込み位置もmFrameのイベントの後なので
+ *			再生はmFrame+1から 押しっぱなしの入力はmFrameから押してた扱い(押した瞬間を再生し直さない)
+ */
+void	UCSDebugAutoPilotModeRecord::ApplyKeyframe(const FPlayTimeline::FKeyframeIndex& InIndex)
+{
+	const TArray<FCSDebugAutoPilotRecordKeyframePtr, TInlineAllocator<1>> KeyframeList = InIndex.mControllerKeyframeList;
+	const uint32 KeyframeFrame = InIndex.mFrame;
+	const uint32 ResumeFrame = KeyframeFrame + 1;
+
+	mPlayTimeline.mReader.Seek(InIndex.mChunkPos, InIndex.mEventCursor);
+	mPlayTimeline.mActiveNodeList.Reset();
+	mPlayTimeline.mReleaseNodeList.Reset();
+	mPlayTimeline.mbChecksum = false;
+
+	for (int32 ControllerId = 0; ControllerId < KeyframeList.Num(); ++ControllerId)
+	{
+		APlayerController* PlayerControler = GetControllerPlayerController(ControllerId);
+		if (!KeyframeList[ControllerId].IsValid()
+			|| PlayerControler == nullptr)
+		{
+			continue;
+		}
+		const FCSDebugAutoPilotRecordKeyframe& Keyframe = *KeyframeList[ControllerId];
+
+		//押しっぱなしだった入力はキーフレームのフレームから押してた扱いで続ける
+		int32 InputValueIndex = 0;
+		for (uint32 InputBits = Keyframe.mInputBits; InputBits != 0; InputBits &= InputBits - 1)
+		{
+			FCommandNode& Node = mPlayTimeline.mActiveNodeList.AddDefaulted_GetRef();
+			Node.mBeginFrame = KeyframeFrame;
+			Node.mEndFrame = MAX_uint32;
+			Node.mAxisValue = Keyframe.mInputValueList.IsValidIndex(InputValueIndex) ? Keyframe.mInputValueList[InputValueIndex] : 1.f;
+			Node.mDeltaTime = Keyframe.mDeltaTime;
+			Node.mKeyId = FMath::CountTrailingZeros(InputBits);
+			Node.mInputEventId = static_cast<uint32>(EInputEvent::IE_Pressed);
+			Node.mControllerId = ControllerId;
+			++InputValueIndex;
+		}
+
+		PlayerControler->FlushPressedKeys();
+		if (APawn* Pawn = PlayerControler->GetPawn())
+		{
+			Pawn->SetActorLocationAndRotation(Keyframe.mPos, Keyframe.mRot, false, nullptr, ETeleportType::TeleportPhysics);
+			if (UPawnMovementComponent* MovementComponent = Pawn->GetMovementComponent())
+			{
+				MovementComponent->Velocity = Keyframe.mVelocity;
+				MovementComponent->UpdateComponentVelocity();
+			}
+		}
+		PlayerControler->SetControlRotation(Keyframe.mControlRot);
+
+		const FCSDebugAutoPilotKeyframeDelegate& KeyframeStateDelegate = GetParent()->GetKeyframeStateDelegate();
+		if (KeyframeStateDelegate.IsBound()
+			&& Keyframe.mUserState.Num() > 0)
+		{
+			FMemoryReader Reader(Keyframe.mUserState);
+			KeyframeStateDelegate.Execute(Reader);
+		}
+	}
+
+	mPlayFrame = ResumeFrame;
+	mPlayRecordSec = mPlaySimSec;
+}
+
+/**
+ * @brief	記録/再生するコントローラ一覧を作る
+ *			0番は自分 1番以降はローカルプレイヤー順でInControllerNumまで
+ *			bInCreatePlayerなら足りない分のローカルプレイヤーを作る(再生時)
+ *			戻り値は1番以降が全員Pawnを持ってるか
+ */
+bool	UCSDebugAutoPilotModeRecord::PrepareControllerList(const int32 InControllerNum, const bool bInCreatePlayer)
+{
+	APlayerController* OwnPlayerController = GetPlayerController();
+	mControllerList.Reset();
+	mControllerList.AddDefaulted_GetRef().mPlayerController = OwnPlayerController;
+
+	UWorld* World = GetParent()->GetWorld();
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	if (GameInstance)
+	{
+		for (const ULocalPlayer* LocalPlayer : GameInstance->GetLocalPlayers())
+		{
+			if (mControllerList.Num() >= InControllerNum)
+			{
+				break;
+			}
+			APlayerController* PlayerController = LocalPlayer ? LocalPlayer->GetPlayerController(World) : nullptr;
+			if (PlayerController
+				&& PlayerController != OwnPlayerController)
+			{
+				mControllerList.AddDefaulted_GetRef().mPlayerController = PlayerController;
+			}
+		}
+	}
+
+	//入力はPlayerInput経由で入れるのでAIではなくローカルプレイヤーを足す
+	if (bInCreatePlayer
+		&& World)
+	{
+		while (mControllerList.Num() < InControllerNum)
+		{
+			APlayerController* PlayerController = UGameplayStatics::CreatePlayer(World, -1, true);
+			if (PlayerController == nullptr)
+			{
+				UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot PlayRecord %s : failed to create player (%d/%d)"), *mFileName, mControllerList.Num(), InControllerNum);
+				break;
+			}
+			mControllerList.AddDefaulted_GetRef().mPlayerController = PlayerController;
+		}
+	}
+
+	for (int32 ControllerId = 1; ControllerId < mControllerList.Num(); ++ControllerId)
+	{
+		const APlayerController* PlayerController = mControllerList[ControllerId].mPlayerController.Get();
+		if (PlayerController == nullptr
+			|| PlayerController->GetPawn() == nullptr)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief	コントローラ番号のPlayerController(一覧を作る前でも0番は自分)
+ */
+APlayerController*	UCSDebugAutoPilotModeRecord::GetControllerPlayerController(const int32 InControllerId) const
+{
+	if (InControllerId == 0)
+	{
+		return GetPlayerController();
+	}
+	return mControllerList.IsValidIndex(InControllerId) ? mControllerList[InControllerId].mPlayerController.Get() : nullptr;
+}
+
+/**
+ * @brief	Pawnの位置,回転,速度とユーザー登録値からチェックサムを計算
+ *			複数コントローラなら全員のPawnを混ぜる(OutPosは0番)
+ *			計算コストも計測しておく
+ */
+uint32	UCSDebugAutoPilotModeRecord::CalcStateChecksum(FVector& OutPos)
+{
+	const double BeginSec = FPlatformTime::Seconds();
+
+	OutPos = FVector::ZeroVector;
+	uint32 Checksum = 0;
+	const int32 ControllerNum = FMath::Max(mControllerList.Num(), 1);
+	for (int32 ControllerId = 0; ControllerId < ControllerNum; ++ControllerId)
+	{
+		float StateList[9] = {};
+		const APlayerController* PlayerControler = GetControllerPlayerController(ControllerId);
+		const APawn* Pawn = PlayerControler ? PlayerControler->GetPawn() : nullptr;
+		if (Pawn)
+		{
+			const FVector Pos = Pawn->GetActorLocation();
+			const FRotator Rot = Pawn->GetActorRotation();
+			const FVector Velocity = Pawn->GetVelocity();
+			StateList[0] = Pos.X;
+			StateList[1] = Pos.Y;
+			StateList[2] = Pos.Z;
+			StateList[3] = Rot.Pitch;
+			StateList[4] = Rot.Yaw;
+			StateList[5] = Rot.Roll;
+			StateList[6] = Velocity.X;
+			StateList[7] = Velocity.Y;
+			StateList[8] = Velocity.Z;
+			if (ControllerId == 0)
+			{
+				OutPos = Pos;
+			}
+		}
+		const uint32 StateChecksum = FCrc::MemCrc32(StateList, sizeof(StateList));
+		Checksum = (ControllerId == 0) ? StateChecksum : HashCombine(Checksum, StateChecksum);
+	}
+	for (const FCSDebugAutoPilotChecksumDelegate& Delegate : GetParent()->GetChecksumDelegateList())
+	{
+		if (Delegate.IsBound())
+		{
+			Checksum = HashCombine(Checksum, Delegate.Execute());
+		}
+	}
+
+	const double CostSec = FPlatformTime::Seconds() - BeginSec;
+	mChecksumCostSec = (mChecksumCostSec > 0.0) ? FMath::Lerp(mChecksumCostSec, CostSec, 0.05) : CostSec;
+	return Checksum;
+}
+
+/**
+ * @brief	再生中の状態を記録時のチェックサムと照合
+ *			最初にズレたフレームと位置の差を残す
+ */
+void	UCSDebugAutoPilotModeRecord::VerifyPlayChecksum()
+{
+	//時間基準の再生はフレームの刻みが記録時と違うので照合しない
+	if (mbPlayTimeBased)
+	{
+		mPlayTimeline.mbChecksum = false;
+	}
+	if (mPlayTimeline.mbChecksum)
+	{
+		mPlayTimeline.mbChecksum = false;
+		const FCSDebugAutoPilotRecordEvent& RecordEvent = mPlayTimeline.mChecksumEvent;
+		FVector Pos;
+		mChecksumResult.mLastChecksum = CalcStateChecksum(Pos);
+		++mChecksumResult.mCheckNum;
+		if (mChecksumResult.mLastChecksum != RecordEvent.mChecksum)
+		{
+			if (!mChecksumResult.IsDiverged())
+			{
+				mChecksumResult.mFirstDivergeFrame = RecordEvent.mFrame;
+				mChecksumResult.mFirstDivergeDistance = FVector::Dist(Pos, RecordEvent.mCheckPos);
+				UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot Checksum diverged %s : Frame %u PosDiff %.2fcm"),
+					*mFileName, RecordEvent.mFrame, mChecksumResult.mFirstDivergeDistance);
+			}
+			++mChecksumResult.mDivergeNum;
+		}
+		if (mbSeekChecksumLog)
+		{
+			mbSeekChecksumLog = false;
+			UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Seek %s : Checksum after seek Frame %u %s"),
+				*mFileName, RecordEvent.mFrame, (mChecksumResult.mLastChecksum == RecordEvent.mChecksum) ? TEXT("OK") : TEXT("Diverged"));
+		}
+	}
+
+	if (mPlayInputRecordState == EPlayInputRecordState::Finish
+		&& !mChecksumResult.mbReported)
+	{
+		mChecksumResult.mbReported = true;
+		UE_LOG(CSDebugLog, Log, TEXT("AutoPilot Checksum %s : Check %u Diverge %u FirstFrame %d Cost %.3fus"),
+			*mFileName, mChecksumResult.mCheckNum, mChecksumResult.mDivergeNum,
+			mChecksumResult.IsDiverged() ? static_cast<int32>(mChecksumResult.mFirstDivergeFrame) : INDEX_NONE,
+			mChecksumCostSec * 1000000.0);
+	}
+}
+
+/**
+ * @brief	再生フレーム毎の負荷計測
+ *			再生が終わったらTelemetry/にcsvで書き出す
+ */
+void	UCSDebugAutoPilotModeRecord::UpdateTelemetry()
+{
+	if (!mTelemetry.IsActive()
+		|| mPlayFrame == 0)
+	{
+		return;
+	}
+
+	//この時点でmPlayFrameは次のフレームを指してる
+	mTelemetry.Capture(mPlayFrame - 1);
+	if (mPlayInputRecordState != EPlayInputRecordState::Play)
+	{
+		mTelemetry.End();
+		ExportTelemetry(FPaths::GetBaseFilename(mFileName) + TEXT(".csv"));
+	}
+}
+
+/**
+ * @brief	再生速度の倍率(進めたゲーム時間/実時間 早送り時の確認用)
+ */
+float	UCSDebugAutoPilotModeRecord::GetPlaySpeedRate() const
+{
+	const double WallSec = (mPlayInputRecordState == EPlayInputRecordState::Play) ? (FPlatformTime::Seconds() - mPlayBeginSec) : mPlayWallSec;
+	return (WallSec > 0.0) ? static_cast<float>(mPlaySimSec / WallSec) : 0.f;
+}
+
+/**
+ * @brief	負荷計測の書き出し
+ */
+bool	UCSDebugAutoPilotModeRecord::ExportTelemetry(const FString& InFileName) const
+{
+	const FString SavedPath = FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/Telemetry/") + InFileName;
+	if (!mTelemetry.Export(SavedPath))
+	{
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot ExportTelemetry : failed to save %s"), *SavedPath);
+		return false;
+	}
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot ExportTelemetry %s : %d frame"), *SavedPath, mTelemetry.GetFrameList().GetListNum());
+	return true;
+}
+
+/**
+ * @brief	再生用タイムラインを先頭に戻す
+ */
+void	UCSDebugAutoPilotModeRecord::FPlayTimeline::Reset()
+{
+	mReader.Close();
+	mActiveNodeList.Reset();
+	mReleaseNodeList.Reset();
+	mKeyframeList.Reset();
+	mbChecksum = false;
+}
+
+/**
+ * @brief	指定フレームまでのイベントを処理
+ */
+void	UCSDebugAutoPilotModeRecord::FPlayTimeline::Advance(const uint32 InFrame)
+{
+	mReleaseNodeList.Reset();
+	while (const FCSDebugAutoPilotRecordEvent* Event = mReader.PeekEvent())
+	{
+		if (Event->mFrame > InFrame)
+		{
+			break;
+		}
+
+		if (Event->mKeyframe.IsValid())
+		{
+			//読み込み位置はキーフレームの直後を覚える
+			const uint32 KeyframeFrame = Event->mFrame;
+			const uint8 KeyframeControllerId = Event->mControllerId;
+			const FCSDebugAutoPilotRecordKeyframePtr Keyframe = Event->mKeyframe;
+			mReader.PopEvent();
+			AddKeyframe(KeyframeFrame, KeyframeControllerId, Keyframe);
+			continue;
+		}
+
+		if (Event->mbChecksum)
+		{
+			mChecksumEvent = *Event;
+			mbChecksum = true;
+		}
+		else if (Event->mbBegin)
+		{
+			FCommandNode& Node = mActiveNodeList.AddDefaulted_GetRef();
+			Node.mBeginFrame = Event->mFrame;
+			Node.mEndFrame = MAX_uint32;
+			Node.mAxisValue = Event->mAxisValue;
+			Node.mDeltaTime = Event->mDeltaTime;
+			Node.mKeyId = Event->mKeyId;
+			Node.mInputEventId = Event->mInputEventId;
+			Node.mControllerId = Event->mControllerId;
+		}
+		else
+		{
+			for (int32 i = 0; i < mActiveNodeList.Num(); ++i)
+			{
+				if (mActiveNodeList[i].mKeyId == Event->mKeyId
+					&& mActiveNodeList[i].mControllerId == Event->mControllerId)
+				{
+					mReleaseNodeList.Add(mActiveNodeList[i]);
+					mActiveNodeList.RemoveAt(i, 1, false);
+					break;
+				}
+			}
+		}
+		mReader.PopEvent();
+	}
+}
+
+/**
+ * @brief	キーフレームと現在の読み込み位置を登録(シークで戻った後の再登録は無視)
+ *			同じフレームの2番目以降のコントローラ分は同じ所へ足して 読み込み位置をその直後にする
+ */
+void	UCSDebugAutoPilotModeRecord::FPlayTimeline::AddKeyframe(const uint32 InFrame, const uint8 InControllerId, const FCSDebugAutoPilotRecordKeyframePtr& InKeyframe)
+{
+	if (mKeyframeList.Num() > 0
+		&& mKeyframeList.Last().mFrame > InFrame)
+	{
+		return;
+	}
+	if (mKeyframeList.Num() == 0
+		|| mKeyframeList.Last().mFrame < InFrame)
+	{
+		mKeyframeList.AddDefaulted_GetRef().mFrame = InFrame;
+	}
+	FKeyframeIndex& KeyframeIndex = mKeyframeList.Last();
+	KeyframeIndex.mChunkPos = mReader.GetChunkPos();
+	KeyframeIndex.mEventCursor = mReader.GetEventCursor();
+	if (KeyframeIndex.mControllerKeyframeList.Num() <= InControllerId)
+	{
+		KeyframeIndex.mControllerKeyframeList.SetNum(InControllerId + 1);
+	}
+	KeyframeIndex.mControllerKeyframeList[InControllerId] = InKeyframe;
+}
+
+/**
+ * @brief	指定フレーム以前で一番近いキーフレーム
+ */
+const UCSDebugAutoPilotModeRecord::FPlayTimeline::FKeyframeIndex*	UCSDebugAutoPilotModeRecord::FPlayTimeline::FindKeyframe(const uint32 InFrame) const
+{
+	for (int32 i = mKeyframeList.Num() - 1; i >= 0; --i)
+	{
+		if (mKeyframeList[i].mFrame <= InFrame)
+		{
+			return &mKeyframeList[i];
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * @brief	入力は処理せずに指定フレームを越えるキーフレームまで読み進める
+ *			越えたフレームのキーフレームはコントローラ分全部読む
+ */
+void	UCSDebugAutoPilotModeRecord::FPlayTimeline::ScanKeyframe(const uint32 InFrame)
+{
+	bool bFound = false;
+	while (const FCSDebugAutoPilotRecordEvent* Event = mReader.PeekEvent())
+	{
+		const uint32 EventFrame = Event->mFrame;
+		const uint8 EventControllerId = Event->mControllerId;
+		const FCSDebugAutoPilotRecordKeyframePtr Keyframe = Event->mKeyframe;
+		if (bFound
+			&& (!Keyframe.IsValid() || EventFrame != mKeyframeList.Last().mFrame))
+		{
+			break;
+		}
+		mReader.PopEvent();
+		if (Keyframe.IsValid())
+		{
+			AddKeyframe(EventFrame, EventControllerId, Keyframe);
+			bFound = (EventFrame > InFrame);
+		}
+	}
+}
+
+/**
+ * @brief	合成した入力記録で再生処理の負荷を計測
+ *			旧来の全コマンド走査とタイムラインの1フレーム当たりのコストを比較してログ出力
+ */
+void	UCSDebugAutoPilotModeRecord::sBenchmarkPlayTimeline(const int32 InNodeNum)
+{
+	FRandomStream RandomStream(InNodeNum);
+	TArray<FCommandNode> NodeList;
+	NodeList.Reserve(InNodeNum);
+	uint32 BeginFrame = 0;
+	uint32 EndFrame = 0;
+	for (int32 i = 0; i < InNodeNum; ++i)
+	{
+		BeginFrame += RandomStream.RandRange(0, 2);
+		FCommandNode Node;
+		Node.mBeginFrame = BeginFrame;
+		Node.mEndFrame = BeginFrame + RandomStream.RandRange(0, 60);
+		Node.mKeyId = RandomStream.RandRange(1, static_cast<int32>(ECSDebugAutoPilotKey::Num) - 1);
+		Node.mAxisValue = 1.f;
+		Node.mIndex = i;
+		NodeList.Add(Node);
+		EndFrame = FMath::Max(EndFrame, Node.mEndFrame);
+	}
+	const uint32 FrameNum = EndFrame + 2;
+
+	uint64 LinearActiveNum = 0;
+	const double LinearBeginSec = FPlatformTime::Seconds();
+	for (uint32 Frame = 0; Frame < FrameNum; ++Frame)
+	{
+		for (const FCommandNode& Node : NodeList)
+		{
+			if (Frame >= Node.mBeginFrame
+				&& Frame <= Node.mEndFrame)
+			{
+				++LinearActiveNum;
+			}
+			else if (Node.mEndFrame + 1 == Frame)
+			{
+				++LinearActiveNum;
+			}
+		}
+	}
+	const double LinearSec = FPlatformTime::Seconds() - LinearBeginSec;
+
+	FPlayTimeline Timeline;
+	const double SetupBeginSec = FPlatformTime::Seconds();
+	TArray<FCSDebugAutoPilotRecordEvent> EventList;
+	FCSDebugAutoPilotRecordFile::MakeEventList(EventList, NodeList);
+	Timeline.mReader.OpenMemory(MoveTemp(EventList), FCommandList());
+	const double SetupSec = FPlatformTime::Seconds() - SetupBeginSec;
+
+	uint64 TimelineActiveNum = 0;
+	int32 MaxActiveNum = 0;
+	const double TimelineBeginSec = FPlatformTime::Seconds();
+	for (uint32 Frame = 0; Frame < FrameNum; ++Frame)
+	{
+		Timeline.Advance(Frame);
+		TimelineActiveNum += Timeline.mActiveNodeList.Num() + Timeline.mReleaseNodeList.Num();
+		MaxActiveNum = FMath::Max(MaxActiveNum, Timeline.mActiveNodeList.Num());
+	}
+	const double TimelineSec = FPlatformTime::Seconds() - TimelineBeginSec;
+
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot PlaybackBenchmark Node=%d Frame=%u MaxActive=%d"), InNodeNum, FrameNum, MaxActiveNum);
+	UE_LOG(CSDebugLog, Log, TEXT("  Linear   : %.3f us/frame (%llu)"), LinearSec * 1000000.0 / FrameNum, LinearActiveNum);
+	UE_LOG(CSDebugLog, Log, TEXT("  Timeline : %.3f us/frame (%llu) Setup %.3f ms"), TimelineSec * 1000000.0 / FrameNum, TimelineActiveNum, SetupSec * 1000.0);
+}
+
+/**
+ * @brief	入力記録ファイルをチャンク単位で読みながら最後まで再生処理だけ回した時間(秒 失敗したら負)
+ *			パッドへは入れないのでプレイヤー無しで計れる
+ */
+double	UCSDebugAutoPilotModeRecord::sMeasurePlayFile(const FString& InPath, uint32& OutFrameNum, int32& OutMaxActiveNum, SIZE_T& OutReaderPeakSize)
+{
+	OutFrameNum = 0;
+	OutMaxActiveNum = 0;
+	OutReaderPeakSize = 0;
+	FPlayTimeline Timeline;
+	const double BeginSec = FPlatformTime::Seconds();
+	if (!Timeline.mReader.Open(InPath))
+	{
+		return -1.0;
+	}
+	const uint32 FrameNum = Timeline.mReader.GetHeader().mEndFrame + 1;
+	for (uint32 Frame = 0; Frame < FrameNum; ++Frame)
+	{
+		Timeline.Advance(Frame);
+		OutMaxActiveNum = FMath::Max(OutMaxActiveNum, Timeline.mActiveNodeList.Num());
+		OutReaderPeakSize = FMath::Max(OutReaderPeakSize, Timeline.mReader.GetAllocatedSize());
+	}
+	OutFrameNum = FrameNum;
+	return FPlatformTime::Seconds() - BeginSec;
+}
+
+/**
+ * @brief	入力記録の1フレーム分のコストを計測
+ *			以前のTMap引き+前フレームのコマンド線形探索と スナップショット差分を同じ入力状態で比較
+ */
+void	UCSDebugAutoPilotModeRecord::BenchmarkRecordCapture(const int32 InFrameNum)
+{
+	const APlayerController* PlayerControler = GetPlayerController();
+	if (PlayerControler == nullptr)
+	{
+		return;
+	}
+
+	TMap<ECSDebugAutoPilotKey, FKey> KeyMap;
+	TMap<FKey, float> PadDeadZoneMap;
+	for (uint32 i = 1; i < static_cast<uint32>(ECSDebugAutoPilotKey::Num); ++i)
+	{
+		const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(i);
+		KeyMap.Add(KeyId, GetKey(KeyId));
+		if (GetPadDeadZone(KeyId) >= 0.f)
+		{
+			PadDeadZoneMap.Add(GetKey(KeyId), GetPadDeadZone(KeyId));
+		}
+	}
+
+	uint64 LegacyInputNum = 0;
+	TArray<FCommandNode> BeforeFrameCommandList;
+	TArray<FCommandNode> ActiveCommandList;
+	const double LegacyBeginSec = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < InFrameNum; ++Frame)
+	{
+		ActiveCommandList.Reset();
+		for (uint32 i = 0; i < static_cast<uint32>(ECSDebugAutoPilotKey::Num); ++i)
+		{
+			const FKey* KeyPtr = KeyMap.Find(static_cast<ECSDebugAutoPilotKey>(i));
+			const FKey Key = KeyPtr ? *KeyPtr : FKey();
+			FCommandNode Temp;
+			Temp.mBeginFrame = Frame;
+			Temp.mKeyId = i;
+			bool bInput = false;
+			if (Key.IsAxis1D())
+			{
+				Temp.mAxisValue = PlayerControler->GetInputAnalogKeyState(Key);
+				const float* PadDeadZonePtr = PadDeadZoneMap.Find(Key);
+				if (PadDeadZonePtr == nullptr)
+				{
+					continue;
+				}
+				bInput = (FMath::Abs(Temp.mAxisValue) > *PadDeadZonePtr);
+			}
+			else
+			{
+				bInput = PlayerControler->IsInputKeyDown(Key);
+			}
+			if (bInput)
+			{
+				const FCommandNode* BeforeCommand = BeforeFrameCommandList.FindByPredicate([&Temp](const FCommandNode& InNode)
+				{
+					return InNode.IsSameInput(Temp);
+				});
+				ActiveCommandList.Add(BeforeCommand ? *BeforeCommand : Temp);
+				++LegacyInputNum;
+			}
+		}
+		Swap(BeforeFrameCommandList, ActiveCommandList);
+	}
+	const double LegacySec = FPlatformTime::Seconds() - LegacyBeginSec;
+
+	uint64 SnapshotChangedNum = 0;
+	FCSDebugAutoPilotPadSnapshot BeforePad;
+	const double SnapshotBeginSec = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < InFrameNum; ++Frame)
+	{
+		FCSDebugAutoPilotPadSnapshot Pad;
+		CapturePadSnapshot(Pad);
+		SnapshotChangedNum += FMath::CountBits(Pad.GetChangedBits(BeforePad));
+		BeforePad = Pad;
+	}
+	const double SnapshotSec = FPlatformTime::Seconds() - SnapshotBeginSec;
+
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot RecordCaptureBenchmark Frame=%d"), InFrameNum);
+	UE_LOG(CSDebugLog, Log, TEXT("  Legacy   : %.3f us/frame (input %llu)"), LegacySec * 1000000.0 / InFrameNum, LegacyInputNum);
+	UE_LOG(CSDebugLog, Log, TEXT("  Snapshot : %.3f us/frame (changed %llu)"), SnapshotSec * 1000000.0 / InFrameNum, SnapshotChangedNum);
+}
+
 #if 0
 /**
  * @brief	デバッグ選択時のデバッグ情報
@@ -576,7 +1771,9 @@ void	UCSDebugAutoPilotModeRecord::DebugUpdateSelectInfo_PlayKey(UDebugSelectComp
 		--PlayFrame;
 	}
 
-	for (const FCommandNode& InCommand : mCommand.mList)
+	//再生中はストリーム読み込みでmListを持たないのでタイムライン側を見る
+	const TArray<FCommandNode>& NodeList = (mMode == ECommandMode::PlayInputRecord) ? mPlayTimeline.mActiveNodeList : mCommand.mList;
+	for (const FCommandNode& InCommand : NodeList)
 	{
 		if (PlayFrame >= InCommand.mBeginFrame
 			&& PlayFrame <= InCommand.mEndFrame)
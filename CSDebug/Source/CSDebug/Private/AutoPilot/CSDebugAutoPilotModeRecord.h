@@ -1,7 +1,7 @@
 // Copyright 2021 SensyuGames.
 /**
  * @file CSDebugAutoPilotModeRecord.h
- * @brief  pbh͂ۑ,Đ郂[h
+ * @brief 自動入力 パッド入力を保存,再生するモード
  * @author SensyuGames
  * @date 2021/12/28
  */
@@ -9,6 +9,10 @@
 
 #include "CoreMinimal.h"
 #include "AutoPilot/CSDebugAutoPilotModeBase.h"
+#include "AutoPilot/CSDebugAutoPilotRecordFile.h"
+#include "AutoPilot/CSDebugAutoPilotTelemetry.h"
+#include "ScreenWindow/CSDebug_ScreenWindowText.h"
+#include "Async/Future.h"
 #include "Serialization/JsonSerializerMacros.h"
 #include "InputCore/Classes/InputCoreTypes.h"
 #include "CSDebugAutoPilotModeRecord.generated.h"
@@ -21,7 +25,7 @@ class CSDEBUG_API UCSDebugAutoPilotModeRecord : public UCSDebugAutoPilotModeBase
 	GENERATED_BODY()
 
 	/* ------------------------------------------------------------
-		!샂[h
+		!自動操作モード
 	------------------------------------------------------------ */
 	enum class ECommandMode : uint8
 	{
@@ -33,7 +37,7 @@ class CSDEBUG_API UCSDebugAutoPilotModeRecord : public UCSDebugAutoPilotModeBase
 		EndRecord,
 	};
 	/* ------------------------------------------------------------
-		!͋L^[h̏
+		!入力記録モード時の状態
 	------------------------------------------------------------ */
 	enum class EPlayInputRecordState : uint8
 	{
@@ -43,71 +47,84 @@ class CSDEBUG_API UCSDebugAutoPilotModeRecord : public UCSDebugAutoPilotModeBase
 		Play,
 		Finish,
 	};
+	typedef FCSDebugAutoPilotCommandNode	FCommandNode;
+	typedef FCSDebugAutoPilotCommandList	FCommandList;
 	/* ------------------------------------------------------------
-	   !쎞̃R}hP
+	   !再生用タイムライン
+	   開始/終了イベントをフレーム順に並べてカーソルで進めるので
+	   1フレームの処理負荷は入力中のコマンド数にだけ依存する
 	------------------------------------------------------------ */
-	struct FCommandNode : public FJsonSerializable
+	struct FPlayTimeline
 	{
-		BEGIN_JSON_SERIALIZER
-			JSON_SERIALIZE("mBeginFrame", mBeginFrame);
-		JSON_SERIALIZE("mEndFrame", mEndFrame);
-		JSON_SERIALIZE("mAxisValue", mAxisValue);
-		JSON_SERIALIZE("mDeltaTime", mDeltaTime);
-		JSON_SERIALIZE("mKeyId", mKeyId);
-		JSON_SERIALIZE("mInputEventId", mInputEventId);
-		JSON_SERIALIZE("mIndex", mIndex);
-		END_JSON_SERIALIZER
-
-			uint32	mBeginFrame = 0;
-		uint32	mEndFrame = 0;
-		float	mAxisValue = 0.f;
-		float	mDeltaTime = 0.f;
-		uint32	mKeyId = 0;
-		uint32	mInputEventId = 0;
-		int32	mIndex = INDEX_NONE;//CommandPtrListmListIndex擾邽߂ɁBBB
-
-		bool	IsSameInput(const FCommandNode& InCommand) const
+		/* ------------------------------------------------------------
+		   !読んだキーフレームとその直後の読み込み位置
+		   同じフレームのキーフレームはコントローラ分まとめる
+		------------------------------------------------------------ */
+		struct FKeyframeIndex
 		{
-			return (mKeyId == InCommand.mKeyId
-				&& mInputEventId == InCommand.mInputEventId
-				&& mAxisValue == InCommand.mAxisValue);
-		}
+			uint32	mFrame = 0;
+			int64	mChunkPos = 0;
+			int32	mEventCursor = 0;
+			TArray<FCSDebugAutoPilotRecordKeyframePtr, TInlineAllocator<1>>	mControllerKeyframeList;//コントローラ番号で引く
+		};
+
+		void	Reset();
+		void	Advance(const uint32 InFrame);
+		bool	IsEnd() { return mActiveNodeList.Num() == 0 && mReader.PeekEvent() == nullptr; }
+		void	AddKeyframe(const uint32 InFrame, const uint8 InControllerId, const FCSDebugAutoPilotRecordKeyframePtr& InKeyframe);
+		const FKeyframeIndex*	FindKeyframe(const uint32 InFrame) const;
+		void	ScanKeyframe(const uint32 InFrame);
+
+		FCSDebugAutoPilotRecordReader	mReader;//ファイルならチャンク単位で読み進める
+		TArray<FKeyframeIndex>	mKeyframeList;//フレーム順
+		TArray<FCommandNode>	mActiveNodeList;//入力中のコマンド
+		TArray<FCommandNode>	mReleaseNodeList;//このフレームで離したコマンド
+		FCSDebugAutoPilotRecordEvent	mChecksumEvent;//このフレームの記録時チェックサム
+		bool	mbChecksum = false;
 	};
 	/* ------------------------------------------------------------
-	   !쎞̃R}hXg
+	   !非同期ロードの結果
+	   ワーカースレッドで開いたReaderと拾ったキーフレームをゲームスレッドへそのまま渡す
 	------------------------------------------------------------ */
-	struct FCommandList : public FJsonSerializable
+	struct FPlayLoadResult
 	{
-		BEGIN_JSON_SERIALIZER
-			JSON_SERIALIZE_ARRAY_SERIALIZABLE("mCommandList", mList, FCommandNode);
-		JSON_SERIALIZE("mStartPosX", mStartPosX);
-		JSON_SERIALIZE("mStartPosY", mStartPosY);
-		JSON_SERIALIZE("mStartPosZ", mStartPosZ);
-		JSON_SERIALIZE("mStartRotatorPitch", mStartRotatorPitch);
-		JSON_SERIALIZE("mStartRotatorYaw", mStartRotatorYaw);
-		JSON_SERIALIZE("mStartRotatorRoll", mStartRotatorRoll);
-		JSON_SERIALIZE("mStartCameraRotatorPitch", mStartCameraRotatorPitch);
-		JSON_SERIALIZE("mStartCameraRotatorYaw", mStartCameraRotatorYaw);
-		JSON_SERIALIZE("mStartCameraRotatorRoll", mStartCameraRotatorRoll);
-		JSON_SERIALIZE("mStartControllerPitch", mStartControllerPitch);
-		JSON_SERIALIZE("mEndFrame", mEndFrame);
-		END_JSON_SERIALIZER
-
-			TArray<FCommandNode>	mList;
-		float		mStartPosX = 0.f;
-		float		mStartPosY = 0.f;
-		float		mStartPosZ = 0.f;
-		float		mStartRotatorPitch = 0.f;
-		float		mStartRotatorYaw = 0.f;
-		float		mStartRotatorRoll = 0.f;
-		float		mStartCameraRotatorPitch = 0.f;
-		float		mStartCameraRotatorYaw = 0.f;
-		float		mStartCameraRotatorRoll = 0.f;
-		float		mStartControllerPitch = 0.f;
-		uint32		mEndFrame = 0;
+		FPlayTimeline	mTimeline;
+		double	mLoadSec = 0.0;
+		int64	mFileSize = 0;
+		SIZE_T	mDecodedSize = 0;
+		bool	mbSuccess = false;
+	};
+	typedef TSharedPtr<FPlayLoadResult, ESPMode::ThreadSafe>	FPlayLoadResultPtr;
+	/* ------------------------------------------------------------
+	   !記録/再生するコントローラ
+	   0番は自分(UCSDebugAutoPilotComponentを持ってるPlayerController)
+	   1番以降はローカルプレイヤー順
+	------------------------------------------------------------ */
+	struct FControllerState
+	{
+		TWeakObjectPtr<APlayerController>	mPlayerController;
+		FCSDebugAutoPilotPadSnapshot	mBeforeFramePad;//前フレームの入力(変化したキーだけ開始/終了を書く)
+		float	mResampleAxisSec[static_cast<int32>(ECSDebugAutoPilotKey::Num)] = {};//時間基準の再生で このフレームの区間に入力してた値×秒
+		uint32	mResampleAxisBits = 0;//mResampleAxisSecに値があるキー
 	};
 
 public:
+	static const int32	sRecordFrameRate = 30;//記録,再生時の固定フレームレート
+	/* ------------------------------------------------------------
+	   !再生時のチェックサム照合結果
+	------------------------------------------------------------ */
+	struct FChecksumResult
+	{
+		uint32	mCheckNum = 0;
+		uint32	mDivergeNum = 0;
+		uint32	mFirstDivergeFrame = MAX_uint32;
+		float	mFirstDivergeDistance = 0.f;//最初にズレたフレームのPawn位置の差
+		uint32	mLastChecksum = 0;
+		bool	mbReported = false;
+
+		bool	IsDiverged() const { return mDivergeNum > 0; }
+	};
+
 	virtual void	PreProcessInput(float DeltaTime) override;
 	virtual void	PostProcessInput(float DeltaTime) override;
 	virtual void	DebugDraw(class UCanvas* InCanvas) override;
@@ -115,30 +132,78 @@ public:
 	void	SetMode(ECommandMode InMode);
 	void	RequestPlayInputRecord(const FString& InFileName);
 	bool	IsFinihPlay() const;
+	bool	IsActivePlayInputRecord() const { return mMode == ECommandMode::PlayInputRecord; }
+	bool	IsPlayingInputRecord() const { return IsActivePlayInputRecord() && mPlayInputRecordState == EPlayInputRecordState::Play; }
 	void	RequestBeginRecord(const FString& InFileName);
 	void	RequestEndRecord();
 	void	RequestIdle();
+	void	RequestSeekOffset(const int32 InFrameOffset);
 
 	FString	GetFilePath() const;
+	const FChecksumResult&	GetChecksumResult() const { return mChecksumResult; }
+	const FCSDebugAutoPilotTelemetry&	GetTelemetry() const { return mTelemetry; }
+	bool	ExportTelemetry(const FString& InFileName) const;
+	float	GetPlaySpeedRate() const;
+	double	GetPlaySimSec() const { return mPlaySimSec; }
+	bool	IsFixFrameRate() const;
 
 	bool	UpdatePlayInputRecord(float DeltaTime);
 	bool	LoadInputRecordFile(float DeltaTime);
 	bool	WaitPlayInputRecordFile(float DeltaTime);
 	bool	PlayInputRecordFile(float DeltaTime);
+	bool	PlayInputRecordTime(float DeltaTime);
 
 	bool	UpdateInputRecord(float DeltaTime);
 	bool	BeginInputRecord(float DeltaTime);
 	bool	RecordingInput(float DeltaTime);
 
+	static void	sBenchmarkPlayTimeline(const int32 InNodeNum);
+	static double	sMeasurePlayFile(const FString& InPath, uint32& OutFrameNum, int32& OutMaxActiveNum, SIZE_T& OutReaderPeakSize);
+	void	BenchmarkRecordCapture(const int32 InFrameNum);
+
+private:
+	static FPlayLoadResultPtr	sLoadPlayRecord(const FString& InPath);
+	bool	PrepareControllerList(const int32 InControllerNum, const bool bInCreatePlayer);
+	APlayerController*	GetControllerPlayerController(const int32 InControllerId) const;
+	void	PushRecordEvent(const uint8 InControllerId, const ECSDebugAutoPilotKey InKey, const bool bInBegin, const float InAxisValue, const float InDeltaTime);
+	uint32	CalcStateChecksum(FVector& OutPos);
+	void	VerifyPlayChecksum();
+	void	UpdateTelemetry();
+	void	MakeKeyframe(FCSDebugAutoPilotRecordKeyframe& OutKeyframe, const APlayerController* InPlayerController, const FCSDebugAutoPilotPadSnapshot& InPad, const float InDeltaTime, const bool bInUserState);
+	bool	HasPlayFrame();
+	void	AccumulateResampleAxis(const float InSec);
+	bool	SeekPlayFrame(const uint32 InFrame, const bool bInForward);
+	void	ApplyKeyframe(const FPlayTimeline::FKeyframeIndex& InIndex);
+	void	DebugDrawInfo(UCanvas* InCanvas);
+
 private:
-	typedef	TArray<FCommandNode*>	CommandPtrList;
-	CommandPtrList	mBeforeFrameCommandList;
+	TArray<FControllerState>	mControllerList;//記録/再生するコントローラ(0番は自分)
+	FCSDebugAutoPilotRecordStreamWriter	mRecordWriter;
 	FString	mFileName;
 	uint32	mPlayFrame = 0;
+	uint32	mKeyframeIntervalFrame = 0;
+	int32	mSeekOffset = 0;//次の再生フレームでシークする量
+	bool	mbSeekRequest = false;
+	bool	mbSeekChecksumLog = false;//シーク後の最初のチェックサム照合結果をログに出す
 	float	mWarpInterval = 0.f;
 	ECommandMode	mMode = ECommandMode::Invalid;
 	FCommandList	mCommand;
+	FPlayTimeline	mPlayTimeline;
+	TArray<FCommandNode>	mResampleReleaseNodeList;//時間基準の再生で このフレームの区間に離したコマンド
+	TFuture<FPlayLoadResultPtr>	mLoadFuture;
+	double	mLoadSec = 0.0;
+	int64	mLoadFileSize = 0;
+	SIZE_T	mLoadDecodedSize = 0;
+	FChecksumResult	mChecksumResult;
+	FCSDebugAutoPilotTelemetry	mTelemetry;
+	double	mPlayBeginSec = 0.0;
+	double	mPlayWallSec = 0.0;//再生終了までの実時間
+	double	mPlaySimSec = 0.0;//再生中に進めたゲーム時間
+	double	mPlayRecordSec = 0.0;//時間基準の再生で 次に進める記録フレームの開始時刻(mPlaySimSecと同じ軸)
+	double	mChecksumCostSec = 0.0;//1回当たりの計算時間(移動平均)
+	FCSDebug_ScreenWindowText	mInfoWindow;
 	EPlayInputRecordState	mPlayInputRecordState = EPlayInputRecordState::Invalid;
+	bool	mbPlayTimeBased = false;//記録時の時間基準で再生中
 
 #if 0
 
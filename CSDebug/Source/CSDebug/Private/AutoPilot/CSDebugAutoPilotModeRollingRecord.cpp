@@ -0,0 +1,162 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotModeRollingRecord.cpp
+ * @brief 自動入力 直近の一定時間のパッド入力を常時記録するモード
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotModeRollingRecord.h"
+#include "CSDebug_Subsystem.h"
+#include "CSDebug_Config.h"
+
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/Paths.h"
+
+/**
+ * @brief	親セット時(記録バッファの確保)
+ */
+void	UCSDebugAutoPilotModeRollingRecord::OnSetParent()
+{
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	const int32 FrameNum = FMath::Max(FMath::CeilToInt(CSDebugConfig->mAutoPilot_RollingRecordSec * sFrameRate), 1);
+	mFrameList.ChangeSize(FrameNum);
+}
+
+/**
+ * @brief	PlayerInputの処理後
+ *			確保済みのリングバッファに上書きするだけなので毎フレームのメモリ確保は無し
+ */
+void	UCSDebugAutoPilotModeRollingRecord::PostProcessInput(float DeltaTime)
+{
+	const double BeginSec = FPlatformTime::Seconds();
+
+	const APlayerController* PlayerController = GetPlayerController();
+	FFrame Frame;
+	Frame.mDeltaTime = DeltaTime;
+	Frame.mControlRot = PlayerController->GetControlRotation();
+	if (const APawn* Pawn = PlayerController->GetPawn())
+	{
+		Frame.mPos = Pawn->GetActorLocation();
+		Frame.mRot = Pawn->GetActorRotation();
+	}
+
+	CapturePadSnapshot(Frame.mPad);
+	mFrameList.Push(Frame);
+
+	const double CaptureSec = FPlatformTime::Seconds() - BeginSec;
+	mCaptureAverageSec = (mCaptureAverageSec == 0.0) ? CaptureSec : FMath::Lerp(mCaptureAverageSec, CaptureSec, 0.05);
+	mCaptureMaxSec = FMath::Max(mCaptureMaxSec, CaptureSec);
+}
+
+/**
+ * @brief	Draw
+ */
+void	UCSDebugAutoPilotModeRollingRecord::DebugDraw(class UCanvas* InCanvas)
+{
+	//表示する時だけ最新フレームから作る
+	if (mFrameList.GetListNum() > 0)
+	{
+		const FCSDebugAutoPilotPadSnapshot& Pad = mFrameList.GetLast().mPad;
+		for (uint32 InputBits = Pad.mInputBits; InputBits != 0; InputBits &= InputBits - 1)
+		{
+			const ECSDebugAutoPilotKey KeyId = static_cast<ECSDebugAutoPilotKey>(FMath::CountTrailingZeros(InputBits));
+			AddDebugDrawPadInfo(FCSDebugAutoPilotDebugDrawPadInfo(KeyId, Pad.GetValue(KeyId)));
+		}
+	}
+	DebugDrawPad(InCanvas);
+
+	mInfoWindow.ClearString();
+	mInfoWindow.SetWindowName(TEXT("AutoPilot RollingRecord"));
+	mInfoWindow.AddText(FString::Printf(TEXT("Frame : %d / %d"), mFrameList.GetListNum(), mFrameList.GetListMaxNum()));
+	mInfoWindow.AddText(FString::Printf(TEXT("Capture : %.2fus (max %.2fus)"), mCaptureAverageSec * 1000000.0, mCaptureMaxSec * 1000000.0));
+	mInfoWindow.FittingWindowExtent(InCanvas);
+	mInfoWindow.Draw(InCanvas, 0.05f, 0.1f);
+}
+
+/**
+ * @brief	記録してる分を再生できる形でファイルへ
+ */
+bool	UCSDebugAutoPilotModeRollingRecord::DumpRecord(const FString& InFileName) const
+{
+	if (mFrameList.GetListNum() == 0)
+	{
+		return false;
+	}
+
+	FString SavedPath = FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/") + InFileName;
+	if (FPaths::GetExtension(InFileName).IsEmpty())
+	{
+		SavedPath += TEXT(".csrec");
+	}
+
+	FCSDebugAutoPilotCommandList CommandList;
+	MakeCommandList(CommandList);
+	const bool bSave = FCSDebugAutoPilotRecordFile::SaveFile(SavedPath, CommandList);
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot DumpRollingRecord %s : %s (%d frames)"), bSave ? TEXT("Success") : TEXT("Failed"), *SavedPath, CommandList.mEndFrame);
+	return bSave;
+}
+
+/**
+ * @brief	リングバッファの中身をコマンドリストへ
+ *			同じキーが同じ値で続いてる間を1つのコマンドにまとめる
+ */
+void	UCSDebugAutoPilotModeRollingRecord::MakeCommandList(FCSDebugAutoPilotCommandList& OutList) const
+{
+	OutList.mList.Reset();
+	const int32 FrameNum = mFrameList.GetListNum();
+	OutList.mEndFrame = FrameNum;
+	if (FrameNum == 0)
+	{
+		return;
+	}
+
+	//開始位置は残ってる中で一番古いフレーム
+	const FFrame& StartFrame = mFrameList.GetOrder(0);
+	OutList.mStartPosX = StartFrame.mPos.X;
+	OutList.mStartPosY = StartFrame.mPos.Y;
+	OutList.mStartPosZ = StartFrame.mPos.Z;
+	OutList.mStartRotatorPitch = StartFrame.mRot.Pitch;
+	OutList.mStartRotatorYaw = StartFrame.mRot.Yaw;
+	OutList.mStartRotatorRoll = StartFrame.mRot.Roll;
+	OutList.mStartCameraRotatorPitch = StartFrame.mControlRot.Pitch;
+	OutList.mStartCameraRotatorYaw = StartFrame.mControlRot.Yaw;
+	OutList.mStartCameraRotatorRoll = StartFrame.mControlRot.Roll;
+	OutList.mStartControllerPitch = StartFrame.mControlRot.Pitch;
+
+	int32 OpenNodeIndexList[static_cast<int32>(ECSDebugAutoPilotKey::Num)];
+	for (int32& OpenNodeIndex : OpenNodeIndexList)
+	{
+		OpenNodeIndex = INDEX_NONE;
+	}
+
+	for (int32 f = 0; f < FrameNum; ++f)
+	{
+		const FFrame& Frame = mFrameList.GetOrder(f);
+		for (uint8 i = 1; i < static_cast<uint8>(ECSDebugAutoPilotKey::Num); ++i)
+		{
+			const float Value = Frame.mPad.GetValue(static_cast<ECSDebugAutoPilotKey>(i));
+			int32& OpenNodeIndex = OpenNodeIndexList[i];
+			if (OpenNodeIndex != INDEX_NONE
+				&& OutList.mList[OpenNodeIndex].mAxisValue == Value)
+			{
+				OutList.mList[OpenNodeIndex].mEndFrame = f;
+				continue;
+			}
+
+			OpenNodeIndex = INDEX_NONE;
+			if (Value != 0.f)
+			{
+				FCSDebugAutoPilotCommandNode Node;
+				Node.mBeginFrame = f;
+				Node.mEndFrame = f;
+				Node.mAxisValue = Value;
+				Node.mDeltaTime = Frame.mDeltaTime;
+				Node.mKeyId = i;
+				Node.mInputEventId = EInputEvent::IE_Pressed;
+				Node.mIndex = OutList.mList.Num();
+				OpenNodeIndex = OutList.mList.Add(Node);
+			}
+		}
+	}
+}
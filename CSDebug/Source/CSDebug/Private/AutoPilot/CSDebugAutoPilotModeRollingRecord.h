@@ -0,0 +1,52 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotModeRollingRecord.h
+ * @brief 自動入力 直近の一定時間のパッド入力を常時記録するモード
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AutoPilot/CSDebugAutoPilotModeBase.h"
+#include "AutoPilot/CSDebugAutoPilotRecordFile.h"
+#include "CSDebug_LoopOrderArray.h"
+#include "ScreenWindow/CSDebug_ScreenWindowText.h"
+#include "CSDebugAutoPilotModeRollingRecord.generated.h"
+
+class UCanvas;
+
+UCLASS()
+class CSDEBUG_API UCSDebugAutoPilotModeRollingRecord : public UCSDebugAutoPilotModeBase
+{
+	GENERATED_BODY()
+
+	static const int32	sFrameRate = 30;
+	/* ------------------------------------------------------------
+	   !1フレーム分の入力と開始位置用のPawnの状態
+	------------------------------------------------------------ */
+	struct FFrame
+	{
+		FVector		mPos = FVector::ZeroVector;
+		FRotator	mRot = FRotator::ZeroRotator;
+		FRotator	mControlRot = FRotator::ZeroRotator;
+		FCSDebugAutoPilotPadSnapshot	mPad;
+		float	mDeltaTime = 0.f;
+	};
+
+public:
+	virtual void	PostProcessInput(float DeltaTime) override;
+	virtual void	DebugDraw(class UCanvas* InCanvas) override;
+
+	bool	DumpRecord(const FString& InFileName) const;
+	void	MakeCommandList(FCSDebugAutoPilotCommandList& OutList) const;
+
+protected:
+	virtual void	OnSetParent() override;
+
+private:
+	TCSDebug_LoopOrderArray<FFrame>	mFrameList{ 60 * sFrameRate };
+	FCSDebug_ScreenWindowText	mInfoWindow;
+	double	mCaptureAverageSec = 0.0;
+	double	mCaptureMaxSec = 0.0;
+};
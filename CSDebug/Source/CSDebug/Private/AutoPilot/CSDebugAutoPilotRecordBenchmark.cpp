@@ -0,0 +1,303 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotRecordBenchmark.cpp
+ * @brief 自動入力 入力記録の記録,保存,読み込み,再生の負荷計測
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotRecordBenchmark.h"
+#include "AutoPilot/CSDebugAutoPilotRecordFile.h"
+#include "AutoPilot/CSDebugAutoPilotModeRecord.h"
+
+#include "CSDebug_Subsystem.h"
+#include "CSDebug_Config.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Math/RandomStream.h"
+
+static FAutoConsoleCommand sCSDebugAutoPilotBenchmarkRecordSuiteCommand(
+	TEXT("CSDebug.AutoPilot.BenchmarkRecordSuite"),
+	TEXT("CSDebug.AutoPilot.BenchmarkRecordSuite [Minute] : 合成した入力記録で記録,保存,読み込み,再生の負荷を計測してSaved/CSDebug/AutoPilot/Benchmark/RecordBenchmark.jsonへ出力"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+	{
+		const int32 Minute = (InArgs.Num() > 0) ? FCString::Atoi(*InArgs[0]) : 10;
+		FCSDebugAutoPilotRecordBenchmarkResult Result;
+		if (FCSDebugAutoPilotRecordBenchmark::sRun(Result, FMath::Max(Minute, 1)))
+		{
+			FCSDebugAutoPilotRecordBenchmark::sLog(Result);
+			FFileHelper::SaveStringToFile(Result.ToJson(), *(FCSDebugAutoPilotRecordBenchmark::sGetDir() + TEXT("RecordBenchmark.json")));
+		}
+	})
+);
+
+namespace
+{
+	constexpr float	sHoldEndRate = 1.f / 15.f;//押してるキーを離す確率(平均0.5秒押しっぱなし)
+	constexpr float	sStickChangeRate = 1.f / 4.f;//倒してるスティックの値が変わる確率
+	constexpr float	sPressRate = 1.f / 60.f;//離してるキーを押す確率
+
+	bool	sIsStick(const uint32 InKeyId)
+	{
+		return (InKeyId >= static_cast<uint32>(ECSDebugAutoPilotKey::LeftStickX)
+			&& InKeyId <= static_cast<uint32>(ECSDebugAutoPilotKey::RightStickY));
+	}
+
+	double	sToMilliSec(const double InSec)
+	{
+		return InSec * 1000.0;
+	}
+}
+
+/**
+ * @brief	出力先
+ */
+FString	FCSDebugAutoPilotRecordBenchmark::sGetDir()
+{
+	return FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/Benchmark/");
+}
+
+/**
+ * @brief	計測
+ *			記録(書き込みスレッド経由)→バイナリ読み込み/保存→json保存/読み込み→ファイルから再生 の順
+ *			作業用のファイルは最後に消す
+ */
+bool	FCSDebugAutoPilotRecordBenchmark::sRun(FCSDebugAutoPilotRecordBenchmarkResult& OutResult, const int32 InMinute)
+{
+	const uint32 FrameNum = static_cast<uint32>(InMinute * 60 * UCSDebugAutoPilotModeRecord::sRecordFrameRate);
+	TArray<FCSDebugAutoPilotRecordEvent> EventList;
+	sMakeEventList(EventList, FrameNum);
+
+	const FString Dir = sGetDir();
+	const FString RecordPath = Dir + TEXT("Benchmark_Record.csrec");
+	const FString BinaryPath = Dir + TEXT("Benchmark_Binary.csrec");
+	const FString JsonPath = Dir + TEXT("Benchmark_Json.json");
+	IFileManager::Get().MakeDirectory(*Dir, true);
+
+	OutResult = FCSDebugAutoPilotRecordBenchmarkResult();
+	OutResult.mDate = FDateTime::Now().ToString();
+	OutResult.mPlatform = ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName());
+	OutResult.mMinute = InMinute;
+	OutResult.mFrameNum = static_cast<int32>(FrameNum);
+	OutResult.mEventNum = EventList.Num();
+
+	//記録 ゲームスレッドは1フレーム分ずつ積むだけ
+	{
+		FCSDebugAutoPilotRecordStreamWriter StreamWriter;
+		if (!StreamWriter.Start(RecordPath, FCSDebugAutoPilotCommandList()))
+		{
+			UE_LOG(CSDebugLog, Error, TEXT("AutoPilot RecordBenchmark : failed to open %s"), *RecordPath);
+			return false;
+		}
+		int32 EventIndex = 0;
+		const double PushBeginSec = FPlatformTime::Seconds();
+		for (uint32 Frame = 0; Frame < FrameNum; ++Frame)
+		{
+			for (; EventIndex < EventList.Num() && EventList[EventIndex].mFrame == Frame; ++EventIndex)
+			{
+				StreamWriter.PushEvent(EventList[EventIndex]);
+			}
+		}
+		const double PushSec = FPlatformTime::Seconds() - PushBeginSec;
+		const double FinishBeginSec = FPlatformTime::Seconds();
+		StreamWriter.Finish(FrameNum);
+		const double FinishSec = FPlatformTime::Seconds() - FinishBeginSec;
+		OutResult.mRecordPushUsPerFrame = PushSec * 1000000.0 / FrameNum;
+		OutResult.mRecordFinishMs = sToMilliSec(FinishSec);
+		OutResult.mRecordFramePerSec = FrameNum / FMath::Max(PushSec + FinishSec, SMALL_NUMBER);
+	}
+
+	//バイナリ
+	FCSDebugAutoPilotCommandList BinaryList;
+	const double LoadBinaryBeginSec = FPlatformTime::Seconds();
+	if (!FCSDebugAutoPilotRecordFile::LoadBinary(RecordPath, BinaryList))
+	{
+		UE_LOG(CSDebugLog, Error, TEXT("AutoPilot RecordBenchmark : failed to load %s"), *RecordPath);
+		return false;
+	}
+	OutResult.mLoadBinaryMs = sToMilliSec(FPlatformTime::Seconds() - LoadBinaryBeginSec);
+	const double SaveBinaryBeginSec = FPlatformTime::Seconds();
+	FCSDebugAutoPilotRecordFile::SaveBinary(BinaryPath, BinaryList);
+	OutResult.mSaveBinaryMs = sToMilliSec(FPlatformTime::Seconds() - SaveBinaryBeginSec);
+	OutResult.mBinaryKBPerMinute = IFileManager::Get().FileSize(*RecordPath) / 1024.f / InMinute;
+	OutResult.mNodeListKBPerMinute = BinaryList.mList.GetAllocatedSize() / 1024.f / InMinute;
+
+	//json
+	const double SaveJsonBeginSec = FPlatformTime::Seconds();
+	FCSDebugAutoPilotRecordFile::SaveJson(JsonPath, BinaryList);
+	OutResult.mSaveJsonMs = sToMilliSec(FPlatformTime::Seconds() - SaveJsonBeginSec);
+	FCSDebugAutoPilotCommandList JsonList;
+	const double LoadJsonBeginSec = FPlatformTime::Seconds();
+	FCSDebugAutoPilotRecordFile::LoadJson(JsonPath, JsonList);
+	OutResult.mLoadJsonMs = sToMilliSec(FPlatformTime::Seconds() - LoadJsonBeginSec);
+	OutResult.mJsonKBPerMinute = IFileManager::Get().FileSize(*JsonPath) / 1024.f / InMinute;
+	if (JsonList.mList.Num() != BinaryList.mList.Num())
+	{
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot RecordBenchmark : json node num mismatch %d/%d"), JsonList.mList.Num(), BinaryList.mList.Num());
+	}
+
+	//再生
+	uint32 PlayFrameNum = 0;
+	SIZE_T ReaderPeakSize = 0;
+	const double PlaySec = UCSDebugAutoPilotModeRecord::sMeasurePlayFile(RecordPath, PlayFrameNum, OutResult.mPlayMaxActiveNum, ReaderPeakSize);
+	if (PlaySec >= 0.0
+		&& PlayFrameNum > 0)
+	{
+		OutResult.mPlayUsPerFrame = PlaySec * 1000000.0 / PlayFrameNum;
+		OutResult.mPlayReaderPeakKB = ReaderPeakSize / 1024.f;
+	}
+
+	IFileManager::Get().Delete(*RecordPath);
+	IFileManager::Get().Delete(*BinaryPath);
+	IFileManager::Get().Delete(*JsonPath);
+	return true;
+}
+
+/**
+ * @brief	基準と比較して閾値の倍率を越えた項目数
+ *			基準が0の項目(古い結果に無い物)は見ない
+ */
+int32	FCSDebugAutoPilotRecordBenchmark::sCompare(const FCSDebugAutoPilotRecordBenchmarkResult& InResult, const FCSDebugAutoPilotRecordBenchmarkResult& InBaseline, const float InThresholdRate)
+{
+	struct FCompareItem
+	{
+		const TCHAR*	mName;
+		float	mValue;
+		float	mBaseline;
+	};
+	const FCompareItem CompareItemList[] =
+	{
+		{TEXT("RecordPushUsPerFrame"), InResult.mRecordPushUsPerFrame, InBaseline.mRecordPushUsPerFrame},
+		{TEXT("RecordFinishMs"), InResult.mRecordFinishMs, InBaseline.mRecordFinishMs},
+		{TEXT("SaveBinaryMs"), InResult.mSaveBinaryMs, InBaseline.mSaveBinaryMs},
+		{TEXT("LoadBinaryMs"), InResult.mLoadBinaryMs, InBaseline.mLoadBinaryMs},
+		{TEXT("SaveJsonMs"), InResult.mSaveJsonMs, InBaseline.mSaveJsonMs},
+		{TEXT("LoadJsonMs"), InResult.mLoadJsonMs, InBaseline.mLoadJsonMs},
+		{TEXT("BinaryKBPerMinute"), InResult.mBinaryKBPerMinute, InBaseline.mBinaryKBPerMinute},
+		{TEXT("JsonKBPerMinute"), InResult.mJsonKBPerMinute, InBaseline.mJsonKBPerMinute},
+		{TEXT("NodeListKBPerMinute"), InResult.mNodeListKBPerMinute, InBaseline.mNodeListKBPerMinute},
+		{TEXT("PlayUsPerFrame"), InResult.mPlayUsPerFrame, InBaseline.mPlayUsPerFrame},
+		{TEXT("PlayReaderPeakKB"), InResult.mPlayReaderPeakKB, InBaseline.mPlayReaderPeakKB},
+	};
+
+	int32 RegressionNum = 0;
+	for (const FCompareItem& Item : CompareItemList)
+	{
+		if (Item.mBaseline <= 0.f)
+		{
+			continue;
+		}
+		const float Rate = Item.mValue / Item.mBaseline;
+		if (Rate > InThresholdRate)
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot RecordBenchmark : %s regression %.3f -> %.3f (x%.2f)"), Item.mName, Item.mBaseline, Item.mValue, Rate);
+			++RegressionNum;
+		}
+	}
+	return RegressionNum;
+}
+
+/**
+ * @brief	ログ出力
+ */
+void	FCSDebugAutoPilotRecordBenchmark::sLog(const FCSDebugAutoPilotRecordBenchmarkResult& InResult)
+{
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot RecordBenchmark %s Minute=%d Frame=%d Event=%d"), *InResult.mPlatform, InResult.mMinute, InResult.mFrameNum, InResult.mEventNum);
+	UE_LOG(CSDebugLog, Log, TEXT("  Record : %.3f us/frame Finish %.3f ms (%.0f frame/sec)"), InResult.mRecordPushUsPerFrame, InResult.mRecordFinishMs, InResult.mRecordFramePerSec);
+	UE_LOG(CSDebugLog, Log, TEXT("  Binary : Save %.3f ms Load %.3f ms %.1f KB/min"), InResult.mSaveBinaryMs, InResult.mLoadBinaryMs, InResult.mBinaryKBPerMinute);
+	UE_LOG(CSDebugLog, Log, TEXT("  Json   : Save %.3f ms Load %.3f ms %.1f KB/min"), InResult.mSaveJsonMs, InResult.mLoadJsonMs, InResult.mJsonKBPerMinute);
+	UE_LOG(CSDebugLog, Log, TEXT("  Memory : NodeList %.1f KB/min Reader peak %.1f KB"), InResult.mNodeListKBPerMinute, InResult.mPlayReaderPeakKB);
+	UE_LOG(CSDebugLog, Log, TEXT("  Play   : %.3f us/frame MaxActive=%d"), InResult.mPlayUsPerFrame, InResult.mPlayMaxActiveNum);
+}
+
+/**
+ * @brief	固定シードで入力記録のイベントを合成
+ *			記録時と同じく 1フレームの中は 終了→開始→チェックサム→キーフレーム の順
+ */
+void	FCSDebugAutoPilotRecordBenchmark::sMakeEventList(TArray<FCSDebugAutoPilotRecordEvent>& OutEventList, const uint32 InFrameNum)
+{
+	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+	const uint32 KeyframeIntervalFrame = FMath::Max(FMath::RoundToInt(CSDebugConfig->mAutoPilot_KeyframeIntervalSec * UCSDebugAutoPilotModeRecord::sRecordFrameRate), 1);
+	const float DeltaTime = 1.f / UCSDebugAutoPilotModeRecord::sRecordFrameRate;
+	const uint32 KeyNum = static_cast<uint32>(ECSDebugAutoPilotKey::Num);
+
+	FRandomStream RandomStream(1);
+	float AxisValueList[static_cast<uint32>(ECSDebugAutoPilotKey::Num)] = {};
+	uint32 InputBits = 0;
+	FVector Pos = FVector::ZeroVector;
+	OutEventList.Reset();
+	OutEventList.Reserve(InFrameNum * 4);
+	for (uint32 Frame = 0; Frame < InFrameNum; ++Frame)
+	{
+		uint32 BeginBits = 0;
+		for (uint32 KeyId = 1; KeyId < KeyNum; ++KeyId)
+		{
+			const uint32 KeyBit = (1u << KeyId);
+			if (InputBits & KeyBit)
+			{
+				const bool bStickChange = sIsStick(KeyId) && RandomStream.FRand() < sStickChangeRate;
+				if (!bStickChange
+					&& RandomStream.FRand() >= sHoldEndRate)
+				{
+					continue;
+				}
+				FCSDebugAutoPilotRecordEvent& Event = OutEventList.AddDefaulted_GetRef();
+				Event.mFrame = Frame;
+				Event.mKeyId = static_cast<uint8>(KeyId);
+				InputBits &= ~KeyBit;
+				if (bStickChange)
+				{
+					BeginBits |= KeyBit;
+				}
+			}
+			else if (RandomStream.FRand() < sPressRate)
+			{
+				BeginBits |= KeyBit;
+			}
+		}
+		for (uint32 KeyId = 1; KeyId < KeyNum; ++KeyId)
+		{
+			if ((BeginBits & (1u << KeyId)) == 0)
+			{
+				continue;
+			}
+			AxisValueList[KeyId] = sIsStick(KeyId) ? RandomStream.FRandRange(-1.f, 1.f) : 1.f;
+			FCSDebugAutoPilotRecordEvent& Event = OutEventList.AddDefaulted_GetRef();
+			Event.mFrame = Frame;
+			Event.mKeyId = static_cast<uint8>(KeyId);
+			Event.mInputEventId = static_cast<uint8>(EInputEvent::IE_Pressed);
+			Event.mAxisValue = AxisValueList[KeyId];
+			Event.mDeltaTime = DeltaTime;
+			Event.mbBegin = true;
+		}
+		InputBits |= BeginBits;
+
+		Pos.X += AxisValueList[static_cast<uint32>(ECSDebugAutoPilotKey::LeftStickX)] * 10.f;
+		Pos.Y += AxisValueList[static_cast<uint32>(ECSDebugAutoPilotKey::LeftStickY)] * 10.f;
+		FCSDebugAutoPilotRecordEvent& ChecksumEvent = OutEventList.AddDefaulted_GetRef();
+		ChecksumEvent.mFrame = Frame;
+		ChecksumEvent.mChecksum = RandomStream.GetUnsignedInt();
+		ChecksumEvent.mCheckPos = Pos;
+		ChecksumEvent.mDeltaTime = DeltaTime;
+		ChecksumEvent.mbChecksum = true;
+
+		if (Frame % KeyframeIntervalFrame == 0)
+		{
+			FCSDebugAutoPilotRecordEvent& KeyframeEvent = OutEventList.AddDefaulted_GetRef();
+			KeyframeEvent.mFrame = Frame;
+			KeyframeEvent.mKeyframe = MakeShared<FCSDebugAutoPilotRecordKeyframe, ESPMode::ThreadSafe>();
+			KeyframeEvent.mKeyframe->mPos = Pos;
+			KeyframeEvent.mKeyframe->mInputBits = InputBits;
+			KeyframeEvent.mKeyframe->mDeltaTime = DeltaTime;
+			for (uint32 KeyId = 1; KeyId < KeyNum; ++KeyId)
+			{
+				if (InputBits & (1u << KeyId))
+				{
+					KeyframeEvent.mKeyframe->mInputValueList.Add(AxisValueList[KeyId]);
+				}
+			}
+		}
+	}
+}
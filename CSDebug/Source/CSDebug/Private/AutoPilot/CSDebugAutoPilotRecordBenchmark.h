@@ -0,0 +1,77 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotRecordBenchmark.h
+ * @brief 自動入力 入力記録の記録,保存,読み込み,再生の負荷計測
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonSerializerMacros.h"
+
+struct FCSDebugAutoPilotRecordEvent;
+
+/* ------------------------------------------------------------
+   !計測結果(Saved/CSDebug/AutoPilot/Benchmark/<Name>.json)
+   時間,サイズ共に小さい方が良い値なので基準との比較は倍率で見る
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotRecordBenchmarkResult : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE("mDate", mDate);
+	JSON_SERIALIZE("mPlatform", mPlatform);
+	JSON_SERIALIZE("mMinute", mMinute);
+	JSON_SERIALIZE("mFrameNum", mFrameNum);
+	JSON_SERIALIZE("mEventNum", mEventNum);
+	JSON_SERIALIZE("mRecordPushUsPerFrame", mRecordPushUsPerFrame);
+	JSON_SERIALIZE("mRecordFinishMs", mRecordFinishMs);
+	JSON_SERIALIZE("mRecordFramePerSec", mRecordFramePerSec);
+	JSON_SERIALIZE("mSaveBinaryMs", mSaveBinaryMs);
+	JSON_SERIALIZE("mLoadBinaryMs", mLoadBinaryMs);
+	JSON_SERIALIZE("mSaveJsonMs", mSaveJsonMs);
+	JSON_SERIALIZE("mLoadJsonMs", mLoadJsonMs);
+	JSON_SERIALIZE("mBinaryKBPerMinute", mBinaryKBPerMinute);
+	JSON_SERIALIZE("mJsonKBPerMinute", mJsonKBPerMinute);
+	JSON_SERIALIZE("mNodeListKBPerMinute", mNodeListKBPerMinute);
+	JSON_SERIALIZE("mPlayUsPerFrame", mPlayUsPerFrame);
+	JSON_SERIALIZE("mPlayReaderPeakKB", mPlayReaderPeakKB);
+	JSON_SERIALIZE("mPlayMaxActiveNum", mPlayMaxActiveNum);
+	END_JSON_SERIALIZER
+
+		FString	mDate;
+	FString	mPlatform;
+	int32	mMinute = 0;
+	int32	mFrameNum = 0;
+	int32	mEventNum = 0;
+	float	mRecordPushUsPerFrame = 0.f;//記録中のゲームスレッド側のコスト
+	float	mRecordFinishMs = 0.f;//記録終了時の書き込みスレッド待ち
+	float	mRecordFramePerSec = 0.f;//書き込み完了までの1秒当たりの記録フレーム数
+	float	mSaveBinaryMs = 0.f;
+	float	mLoadBinaryMs = 0.f;
+	float	mSaveJsonMs = 0.f;
+	float	mLoadJsonMs = 0.f;
+	float	mBinaryKBPerMinute = 0.f;//ファイルサイズ
+	float	mJsonKBPerMinute = 0.f;
+	float	mNodeListKBPerMinute = 0.f;//全部読み込んだ時のメモリ
+	float	mPlayUsPerFrame = 0.f;//ファイルからチャンク単位で読みながら再生した時のコスト
+	float	mPlayReaderPeakKB = 0.f;//その時の読み込みバッファの最大
+	int32	mPlayMaxActiveNum = 0;
+};
+
+/* ------------------------------------------------------------
+   !入力記録の負荷計測
+   固定シードで合成したN分の入力を実際の記録,保存,読み込み,再生の処理に通す
+   描画もプレイヤーも要らないのでコマンドレットからヘッドレスで回せる
+------------------------------------------------------------ */
+class FCSDebugAutoPilotRecordBenchmark
+{
+public:
+	static bool	sRun(FCSDebugAutoPilotRecordBenchmarkResult& OutResult, const int32 InMinute);
+	static int32	sCompare(const FCSDebugAutoPilotRecordBenchmarkResult& InResult, const FCSDebugAutoPilotRecordBenchmarkResult& InBaseline, const float InThresholdRate);
+	static void	sLog(const FCSDebugAutoPilotRecordBenchmarkResult& InResult);
+	static FString	sGetDir();
+
+private:
+	static void	sMakeEventList(TArray<FCSDebugAutoPilotRecordEvent>& OutEventList, const uint32 InFrameNum);
+};
@@ -0,0 +1,193 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotRecordCommandlet.cpp
+ * @brief 自動入力 入力記録の比較,縮小,負荷計測のコマンドレット
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotRecordCommandlet.h"
+#include "AutoPilot/CSDebugAutoPilotRecordFile.h"
+#include "AutoPilot/CSDebugAutoPilotRecordTool.h"
+#include "AutoPilot/CSDebugAutoPilotRecordBenchmark.h"
+#include "CSDebug_Subsystem.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	FString	sGetRecordDir()
+	{
+		return FPaths::ProjectSavedDir() + TEXT("CSDebug/AutoPilot/");
+	}
+}
+
+UCSDebugAutoPilotRecordCommandlet::UCSDebugAutoPilotRecordCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+/**
+ * @brief	Main
+ */
+int32	UCSDebugAutoPilotRecordCommandlet::Main(const FString& InParams)
+{
+	TArray<FString> TokenList;
+	TArray<FString> SwitchList;
+	ParseCommandLine(*InParams, TokenList, SwitchList);
+	if (TokenList.Num() > 0)
+	{
+		if (TokenList[0] == TEXT("Diff"))
+		{
+			return MainDiff(TokenList);
+		}
+		if (TokenList[0] == TEXT("Minimize"))
+		{
+			return MainMinimize(TokenList, InParams);
+		}
+		if (TokenList[0] == TEXT("Benchmark"))
+		{
+			return MainBenchmark(InParams);
+		}
+	}
+	UE_LOG(CSDebugLog, Error, TEXT("usage : -run=CSDebugAutoPilotRecord Diff A.csrec B.csrec | Minimize Src.csrec Dst.csrec -PredicateExe=... -PredicateArgs=\"... {Record} ...\" [-MaxTest=N] | Benchmark [-Minute=N] [-Output=X.json] [-Baseline=X.json] [-Threshold=1.25]"));
+	return 1;
+}
+
+/**
+ * @brief	比較(違いがあれば1)
+ */
+int32	UCSDebugAutoPilotRecordCommandlet::MainDiff(const TArray<FString>& InTokenList)
+{
+	if (InTokenList.Num() < 3)
+	{
+		UE_LOG(CSDebugLog, Error, TEXT("usage : -run=CSDebugAutoPilotRecord Diff A.csrec B.csrec"));
+		return 1;
+	}
+
+	FCSDebugAutoPilotCommandList ListA;
+	FCSDebugAutoPilotCommandList ListB;
+	if (!FCSDebugAutoPilotRecordFile::LoadFile(sGetRecordDir() + InTokenList[1], ListA)
+		|| !FCSDebugAutoPilotRecordFile::LoadFile(sGetRecordDir() + InTokenList[2], ListB))
+	{
+		UE_LOG(CSDebugLog, Error, TEXT("AutoPilot DiffRecord : failed to load %s or %s"), *InTokenList[1], *InTokenList[2]);
+		return 1;
+	}
+
+	FCSDebugAutoPilotRecordDiffResult Result;
+	FCSDebugAutoPilotRecordTool::Diff(Result, ListA, ListB, 64);
+	FCSDebugAutoPilotRecordTool::LogDiff(Result, ListA, ListB);
+	return Result.IsSame() ? 0 : 1;
+}
+
+/**
+ * @brief	縮小
+ *			試す入力記録は Minimize/ に書いて判定のプロセスに渡す
+ */
+int32	UCSDebugAutoPilotRecordCommandlet::MainMinimize(const TArray<FString>& InTokenList, const FString& InParams)
+{
+	FString PredicateExe;
+	FString PredicateArgs;
+	int32 MaxTestNum = 200;
+	FParse::Value(*InParams, TEXT("PredicateExe="), PredicateExe);
+	FParse::Value(*InParams, TEXT("PredicateArgs="), PredicateArgs, false);
+	FParse::Value(*InParams, TEXT("MaxTest="), MaxTestNum);
+	if (InTokenList.Num() < 3
+		|| PredicateExe.IsEmpty()
+		|| !PredicateArgs.Contains(TEXT("{Record}")))
+	{
+		UE_LOG(CSDebugLog, Error, TEXT("usage : -run=CSDebugAutoPilotRecord Minimize Src.csrec Dst.csrec -PredicateExe=... -PredicateArgs=\"... {Record} ...\" [-MaxTest=N]"));
+		return 1;
+	}
+
+	FCSDebugAutoPilotCommandList SrcList;
+	if (!FCSDebugAutoPilotRecordFile::LoadFile(sGetRecordDir() + InTokenList[1], SrcList))
+	{
+		UE_LOG(CSDebugLog, Error, TEXT("AutoPilot MinimizeRecord : failed to load %s"), *InTokenList[1]);
+		return 1;
+	}
+
+	const FString CandidateName = TEXT("Minimize/") + FPaths::GetBaseFilename(InTokenList[1]) + TEXT("_Candidate.csrec");
+	const FString CandidatePath = sGetRecordDir() + CandidateName;
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(CandidatePath), true);
+	const FString Args = PredicateArgs.Replace(TEXT("{Record}"), *CandidateName);
+	auto Predicate = [&CandidatePath, &PredicateExe, &Args](const FCSDebugAutoPilotCommandList& InList)
+	{
+		if (!FCSDebugAutoPilotRecordFile::SaveFile(CandidatePath, InList))
+		{
+			return false;
+		}
+		int32 ReturnCode = 0;
+		FString StdOut;
+		FString StdErr;
+		if (!FPlatformProcess::ExecProcess(*PredicateExe, *Args, &ReturnCode, &StdOut, &StdErr))
+		{
+			UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot MinimizeRecord : failed to run %s"), *PredicateExe);
+			return false;
+		}
+		return (ReturnCode != 0);
+	};
+
+	FCSDebugAutoPilotCommandList DstList;
+	FCSDebugAutoPilotRecordMinimizeStat Stat;
+	if (!FCSDebugAutoPilotRecordTool::Minimize(DstList, Stat, SrcList, Predicate, FMath::Max(MaxTestNum, 1)))
+	{
+		return 1;
+	}
+	IFileManager::Get().Delete(*CandidatePath);
+	if (!FCSDebugAutoPilotRecordFile::SaveFile(sGetRecordDir() + InTokenList[2], DstList))
+	{
+		UE_LOG(CSDebugLog, Error, TEXT("AutoPilot MinimizeRecord : failed to save %s"), *InTokenList[2]);
+		return 1;
+	}
+	return 0;
+}
+
+/**
+ * @brief	負荷計測(基準から悪化してたら1)
+ */
+int32	UCSDebugAutoPilotRecordCommandlet::MainBenchmark(const FString& InParams)
+{
+	int32 Minute = 10;
+	FString OutputName = TEXT("RecordBenchmark.json");
+	FString BaselineName;
+	float ThresholdRate = 1.25f;
+	FParse::Value(*InParams, TEXT("Minute="), Minute);
+	FParse::Value(*InParams, TEXT("Output="), OutputName);
+	FParse::Value(*InParams, TEXT("Baseline="), BaselineName);
+	FParse::Value(*InParams, TEXT("Threshold="), ThresholdRate);
+
+	FCSDebugAutoPilotRecordBenchmarkResult Result;
+	if (!FCSDebugAutoPilotRecordBenchmark::sRun(Result, FMath::Max(Minute, 1)))
+	{
+		return 1;
+	}
+	FCSDebugAutoPilotRecordBenchmark::sLog(Result);
+	const FString OutputPath = FCSDebugAutoPilotRecordBenchmark::sGetDir() + OutputName;
+	if (!FFileHelper::SaveStringToFile(Result.ToJson(), *OutputPath))
+	{
+		UE_LOG(CSDebugLog, Error, TEXT("AutoPilot RecordBenchmark : failed to save %s"), *OutputPath);
+		return 1;
+	}
+
+	if (BaselineName.IsEmpty())
+	{
+		return 0;
+	}
+	FString BaselineJson;
+	FCSDebugAutoPilotRecordBenchmarkResult Baseline;
+	if (!FFileHelper::LoadFileToString(BaselineJson, *(FCSDebugAutoPilotRecordBenchmark::sGetDir() + BaselineName))
+		|| !Baseline.FromJson(BaselineJson))
+	{
+		UE_LOG(CSDebugLog, Error, TEXT("AutoPilot RecordBenchmark : failed to load baseline %s"), *BaselineName);
+		return 1;
+	}
+	const int32 RegressionNum = FCSDebugAutoPilotRecordBenchmark::sCompare(Result, Baseline, FMath::Max(ThresholdRate, 1.f));
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot RecordBenchmark : %d regression (threshold x%.2f)"), RegressionNum, ThresholdRate);
+	return (RegressionNum > 0) ? 1 : 0;
+}
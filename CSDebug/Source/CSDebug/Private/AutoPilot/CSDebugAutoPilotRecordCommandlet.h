@@ -0,0 +1,36 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotRecordCommandlet.h
+ * @brief 自動入力 入力記録の比較,縮小,負荷計測のコマンドレット
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CSDebugAutoPilotRecordCommandlet.generated.h"
+
+/**
+ * 入力記録(Saved/CSDebug/AutoPilot/からの相対パス)の比較と縮小 と入力記録処理の負荷計測
+ * -run=CSDebugAutoPilotRecord Diff A.csrec B.csrec
+ * -run=CSDebugAutoPilotRecord Minimize Src.csrec Dst.csrec -PredicateExe="Game.exe" -PredicateArgs="Map -nullrhi -CSDebugAutoPilotBatch={Record} -CSDebugAutoPilotBatchFailOnHitch" [-MaxTest=200]
+ * 縮小の判定は PredicateExe を起動して終了コードが0以外なら再現とみなす({Record}は試す入力記録に置き換え)
+ * 一括再生の失敗(ズレ,ヒッチ)やクラッシュがそのまま判定に使える
+ * -run=CSDebugAutoPilotRecord Benchmark [-Minute=10] [-Output=RecordBenchmark.json] [-Baseline=Baseline.json] [-Threshold=1.25]
+ * 結果は Saved/CSDebug/AutoPilot/Benchmark/ へ 基準の結果から閾値の倍率を越えて悪化した項目があれば終了コード1
+ */
+UCLASS()
+class UCSDebugAutoPilotRecordCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UCSDebugAutoPilotRecordCommandlet();
+	virtual int32	Main(const FString& InParams) override;
+
+private:
+	int32	MainDiff(const TArray<FString>& InTokenList);
+	int32	MainMinimize(const TArray<FString>& InTokenList, const FString& InParams);
+	int32	MainBenchmark(const FString& InParams);
+};
@@ -0,0 +1,925 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotRecordFile.cpp
+ * @brief 自動入力 パッド入力記録のデータとファイル入出力(json/バイナリ)
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotRecordFile.h"
+
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "Async/Async.h"
+
+/* ------------------------------------------------------------
+   !イベント1個分のフラグ
+------------------------------------------------------------ */
+enum class ECSDebugAutoPilotRecordEventFlag : uint8
+{
+	Begin = 1 << 0,
+	AxisOne = 1 << 1,//mAxisValue == 1.f(ボタン)なので値は書かない
+	AxisValue = 1 << 2,//mAxisValueを書く
+	DeltaTime = 1 << 3,//直前の開始イベント,チェックサムとmDeltaTimeが違うので書く
+	InputEventId = 1 << 4,//mInputEventIdを書く
+	Checksum = 1 << 5,//入力ではなく状態チェックサム
+	Keyframe = 1 << 6,//入力ではなくキーフレーム
+	Controller = 1 << 7,//mControllerIdを書く(0以外)
+};
+
+static bool	sHasFlag(const uint8 InFlags, const ECSDebugAutoPilotRecordEventFlag InFlag)
+{
+	return (InFlags & static_cast<uint8>(InFlag)) != 0;
+}
+
+/**
+ * @brief	mList以外をコピー
+ */
+void	FCSDebugAutoPilotCommandList::CopyHeader(const FCSDebugAutoPilotCommandList& InList)
+{
+	mStartPosX = InList.mStartPosX;
+	mStartPosY = InList.mStartPosY;
+	mStartPosZ = InList.mStartPosZ;
+	mStartRotatorPitch = InList.mStartRotatorPitch;
+	mStartRotatorYaw = InList.mStartRotatorYaw;
+	mStartRotatorRoll = InList.mStartRotatorRoll;
+	mStartCameraRotatorPitch = InList.mStartCameraRotatorPitch;
+	mStartCameraRotatorYaw = InList.mStartCameraRotatorYaw;
+	mStartCameraRotatorRoll = InList.mStartCameraRotatorRoll;
+	mStartControllerPitch = InList.mStartControllerPitch;
+	mEndFrame = InList.mEndFrame;
+	mControllerNum = InList.mControllerNum;
+}
+
+/**
+ * @brief	キーフレームの読み書き(floatで書く)
+ */
+void	FCSDebugAutoPilotRecordKeyframe::Serialize(FArchive& InArchive)
+{
+	float ValueList[12] = {
+		static_cast<float>(mPos.X), static_cast<float>(mPos.Y), static_cast<float>(mPos.Z),
+		static_cast<float>(mRot.Pitch), static_cast<float>(mRot.Yaw), static_cast<float>(mRot.Roll),
+		static_cast<float>(mVelocity.X), static_cast<float>(mVelocity.Y), static_cast<float>(mVelocity.Z),
+		static_cast<float>(mControlRot.Pitch), static_cast<float>(mControlRot.Yaw), static_cast<float>(mControlRot.Roll),
+	};
+	for (float& Value : ValueList)
+	{
+		InArchive << Value;
+	}
+	mPos = FVector(ValueList[0], ValueList[1], ValueList[2]);
+	mRot = FRotator(ValueList[3], ValueList[4], ValueList[5]);
+	mVelocity = FVector(ValueList[6], ValueList[7], ValueList[8]);
+	mControlRot = FRotator(ValueList[9], ValueList[10], ValueList[11]);
+
+	InArchive << mInputBits;
+	mInputValueList.SetNum(FMath::CountBits(mInputBits));
+	for (float& InputValue : mInputValueList)
+	{
+		InArchive << InputValue;
+	}
+	InArchive << mDeltaTime;
+
+	uint32 UserStateSize = mUserState.Num();
+	InArchive.SerializeIntPacked(UserStateSize);
+	if (InArchive.IsLoading())
+	{
+		//壊れたサイズで大きく確保しないように
+		if (UserStateSize > InArchive.TotalSize() - InArchive.Tell())
+		{
+			InArchive.SetError();
+			return;
+		}
+		mUserState.SetNumUninitialized(UserStateSize);
+	}
+	InArchive.Serialize(mUserState.GetData(), UserStateSize);
+}
+
+/* ------------------------------------------------------------
+   !FCSDebugAutoPilotRecordWriter
+------------------------------------------------------------ */
+FCSDebugAutoPilotRecordWriter::~FCSDebugAutoPilotRecordWriter()
+{
+	Close(mHeader.mEndFrame);
+}
+
+/**
+ * @brief	書き込み開始(ヘッダまで書く)
+ */
+bool	FCSDebugAutoPilotRecordWriter::Open(const FString& InPath, const FCSDebugAutoPilotCommandList& InHeader)
+{
+	Close(mHeader.mEndFrame);
+
+	mFileWriter = IFileManager::Get().CreateFileWriter(*InPath);
+	if (mFileWriter == nullptr)
+	{
+		return false;
+	}
+
+	mHeader.CopyHeader(InHeader);
+	FCSDebugAutoPilotRecordFile::SerializeHeader(*mFileWriter, mHeader);
+	mChunkBuffer.Reset(FCSDebugAutoPilotRecordFile::sChunkSize + 64);
+	mChunkEventNum = 0;
+	return true;
+}
+
+/**
+ * @brief	書き込み終了(終了フレームでヘッダを書き直す)
+ */
+void	FCSDebugAutoPilotRecordWriter::Close(const uint32 InEndFrame)
+{
+	if (mFileWriter == nullptr)
+	{
+		return;
+	}
+
+	Flush();
+
+	mHeader.mEndFrame = InEndFrame;
+	mFileWriter->Seek(0);
+	FCSDebugAutoPilotRecordFile::SerializeHeader(*mFileWriter, mHeader);
+	mFileWriter->Close();
+	delete mFileWriter;
+	mFileWriter = nullptr;
+}
+
+/**
+ * @brief	イベント追加(チャンクが一杯になったらファイルへ)
+ */
+void	FCSDebugAutoPilotRecordWriter::WriteEvent(const FCSDebugAutoPilotRecordEvent& InEvent)
+{
+	if (mFileWriter == nullptr)
+	{
+		return;
+	}
+
+	if (mChunkEventNum == 0)
+	{
+		mChunkBaseFrame = InEvent.mFrame;
+		mLastFrame = InEvent.mFrame;
+		mLastDeltaTime = 0.f;
+	}
+
+	FMemoryWriter ChunkWriter(mChunkBuffer);
+	ChunkWriter.Seek(mChunkBuffer.Num());
+	FCSDebugAutoPilotRecordEvent Event = InEvent;
+	FCSDebugAutoPilotRecordFile::SerializeEvent(ChunkWriter, Event, mLastFrame, mLastDeltaTime);
+	++mChunkEventNum;
+
+	if (mChunkBuffer.Num() >= FCSDebugAutoPilotRecordFile::sChunkSize)
+	{
+		Flush();
+	}
+}
+
+/**
+ * @brief	溜まってるチャンクをファイルへ
+ */
+void	FCSDebugAutoPilotRecordWriter::Flush()
+{
+	if (mFileWriter == nullptr
+		|| mChunkEventNum == 0)
+	{
+		return;
+	}
+
+	uint32 ChunkByteSize = mChunkBuffer.Num();
+	*mFileWriter << ChunkByteSize;
+	*mFileWriter << mChunkEventNum;
+	*mFileWriter << mChunkBaseFrame;
+	mFileWriter->Serialize(mChunkBuffer.GetData(), mChunkBuffer.Num());
+	mFileWriter->Flush();
+
+	mChunkBuffer.Reset();
+	mChunkEventNum = 0;
+}
+
+/* ------------------------------------------------------------
+   !FCSDebugAutoPilotRecordStreamWriter
+------------------------------------------------------------ */
+FCSDebugAutoPilotRecordStreamWriter::~FCSDebugAutoPilotRecordStreamWriter()
+{
+	Finish(mLastPushFrame);
+}
+
+/**
+ * @brief	ファイルを開いて書き込みスレッド開始
+ */
+bool	FCSDebugAutoPilotRecordStreamWriter::Start(const FString& InPath, const FCSDebugAutoPilotCommandList& InHeader)
+{
+	Finish(mLastPushFrame);
+
+	if (!mWriter.Open(InPath, InHeader))
+	{
+		return false;
+	}
+
+	mLastPushFrame = 0;
+	mbStopRequest = false;
+	mWakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	mThread = FRunnableThread::Create(this, TEXT("CSDebugAutoPilotRecordWriter"), 0, TPri_BelowNormal);
+	if (mThread == nullptr)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(mWakeEvent);
+		mWakeEvent = nullptr;
+		mWriter.Close(0);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief	残りを書き切ってスレッド終了 終了フレームをヘッダに書いて閉じる
+ */
+void	FCSDebugAutoPilotRecordStreamWriter::Finish(const uint32 InEndFrame)
+{
+	if (mThread == nullptr)
+	{
+		return;
+	}
+
+	Stop();
+	mThread->WaitForCompletion();
+	delete mThread;
+	mThread = nullptr;
+	FPlatformProcess::ReturnSynchEventToPool(mWakeEvent);
+	mWakeEvent = nullptr;
+
+	WriteQueueEvent();
+	mWriter.Close(InEndFrame);
+}
+
+/**
+ * @brief	イベントを書き込みキューへ
+ */
+void	FCSDebugAutoPilotRecordStreamWriter::PushEvent(const FCSDebugAutoPilotRecordEvent& InEvent)
+{
+	if (mThread == nullptr)
+	{
+		return;
+	}
+	mEventQueue.Enqueue(InEvent);
+	mLastPushFrame = InEvent.mFrame;
+}
+
+/**
+ * @brief	書き込みスレッド
+ */
+uint32	FCSDebugAutoPilotRecordStreamWriter::Run()
+{
+	double LastFlushSec = FPlatformTime::Seconds();
+	while (!mbStopRequest)
+	{
+		mWakeEvent->Wait(100);
+		WriteQueueEvent();
+
+		const double CurrentSec = FPlatformTime::Seconds();
+		if (CurrentSec - LastFlushSec >= FCSDebugAutoPilotRecordFile::sFlushIntervalSec)
+		{
+			mWriter.Flush();
+			LastFlushSec = CurrentSec;
+		}
+	}
+	WriteQueueEvent();
+	return 0;
+}
+
+/**
+ * @brief	停止リクエスト
+ */
+void	FCSDebugAutoPilotRecordStreamWriter::Stop()
+{
+	mbStopRequest = true;
+	if (mWakeEvent)
+	{
+		mWakeEvent->Trigger();
+	}
+}
+
+/**
+ * @brief	キューに溜まってるイベントをチャンクへ
+ */
+void	FCSDebugAutoPilotRecordStreamWriter::WriteQueueEvent()
+{
+	FCSDebugAutoPilotRecordEvent Event;
+	while (mEventQueue.Dequeue(Event))
+	{
+		mWriter.WriteEvent(Event);
+	}
+}
+
+/* ------------------------------------------------------------
+   !FCSDebugAutoPilotRecordReader
+------------------------------------------------------------ */
+FCSDebugAutoPilotRecordReader::FCSDebugAutoPilotRecordReader()
+	: mChunk(MakeShared<FChunk, ESPMode::ThreadSafe>())
+	, mPrefetchChunk(MakeShared<FChunk, ESPMode::ThreadSafe>())
+{
+}
+
+FCSDebugAutoPilotRecordReader::~FCSDebugAutoPilotRecordReader()
+{
+	Close();
+}
+
+/**
+ * @brief	開いてるファイルと読み込み済み,先読み中のチャンクをそのまま引き継ぐ
+ */
+FCSDebugAutoPilotRecordReader&	FCSDebugAutoPilotRecordReader::operator=(FCSDebugAutoPilotRecordReader&& InOther)
+{
+	if (this != &InOther)
+	{
+		Close();
+		mFileReader = InOther.mFileReader;
+		InOther.mFileReader = nullptr;
+		Swap(mChunk, InOther.mChunk);
+		Swap(mPrefetchChunk, InOther.mPrefetchChunk);
+		mPrefetchFuture = MoveTemp(InOther.mPrefetchFuture);
+		mHeader.CopyHeader(InOther.mHeader);
+		mEventCursor = InOther.mEventCursor;
+		mbEnd = InOther.mbEnd;
+		InOther.mEventCursor = 0;
+	}
+	return *this;
+}
+
+/**
+ * @brief	ファイルを開いてヘッダだけ読む
+ */
+bool	FCSDebugAutoPilotRecordReader::Open(const FString& InPath)
+{
+	Close();
+
+	mFileReader = IFileManager::Get().CreateFileReader(*InPath);
+	if (mFileReader == nullptr)
+	{
+		return false;
+	}
+
+	FCSDebugAutoPilotRecordFile::SerializeHeader(*mFileReader, mHeader);
+	if (mFileReader->IsError())
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief	メモリ上のイベントリストを読む
+ */
+void	FCSDebugAutoPilotRecordReader::OpenMemory(TArray<FCSDebugAutoPilotRecordEvent>&& InEventList, const FCSDebugAutoPilotCommandList& InHeader)
+{
+	Close();
+
+	mChunk->mEventList = MoveTemp(InEventList);
+	mHeader.CopyHeader(InHeader);
+}
+
+/**
+ * @brief	閉じる
+ */
+void	FCSDebugAutoPilotRecordReader::Close()
+{
+	CancelPrefetch();
+	if (mFileReader)
+	{
+		mFileReader->Close();
+		delete mFileReader;
+		mFileReader = nullptr;
+	}
+	mChunk->mEventList.Reset();
+	mChunk->mPos = 0;
+	mEventCursor = 0;
+	mbEnd = false;
+}
+
+/**
+ * @brief	次のイベント(無ければnullptr)
+ */
+const FCSDebugAutoPilotRecordEvent*	FCSDebugAutoPilotRecordReader::PeekEvent()
+{
+	while (mEventCursor >= mChunk->mEventList.Num())
+	{
+		if (!ReadChunk())
+		{
+			return nullptr;
+		}
+	}
+	return &mChunk->mEventList[mEventCursor];
+}
+
+/**
+ * @brief	次のイベントへ
+ */
+void	FCSDebugAutoPilotRecordReader::PopEvent()
+{
+	if (mEventCursor < mChunk->mEventList.Num())
+	{
+		++mEventCursor;
+	}
+}
+
+/**
+ * @brief	GetChunkPos(),GetEventCursor()で取っておいた位置へ戻る
+ *			同じチャンク内なら先読みもそのまま使う
+ */
+bool	FCSDebugAutoPilotRecordReader::Seek(const int64 InChunkPos, const int32 InEventCursor)
+{
+	if (mFileReader == nullptr)
+	{
+		mEventCursor = FMath::Clamp(InEventCursor, 0, mChunk->mEventList.Num());
+		return true;
+	}
+
+	if (mChunk->mPos != InChunkPos
+		|| mChunk->mEventList.Num() == 0)
+	{
+		CancelPrefetch();
+		mbEnd = false;
+		mFileReader->Seek(InChunkPos);
+		if (!ReadChunk())
+		{
+			return false;
+		}
+	}
+	mEventCursor = FMath::Clamp(InEventCursor, 0, mChunk->mEventList.Num());
+	return true;
+}
+
+/**
+ * @brief	デコード済みデータのメモリ量(先読み分も含む)
+ */
+SIZE_T	FCSDebugAutoPilotRecordReader::GetAllocatedSize() const
+{
+	SIZE_T Size = mChunk->mBuffer.GetAllocatedSize() + mChunk->mEventList.GetAllocatedSize();
+	if (!mPrefetchFuture.IsValid()
+		|| mPrefetchFuture.IsReady())
+	{
+		Size += mPrefetchChunk->mBuffer.GetAllocatedSize() + mPrefetchChunk->mEventList.GetAllocatedSize();
+	}
+	return Size;
+}
+
+/**
+ * @brief	次のチャンクへ進む
+ *			先読みが済んでいれば入れ替えるだけ 無ければ(開いた直後,シーク直後)その場で読む
+ */
+bool	FCSDebugAutoPilotRecordReader::ReadChunk()
+{
+	if (mFileReader == nullptr
+		|| mbEnd)
+	{
+		return false;
+	}
+
+	bool bSuccess = false;
+	if (mPrefetchFuture.IsValid())
+	{
+		bSuccess = mPrefetchFuture.Get();
+		mPrefetchFuture = TFuture<bool>();
+	}
+	else
+	{
+		bSuccess = sReadChunk(*mFileReader, *mPrefetchChunk);
+	}
+	if (!bSuccess)
+	{
+		mbEnd = true;
+		return false;
+	}
+
+	Swap(mChunk, mPrefetchChunk);
+	mEventCursor = 0;
+	StartPrefetch();
+	return true;
+}
+
+/**
+ * @brief	次のチャンクの読み込みとデコードをスレッドプールへ
+ *			終わるまでmFileReaderとmPrefetchChunkには触らない
+ */
+void	FCSDebugAutoPilotRecordReader::StartPrefetch()
+{
+	check(!mPrefetchFuture.IsValid());
+	FArchive* FileReader = mFileReader;
+	FChunkPtr PrefetchChunk = mPrefetchChunk;
+	mPrefetchFuture = Async(EAsyncExecution::ThreadPool, [FileReader, PrefetchChunk]()
+	{
+		return sReadChunk(*FileReader, *PrefetchChunk);
+	});
+}
+
+/**
+ * @brief	先読みが終わるのを待って捨てる(ファイル位置を動かす前に)
+ */
+void	FCSDebugAutoPilotRecordReader::CancelPrefetch()
+{
+	if (mPrefetchFuture.IsValid())
+	{
+		mPrefetchFuture.Wait();
+		mPrefetchFuture = TFuture<bool>();
+	}
+}
+
+/**
+ * @brief	現在のファイル位置からチャンク1個分を読んでデコード
+ *			書き込み途中で切れてるチャンクは読まない ワーカースレッドからも呼ばれる
+ */
+bool	FCSDebugAutoPilotRecordReader::sReadChunk(FArchive& InFileReader, FChunk& OutChunk)
+{
+	const int64 ChunkPos = InFileReader.Tell();
+	const int64 ChunkHeaderSize = sizeof(uint32) * 3;
+	if (ChunkPos + ChunkHeaderSize > InFileReader.TotalSize())
+	{
+		return false;
+	}
+
+	uint32 ChunkByteSize = 0;
+	uint32 ChunkEventNum = 0;
+	uint32 ChunkBaseFrame = 0;
+	InFileReader << ChunkByteSize;
+	InFileReader << ChunkEventNum;
+	InFileReader << ChunkBaseFrame;
+	if (InFileReader.IsError()
+		|| InFileReader.Tell() + ChunkByteSize > InFileReader.TotalSize())
+	{
+		return false;
+	}
+
+	OutChunk.mBuffer.SetNumUninitialized(ChunkByteSize, false);
+	InFileReader.Serialize(OutChunk.mBuffer.GetData(), ChunkByteSize);
+
+	FMemoryReader ChunkReader(OutChunk.mBuffer);
+	uint32 LastFrame = ChunkBaseFrame;
+	float LastDeltaTime = 0.f;
+	OutChunk.mEventList.SetNum(ChunkEventNum, false);
+	for (uint32 i = 0; i < ChunkEventNum; ++i)
+	{
+		FCSDebugAutoPilotRecordFile::SerializeEvent(ChunkReader, OutChunk.mEventList[i], LastFrame, LastDeltaTime);
+	}
+	OutChunk.mPos = ChunkPos;
+
+	return !ChunkReader.IsError();
+}
+
+/* ------------------------------------------------------------
+   !FCSDebugAutoPilotRecordFile
+------------------------------------------------------------ */
+/**
+ * @brief	バイナリ形式のパスかどうか
+ */
+bool	FCSDebugAutoPilotRecordFile::IsBinaryPath(const FString& InPath)
+{
+	return FPaths::GetExtension(InPath) == TEXT("csrec");
+}
+
+/**
+ * @brief	拡張子に合わせてロード
+ */
+bool	FCSDebugAutoPilotRecordFile::LoadFile(const FString& InPath, FCSDebugAutoPilotCommandList& OutList)
+{
+	if (IsBinaryPath(InPath))
+	{
+		return LoadBinary(InPath, OutList);
+	}
+	return LoadJson(InPath, OutList);
+}
+
+/**
+ * @brief	拡張子に合わせてセーブ
+ */
+bool	FCSDebugAutoPilotRecordFile::SaveFile(const FString& InPath, const FCSDebugAutoPilotCommandList& InList)
+{
+	if (IsBinaryPath(InPath))
+	{
+		return SaveBinary(InPath, InList);
+	}
+	return SaveJson(InPath, InList);
+}
+
+/**
+ * @brief	jsonからロード
+ */
+bool	FCSDebugAutoPilotRecordFile::LoadJson(const FString& InPath, FCSDebugAutoPilotCommandList& OutList)
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *InPath))
+	{
+		return false;
+	}
+
+	TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(JsonString);
+	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	if (!FJsonSerializer::Deserialize(JsonReader, JsonObject)
+		|| !JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	OutList.mList.Empty();
+	OutList.FromJson(JsonObject);
+	return true;
+}
+
+/**
+ * @brief	jsonでセーブ
+ */
+bool	FCSDebugAutoPilotRecordFile::SaveJson(const FString& InPath, const FCSDebugAutoPilotCommandList& InList)
+{
+	return FFileHelper::SaveStringToFile(InList.ToJson(), *InPath);
+}
+
+/**
+ * @brief	バイナリを全部ロード(json書き出し等の変換用)
+ */
+bool	FCSDebugAutoPilotRecordFile::LoadBinary(const FString& InPath, FCSDebugAutoPilotCommandList& OutList)
+{
+	FCSDebugAutoPilotRecordReader Reader;
+	if (!Reader.Open(InPath))
+	{
+		return false;
+	}
+
+	OutList.CopyHeader(Reader.GetHeader());
+	TArray<FCSDebugAutoPilotRecordEvent> EventList;
+	while (const FCSDebugAutoPilotRecordEvent* Event = Reader.PeekEvent())
+	{
+		EventList.Add(*Event);
+		Reader.PopEvent();
+	}
+	MakeNodeList(OutList.mList, EventList);
+	return true;
+}
+
+/**
+ * @brief	バイナリでセーブ
+ */
+bool	FCSDebugAutoPilotRecordFile::SaveBinary(const FString& InPath, const FCSDebugAutoPilotCommandList& InList)
+{
+	FCSDebugAutoPilotRecordWriter Writer;
+	if (!Writer.Open(InPath, InList))
+	{
+		return false;
+	}
+
+	TArray<FCSDebugAutoPilotRecordEvent> EventList;
+	MakeEventList(EventList, InList.mList);
+	for (const FCSDebugAutoPilotRecordEvent& Event : EventList)
+	{
+		Writer.WriteEvent(Event);
+	}
+	Writer.Close(InList.mEndFrame);
+	return true;
+}
+
+/**
+ * @brief	コマンドリストを開始/終了イベントに分解してフレーム順に並べる
+ */
+void	FCSDebugAutoPilotRecordFile::MakeEventList(TArray<FCSDebugAutoPilotRecordEvent>& OutEventList, const TArray<FCSDebugAutoPilotCommandNode>& InNodeList)
+{
+	OutEventList.Reset(InNodeList.Num() * 2);
+	for (const FCSDebugAutoPilotCommandNode& Node : InNodeList)
+	{
+		FCSDebugAutoPilotRecordEvent BeginEvent;
+		BeginEvent.mFrame = Node.mBeginFrame;
+		BeginEvent.mAxisValue = Node.mAxisValue;
+		BeginEvent.mDeltaTime = Node.mDeltaTime;
+		BeginEvent.mKeyId = static_cast<uint8>(Node.mKeyId);
+		BeginEvent.mInputEventId = static_cast<uint8>(Node.mInputEventId);
+		BeginEvent.mControllerId = static_cast<uint8>(Node.mControllerId);
+		BeginEvent.mbBegin = true;
+		OutEventList.Add(BeginEvent);
+
+		FCSDebugAutoPilotRecordEvent EndEvent;
+		EndEvent.mFrame = Node.mEndFrame + 1;//離すのは次のフレーム
+		EndEvent.mKeyId = static_cast<uint8>(Node.mKeyId);
+		EndEvent.mControllerId = static_cast<uint8>(Node.mControllerId);
+		EndEvent.mbBegin = false;
+		OutEventList.Add(EndEvent);
+	}
+	//同フレームなら離す方を先に(同じキーの押し直しで押下が消えないように)
+	OutEventList.StableSort([](const FCSDebugAutoPilotRecordEvent& InA, const FCSDebugAutoPilotRecordEvent& InB)
+	{
+		if (InA.mFrame != InB.mFrame)
+		{
+			return InA.mFrame < InB.mFrame;
+		}
+		return !InA.mbBegin && InB.mbBegin;
+	});
+}
+
+/**
+ * @brief	開始/終了イベントからコマンドリストを組み立てる
+ */
+void	FCSDebugAutoPilotRecordFile::MakeNodeList(TArray<FCSDebugAutoPilotCommandNode>& OutNodeList, const TArray<FCSDebugAutoPilotRecordEvent>& InEventList)
+{
+	//コントローラ毎にキーの数だけ 使ったコントローラ分だけ伸ばす
+	TArray<int32, TInlineAllocator<MAX_uint8 + 1>> OpenNodeIndexList;
+	OpenNodeIndexList.Init(INDEX_NONE, MAX_uint8 + 1);
+
+	OutNodeList.Reset(InEventList.Num() / 2);
+	uint32 LastFrame = 0;
+	for (const FCSDebugAutoPilotRecordEvent& Event : InEventList)
+	{
+		LastFrame = Event.mFrame;
+		if (!Event.IsInput())
+		{
+			continue;
+		}
+		const int32 OpenListIndex = (static_cast<int32>(Event.mControllerId) << 8) | Event.mKeyId;
+		if (OpenListIndex >= OpenNodeIndexList.Num())
+		{
+			const int32 AddNum = OpenListIndex + 1 - OpenNodeIndexList.Num();
+			for (int32 i = 0; i < AddNum; ++i)
+			{
+				OpenNodeIndexList.Add(INDEX_NONE);
+			}
+		}
+		int32& OpenNodeIndex = OpenNodeIndexList[OpenListIndex];
+		if (Event.mbBegin)
+		{
+			FCSDebugAutoPilotCommandNode Node;
+			Node.mBeginFrame = Event.mFrame;
+			Node.mEndFrame = Event.mFrame;
+			Node.mAxisValue = Event.mAxisValue;
+			Node.mDeltaTime = Event.mDeltaTime;
+			Node.mKeyId = Event.mKeyId;
+			Node.mInputEventId = Event.mInputEventId;
+			Node.mControllerId = Event.mControllerId;
+			Node.mIndex = OutNodeList.Num();
+			OpenNodeIndex = OutNodeList.Add(Node);
+		}
+		else if (OpenNodeIndex != INDEX_NONE)
+		{
+			OutNodeList[OpenNodeIndex].mEndFrame = FMath::Max(Event.mFrame, 1u) - 1;
+			OpenNodeIndex = INDEX_NONE;
+		}
+	}
+
+	//終了が書かれる前に切れてたら最後まで押しっぱなし扱い
+	for (const int32 OpenNodeIndex : OpenNodeIndexList)
+	{
+		if (OpenNodeIndex != INDEX_NONE)
+		{
+			OutNodeList[OpenNodeIndex].mEndFrame = LastFrame;
+		}
+	}
+}
+
+/**
+ * @brief	ヘッダの読み書き
+ */
+void	FCSDebugAutoPilotRecordFile::SerializeHeader(FArchive& InArchive, FCSDebugAutoPilotCommandList& InOutHeader)
+{
+	uint32 Magic = sMagic;
+	uint16 Version = sVersion;
+	InArchive << Magic;
+	InArchive << Version;
+	if (InArchive.IsLoading()
+		&& (Magic != sMagic || Version > sVersion))
+	{
+		InArchive.SetError();
+		return;
+	}
+
+	InArchive << InOutHeader.mStartPosX;
+	InArchive << InOutHeader.mStartPosY;
+	InArchive << InOutHeader.mStartPosZ;
+	InArchive << InOutHeader.mStartRotatorPitch;
+	InArchive << InOutHeader.mStartRotatorYaw;
+	InArchive << InOutHeader.mStartRotatorRoll;
+	InArchive << InOutHeader.mStartCameraRotatorPitch;
+	InArchive << InOutHeader.mStartCameraRotatorYaw;
+	InArchive << InOutHeader.mStartCameraRotatorRoll;
+	InArchive << InOutHeader.mStartControllerPitch;
+	InArchive << InOutHeader.mEndFrame;
+	if (Version >= 4)
+	{
+		InArchive << InOutHeader.mControllerNum;
+	}
+	else
+	{
+		InOutHeader.mControllerNum = 1;
+	}
+}
+
+/**
+ * @brief	イベント1個の読み書き
+ *			フレームは直前のイベントからの差分を可変長で、値は変化がある時だけ書く
+ */
+void	FCSDebugAutoPilotRecordFile::SerializeEvent(FArchive& InArchive, FCSDebugAutoPilotRecordEvent& InOutEvent, uint32& InOutLastFrame, float& InOutLastDeltaTime)
+{
+	uint32 FrameDelta = InOutEvent.mFrame - InOutLastFrame;
+	uint8 Flags = 0;
+	if (InArchive.IsSaving()
+		&& InOutEvent.mbChecksum)
+	{
+		Flags |= static_cast<uint8>(ECSDebugAutoPilotRecordEventFlag::Checksum);
+		//チェックサムは毎フレーム書くのでそのフレームの時間も(可変フレームレートの再生用)
+		if (InOutEvent.mDeltaTime != InOutLastDeltaTime)
+		{
+			Flags |= static_cast<uint8>(ECSDebugAutoPilotRecordEventFlag::DeltaTime);
+		}
+	}
+	else if (InArchive.IsSaving()
+		&& InOutEvent.mKeyframe.IsValid())
+	{
+		Flags |= static_cast<uint8>(ECSDebugAutoPilotRecordEventFlag::Keyframe);
+	}
+	else if (InArchive.IsSaving()
+		&& InOutEvent.mbBegin)
+	{
+		Flags |= static_cast<uint8>(ECSDebugAutoPilotRecordEventFlag::Begin);
+		if (InOutEvent.mAxisValue == 1.f)
+		{
+			Flags |= static_cast<uint8>(ECSDebugAutoPilotRecordEventFlag::AxisOne);
+		}
+		else if (InOutEvent.mAxisValue != 0.f)
+		{
+			Flags |= static_cast<uint8>(ECSDebugAutoPilotRecordEventFlag::AxisValue);
+		}
+		if (InOutEvent.mDeltaTime != InOutLastDeltaTime)
+		{
+			Flags |= static_cast<uint8>(ECSDebugAutoPilotRecordEventFlag::DeltaTime);
+		}
+		if (InOutEvent.mInputEventId != 0)
+		{
+			Flags |= static_cast<uint8>(ECSDebugAutoPilotRecordEventFlag::InputEventId);
+		}
+	}
+	if (InArchive.IsSaving()
+		&& InOutEvent.mControllerId != 0)
+	{
+		Flags |= static_cast<uint8>(ECSDebugAutoPilotRecordEventFlag::Controller);
+	}
+
+	InArchive.SerializeIntPacked(FrameDelta);
+	InArchive << InOutEvent.mKeyId;
+	InArchive << Flags;
+
+	if (InArchive.IsLoading())
+	{
+		InOutEvent.mFrame = InOutLastFrame + FrameDelta;
+		InOutEvent.mbBegin = sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::Begin);
+		InOutEvent.mAxisValue = sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::AxisOne) ? 1.f : 0.f;
+		InOutEvent.mDeltaTime = InOutLastDeltaTime;
+		InOutEvent.mInputEventId = 0;
+		InOutEvent.mbChecksum = sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::Checksum);
+		InOutEvent.mKeyframe.Reset();
+		InOutEvent.mControllerId = 0;
+	}
+	if (sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::Controller))
+	{
+		InArchive << InOutEvent.mControllerId;
+	}
+	if (sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::Keyframe))
+	{
+		if (InArchive.IsLoading())
+		{
+			InOutEvent.mKeyframe = MakeShared<FCSDebugAutoPilotRecordKeyframe, ESPMode::ThreadSafe>();
+		}
+		InOutEvent.mKeyframe->Serialize(InArchive);
+		InOutLastFrame = InOutEvent.mFrame;
+		return;
+	}
+	if (sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::Checksum))
+	{
+		float CheckPosX = InOutEvent.mCheckPos.X;
+		float CheckPosY = InOutEvent.mCheckPos.Y;
+		float CheckPosZ = InOutEvent.mCheckPos.Z;
+		InArchive << InOutEvent.mChecksum;
+		InArchive << CheckPosX;
+		InArchive << CheckPosY;
+		InArchive << CheckPosZ;
+		InOutEvent.mCheckPos = FVector(CheckPosX, CheckPosY, CheckPosZ);
+		if (sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::DeltaTime))
+		{
+			InArchive << InOutEvent.mDeltaTime;
+		}
+		InOutLastFrame = InOutEvent.mFrame;
+		InOutLastDeltaTime = InOutEvent.mDeltaTime;
+		return;
+	}
+	if (sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::AxisValue))
+	{
+		InArchive << InOutEvent.mAxisValue;
+	}
+	if (sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::DeltaTime))
+	{
+		InArchive << InOutEvent.mDeltaTime;
+	}
+	if (sHasFlag(Flags, ECSDebugAutoPilotRecordEventFlag::InputEventId))
+	{
+		InArchive << InOutEvent.mInputEventId;
+	}
+
+	InOutLastFrame = InOutEvent.mFrame;
+	if (InOutEvent.mbBegin)
+	{
+		InOutLastDeltaTime = InOutEvent.mDeltaTime;
+	}
+}
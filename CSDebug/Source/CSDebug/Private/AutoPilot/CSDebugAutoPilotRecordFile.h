@@ -0,0 +1,270 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotRecordFile.h
+ * @brief 自動入力 パッド入力記録のデータとファイル入出力(json/バイナリ)
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/JsonSerializerMacros.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Queue.h"
+#include "Async/Future.h"
+
+class FArchive;
+class FRunnableThread;
+class FEvent;
+
+/* ------------------------------------------------------------
+   !自動操作時のコマンド単体
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotCommandNode : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE("mBeginFrame", mBeginFrame);
+	JSON_SERIALIZE("mEndFrame", mEndFrame);
+	JSON_SERIALIZE("mAxisValue", mAxisValue);
+	JSON_SERIALIZE("mDeltaTime", mDeltaTime);
+	JSON_SERIALIZE("mKeyId", mKeyId);
+	JSON_SERIALIZE("mInputEventId", mInputEventId);
+	JSON_SERIALIZE("mIndex", mIndex);
+	JSON_SERIALIZE("mControllerId", mControllerId);
+	END_JSON_SERIALIZER
+
+		uint32	mBeginFrame = 0;
+	uint32	mEndFrame = 0;
+	float	mAxisValue = 0.f;
+	float	mDeltaTime = 0.f;
+	uint32	mKeyId = 0;
+	uint32	mInputEventId = 0;
+	int32	mIndex = INDEX_NONE;//CommandPtrListからmListのIndexを取得するために。。。
+	uint32	mControllerId = 0;//複数コントローラ記録時の何番目か(0:記録したComponentのPlayerController)
+
+	bool	IsSameInput(const FCSDebugAutoPilotCommandNode& InCommand) const
+	{
+		return (mKeyId == InCommand.mKeyId
+			&& mControllerId == InCommand.mControllerId
+			&& mInputEventId == InCommand.mInputEventId
+			&& mAxisValue == InCommand.mAxisValue);
+	}
+};
+
+/* ------------------------------------------------------------
+   !自動操作時のコマンドリスト
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotCommandList : public FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE_ARRAY_SERIALIZABLE("mCommandList", mList, FCSDebugAutoPilotCommandNode);
+	JSON_SERIALIZE("mStartPosX", mStartPosX);
+	JSON_SERIALIZE("mStartPosY", mStartPosY);
+	JSON_SERIALIZE("mStartPosZ", mStartPosZ);
+	JSON_SERIALIZE("mStartRotatorPitch", mStartRotatorPitch);
+	JSON_SERIALIZE("mStartRotatorYaw", mStartRotatorYaw);
+	JSON_SERIALIZE("mStartRotatorRoll", mStartRotatorRoll);
+	JSON_SERIALIZE("mStartCameraRotatorPitch", mStartCameraRotatorPitch);
+	JSON_SERIALIZE("mStartCameraRotatorYaw", mStartCameraRotatorYaw);
+	JSON_SERIALIZE("mStartCameraRotatorRoll", mStartCameraRotatorRoll);
+	JSON_SERIALIZE("mStartControllerPitch", mStartControllerPitch);
+	JSON_SERIALIZE("mEndFrame", mEndFrame);
+	JSON_SERIALIZE("mControllerNum", mControllerNum);
+	END_JSON_SERIALIZER
+
+		TArray<FCSDebugAutoPilotCommandNode>	mList;
+	float		mStartPosX = 0.f;
+	float		mStartPosY = 0.f;
+	float		mStartPosZ = 0.f;
+	float		mStartRotatorPitch = 0.f;
+	float		mStartRotatorYaw = 0.f;
+	float		mStartRotatorRoll = 0.f;
+	float		mStartCameraRotatorPitch = 0.f;
+	float		mStartCameraRotatorYaw = 0.f;
+	float		mStartCameraRotatorRoll = 0.f;
+	float		mStartControllerPitch = 0.f;
+	uint32		mEndFrame = 0;
+	uint32		mControllerNum = 1;//記録したコントローラ数
+
+	void	CopyHeader(const FCSDebugAutoPilotCommandList& InList);
+};
+
+/* ------------------------------------------------------------
+   !再生の途中から始めるための状態
+   そのフレームの入力処理後の状態と 押しっぱなしの入力
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotRecordKeyframe
+{
+	FVector		mPos = FVector::ZeroVector;
+	FRotator	mRot = FRotator::ZeroRotator;
+	FVector		mVelocity = FVector::ZeroVector;
+	FRotator	mControlRot = FRotator::ZeroRotator;
+	uint32	mInputBits = 0;//入力中のキー(ECSDebugAutoPilotKeyのビット)
+	TArray<float>	mInputValueList;//mInputBitsの立ってる順の入力値
+	float	mDeltaTime = 0.f;
+	TArray<uint8>	mUserState;//UCSDebugAutoPilotComponentに登録された保存処理で書いた物
+
+	void	Serialize(FArchive& InArchive);
+};
+typedef TSharedPtr<FCSDebugAutoPilotRecordKeyframe, ESPMode::ThreadSafe>	FCSDebugAutoPilotRecordKeyframePtr;
+
+/* ------------------------------------------------------------
+   !入力の開始/終了イベント
+   mListを開始/終了に分解してフレーム順に並べたもの
+   同じコントローラで同じキーの入力が同時に2つ開くことは無いので終了はキーとコントローラで特定できる
+   記録時の状態チェックサムとキーフレームも同じ流れに入れる
+   複数コントローラ分もフレーム順に混ぜて1本にするので 順に読むだけで全員分揃う
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotRecordEvent
+{
+	uint32	mFrame = 0;
+	float	mAxisValue = 0.f;
+	float	mDeltaTime = 0.f;
+	uint32	mChecksum = 0;//チェックサムの時はmDeltaTimeがそのフレームの時間
+	FVector	mCheckPos = FVector::ZeroVector;//ズレた時の距離表示用
+	uint8	mKeyId = 0;
+	uint8	mInputEventId = 0;
+	uint8	mControllerId = 0;
+	bool	mbBegin = false;
+	bool	mbChecksum = false;
+	FCSDebugAutoPilotRecordKeyframePtr	mKeyframe;//キーフレームの時だけ
+
+	bool	IsInput() const { return !mbChecksum && !mKeyframe.IsValid(); }
+};
+
+/* ------------------------------------------------------------
+   !入力記録のバイナリ書き込み
+   ヘッダ(開始位置等)の後にイベントをチャンク単位で書き込む
+   チャンク毎にフレームの基準値を持つので途中で切れても直前のチャンクまでは読める
+------------------------------------------------------------ */
+class FCSDebugAutoPilotRecordWriter
+{
+public:
+	~FCSDebugAutoPilotRecordWriter();
+
+	bool	Open(const FString& InPath, const FCSDebugAutoPilotCommandList& InHeader);
+	void	Close(const uint32 InEndFrame);
+	bool	IsOpen() const { return mFileWriter != nullptr; }
+	void	WriteEvent(const FCSDebugAutoPilotRecordEvent& InEvent);
+	void	Flush();
+
+private:
+	FArchive*	mFileWriter = nullptr;
+	TArray<uint8>	mChunkBuffer;
+	FCSDebugAutoPilotCommandList	mHeader;
+	uint32	mChunkEventNum = 0;
+	uint32	mChunkBaseFrame = 0;
+	uint32	mLastFrame = 0;
+	float	mLastDeltaTime = 0.f;
+};
+
+/* ------------------------------------------------------------
+   !入力記録の逐次書き込み
+   ゲームスレッドはイベントをSPSCキューに積むだけで
+   書き込みスレッドが一定間隔でファイルへ追記する
+   落ちても最後に書いたチャンクまでは再生できる
+------------------------------------------------------------ */
+class FCSDebugAutoPilotRecordStreamWriter : public FRunnable
+{
+public:
+	virtual ~FCSDebugAutoPilotRecordStreamWriter();
+
+	bool	Start(const FString& InPath, const FCSDebugAutoPilotCommandList& InHeader);
+	void	Finish(const uint32 InEndFrame);
+	bool	IsRunning() const { return mThread != nullptr; }
+	void	PushEvent(const FCSDebugAutoPilotRecordEvent& InEvent);//ゲームスレッドからのみ
+
+	virtual uint32	Run() override;
+	virtual void	Stop() override;
+
+private:
+	void	WriteQueueEvent();
+
+private:
+	TQueue<FCSDebugAutoPilotRecordEvent, EQueueMode::Spsc>	mEventQueue;
+	FCSDebugAutoPilotRecordWriter	mWriter;
+	FRunnableThread*	mThread = nullptr;
+	FEvent*	mWakeEvent = nullptr;
+	FThreadSafeBool	mbStopRequest = false;
+	uint32	mLastPushFrame = 0;
+};
+
+/* ------------------------------------------------------------
+   !入力記録のバイナリ読み込み
+   全体を一度に読まずにチャンク単位で読み進める
+   次のチャンクはスレッドプールで先読みしておいて 使い切ったら入れ替えるだけにする
+   json等メモリ上のイベントリストを読む場合にも同じ口で扱えるように
+------------------------------------------------------------ */
+class FCSDebugAutoPilotRecordReader
+{
+	/* ------------------------------------------------------------
+	   !デコード済みのチャンク1個分
+	------------------------------------------------------------ */
+	struct FChunk
+	{
+		TArray<uint8>	mBuffer;
+		TArray<FCSDebugAutoPilotRecordEvent>	mEventList;
+		int64	mPos = 0;//チャンクのファイル位置(メモリ上なら0)
+	};
+	typedef TSharedPtr<FChunk, ESPMode::ThreadSafe>	FChunkPtr;
+
+public:
+	FCSDebugAutoPilotRecordReader();
+	~FCSDebugAutoPilotRecordReader();
+	FCSDebugAutoPilotRecordReader(const FCSDebugAutoPilotRecordReader&) = delete;
+	FCSDebugAutoPilotRecordReader&	operator=(const FCSDebugAutoPilotRecordReader&) = delete;
+	FCSDebugAutoPilotRecordReader&	operator=(FCSDebugAutoPilotRecordReader&& InOther);//別スレッドで開いた物を引き継ぐ用
+
+	bool	Open(const FString& InPath);
+	void	OpenMemory(TArray<FCSDebugAutoPilotRecordEvent>&& InEventList, const FCSDebugAutoPilotCommandList& InHeader);
+	void	Close();
+	const FCSDebugAutoPilotCommandList&	GetHeader() const { return mHeader; }
+	const FCSDebugAutoPilotRecordEvent*	PeekEvent();
+	void	PopEvent();
+	SIZE_T	GetAllocatedSize() const;
+	int64	GetChunkPos() const { return mChunk->mPos; }
+	int32	GetEventCursor() const { return mEventCursor; }
+	bool	Seek(const int64 InChunkPos, const int32 InEventCursor);
+
+private:
+	bool	ReadChunk();
+	void	StartPrefetch();
+	void	CancelPrefetch();
+	static bool	sReadChunk(FArchive& InFileReader, FChunk& OutChunk);
+
+private:
+	FArchive*	mFileReader = nullptr;//先読み中はワーカースレッドだけが触る
+	FChunkPtr	mChunk;//現在のチャンク
+	FChunkPtr	mPrefetchChunk;//次のチャンク(先読み先)
+	TFuture<bool>	mPrefetchFuture;
+	FCSDebugAutoPilotCommandList	mHeader;
+	int32	mEventCursor = 0;
+	bool	mbEnd = false;//最後まで読んだ(シークするまで読みに行かない)
+};
+
+/* ------------------------------------------------------------
+   !入力記録ファイルの入出力
+------------------------------------------------------------ */
+class FCSDebugAutoPilotRecordFile
+{
+public:
+	static const uint32	sMagic = 0x43525343;//"CSRC"
+	static const uint16	sVersion = 5;//2:チェックサム追加 3:キーフレーム追加 4:複数コントローラ 5:チェックサムにフレーム時間
+	static const int32	sChunkSize = 4 * 1024;
+	static constexpr float	sFlushIntervalSec = 1.f;//逐次書き込み時にチャンクが溜まって無くてもファイルへ書く間隔
+
+	static bool	IsBinaryPath(const FString& InPath);
+	static bool	LoadFile(const FString& InPath, FCSDebugAutoPilotCommandList& OutList);
+	static bool	SaveFile(const FString& InPath, const FCSDebugAutoPilotCommandList& InList);
+	static bool	LoadJson(const FString& InPath, FCSDebugAutoPilotCommandList& OutList);
+	static bool	SaveJson(const FString& InPath, const FCSDebugAutoPilotCommandList& InList);
+	static bool	LoadBinary(const FString& InPath, FCSDebugAutoPilotCommandList& OutList);
+	static bool	SaveBinary(const FString& InPath, const FCSDebugAutoPilotCommandList& InList);
+
+	static void	MakeEventList(TArray<FCSDebugAutoPilotRecordEvent>& OutEventList, const TArray<FCSDebugAutoPilotCommandNode>& InNodeList);
+	static void	MakeNodeList(TArray<FCSDebugAutoPilotCommandNode>& OutNodeList, const TArray<FCSDebugAutoPilotRecordEvent>& InEventList);
+
+	static void	SerializeHeader(FArchive& InArchive, FCSDebugAutoPilotCommandList& InOutHeader);
+	static void	SerializeEvent(FArchive& InArchive, FCSDebugAutoPilotRecordEvent& InOutEvent, uint32& InOutLastFrame, float& InOutLastDeltaTime);
+};
@@ -0,0 +1,351 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotRecordTool.cpp
+ * @brief 自動入力 入力記録の比較と縮小(再現する最小の入力を探す)
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotRecordTool.h"
+#include "AutoPilot/CSDebugAutoPilotRecordFile.h"
+#include "CSDebug_Subsystem.h"
+
+namespace
+{
+	/**
+	 * @brief	比較用の並び(開始フレーム,コントローラ,キー)
+	 */
+	int32	sCompareNodeKey(const FCSDebugAutoPilotCommandNode& InA, const FCSDebugAutoPilotCommandNode& InB)
+	{
+		if (InA.mBeginFrame != InB.mBeginFrame)
+		{
+			return (InA.mBeginFrame < InB.mBeginFrame) ? -1 : 1;
+		}
+		if (InA.mControllerId != InB.mControllerId)
+		{
+			return (InA.mControllerId < InB.mControllerId) ? -1 : 1;
+		}
+		if (InA.mKeyId != InB.mKeyId)
+		{
+			return (InA.mKeyId < InB.mKeyId) ? -1 : 1;
+		}
+		return 0;
+	}
+
+	void	sMakeSortedIndexList(TArray<int32>& OutIndexList, const TArray<FCSDebugAutoPilotCommandNode>& InNodeList)
+	{
+		OutIndexList.SetNumUninitialized(InNodeList.Num());
+		for (int32 i = 0; i < InNodeList.Num(); ++i)
+		{
+			OutIndexList[i] = i;
+		}
+		OutIndexList.StableSort([&InNodeList](const int32 InA, const int32 InB)
+		{
+			return sCompareNodeKey(InNodeList[InA], InNodeList[InB]) < 0;
+		});
+	}
+
+	/**
+	 * @brief	終了フレーム(0なら最後の入力の次)
+	 */
+	uint32	sGetEndFrame(const FCSDebugAutoPilotCommandList& InList)
+	{
+		if (InList.mEndFrame > 0)
+		{
+			return InList.mEndFrame;
+		}
+		uint32 EndFrame = 0;
+		for (const FCSDebugAutoPilotCommandNode& Node : InList.mList)
+		{
+			EndFrame = FMath::Max(EndFrame, Node.mEndFrame + 1);
+		}
+		return EndFrame;
+	}
+
+	FString	sNodeToString(const FCSDebugAutoPilotCommandNode& InNode)
+	{
+		return FString::Printf(TEXT("Frame %u-%u Controller %u Key %u Axis %.3f"),
+			InNode.mBeginFrame, InNode.mEndFrame, InNode.mControllerId, InNode.mKeyId, InNode.mAxisValue);
+	}
+}
+
+/**
+ * @brief	入力記録2つの比較
+ *			開始フレーム,コントローラ,キーで突き合わせて 片方にしか無い物と値が違う物を拾う
+ */
+void	FCSDebugAutoPilotRecordTool::Diff(FCSDebugAutoPilotRecordDiffResult& OutResult, const FCSDebugAutoPilotCommandList& InA, const FCSDebugAutoPilotCommandList& InB, const int32 InMaxDiffNum)
+{
+	OutResult = FCSDebugAutoPilotRecordDiffResult();
+	OutResult.mbHeaderDiff = (InA.mStartPosX != InB.mStartPosX
+		|| InA.mStartPosY != InB.mStartPosY
+		|| InA.mStartPosZ != InB.mStartPosZ
+		|| InA.mStartRotatorPitch != InB.mStartRotatorPitch
+		|| InA.mStartRotatorYaw != InB.mStartRotatorYaw
+		|| InA.mStartRotatorRoll != InB.mStartRotatorRoll
+		|| InA.mStartCameraRotatorPitch != InB.mStartCameraRotatorPitch
+		|| InA.mStartCameraRotatorYaw != InB.mStartCameraRotatorYaw
+		|| InA.mStartCameraRotatorRoll != InB.mStartCameraRotatorRoll
+		|| InA.mStartControllerPitch != InB.mStartControllerPitch
+		|| InA.mEndFrame != InB.mEndFrame
+		|| InA.mControllerNum != InB.mControllerNum);
+
+	TArray<int32> IndexListA;
+	TArray<int32> IndexListB;
+	sMakeSortedIndexList(IndexListA, InA.mList);
+	sMakeSortedIndexList(IndexListB, InB.mList);
+
+	auto AddDiff = [&OutResult, InMaxDiffNum](const int32 InIndexA, const int32 InIndexB, const uint32 InFrame)
+	{
+		OutResult.mFirstDiffFrame = FMath::Min(OutResult.mFirstDiffFrame, InFrame);
+		if (OutResult.mDiffList.Num() < InMaxDiffNum)
+		{
+			FCSDebugAutoPilotRecordDiffResult::FDiff& Diff = OutResult.mDiffList.AddDefaulted_GetRef();
+			Diff.mIndexA = InIndexA;
+			Diff.mIndexB = InIndexB;
+		}
+	};
+
+	int32 CursorA = 0;
+	int32 CursorB = 0;
+	while (CursorA < IndexListA.Num()
+		|| CursorB < IndexListB.Num())
+	{
+		const int32 IndexA = (CursorA < IndexListA.Num()) ? IndexListA[CursorA] : INDEX_NONE;
+		const int32 IndexB = (CursorB < IndexListB.Num()) ? IndexListB[CursorB] : INDEX_NONE;
+		int32 Compare = 0;
+		if (IndexA == INDEX_NONE)
+		{
+			Compare = 1;
+		}
+		else if (IndexB == INDEX_NONE)
+		{
+			Compare = -1;
+		}
+		else
+		{
+			Compare = sCompareNodeKey(InA.mList[IndexA], InB.mList[IndexB]);
+		}
+
+		if (Compare < 0)
+		{
+			++OutResult.mOnlyANum;
+			AddDiff(IndexA, INDEX_NONE, InA.mList[IndexA].mBeginFrame);
+			++CursorA;
+		}
+		else if (Compare > 0)
+		{
+			++OutResult.mOnlyBNum;
+			AddDiff(INDEX_NONE, IndexB, InB.mList[IndexB].mBeginFrame);
+			++CursorB;
+		}
+		else
+		{
+			const FCSDebugAutoPilotCommandNode& NodeA = InA.mList[IndexA];
+			const FCSDebugAutoPilotCommandNode& NodeB = InB.mList[IndexB];
+			if (NodeA.mEndFrame != NodeB.mEndFrame
+				|| !NodeA.IsSameInput(NodeB))
+			{
+				++OutResult.mChangedNum;
+				AddDiff(IndexA, IndexB, NodeA.mBeginFrame);
+			}
+			else
+			{
+				++OutResult.mSameNum;
+			}
+			++CursorA;
+			++CursorB;
+		}
+	}
+}
+
+/**
+ * @brief	比較結果のログ出力
+ */
+void	FCSDebugAutoPilotRecordTool::LogDiff(const FCSDebugAutoPilotRecordDiffResult& InResult, const FCSDebugAutoPilotCommandList& InA, const FCSDebugAutoPilotCommandList& InB)
+{
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot DiffRecord : %s Same %d OnlyA %d OnlyB %d Changed %d Header %s FirstFrame %d"),
+		InResult.IsSame() ? TEXT("Same") : TEXT("Different"),
+		InResult.mSameNum, InResult.mOnlyANum, InResult.mOnlyBNum, InResult.mChangedNum,
+		InResult.mbHeaderDiff ? TEXT("Different") : TEXT("Same"),
+		(InResult.mFirstDiffFrame != MAX_uint32) ? static_cast<int32>(InResult.mFirstDiffFrame) : INDEX_NONE);
+	if (InResult.mbHeaderDiff)
+	{
+		UE_LOG(CSDebugLog, Log, TEXT("  Header A : Pos (%.2f,%.2f,%.2f) EndFrame %u Controller %u"),
+			InA.mStartPosX, InA.mStartPosY, InA.mStartPosZ, InA.mEndFrame, InA.mControllerNum);
+		UE_LOG(CSDebugLog, Log, TEXT("  Header B : Pos (%.2f,%.2f,%.2f) EndFrame %u Controller %u"),
+			InB.mStartPosX, InB.mStartPosY, InB.mStartPosZ, InB.mEndFrame, InB.mControllerNum);
+	}
+	for (const FCSDebugAutoPilotRecordDiffResult::FDiff& Diff : InResult.mDiffList)
+	{
+		const FString TextA = (Diff.mIndexA != INDEX_NONE) ? sNodeToString(InA.mList[Diff.mIndexA]) : FString(TEXT("-"));
+		const FString TextB = (Diff.mIndexB != INDEX_NONE) ? sNodeToString(InB.mList[Diff.mIndexB]) : FString(TEXT("-"));
+		UE_LOG(CSDebugLog, Log, TEXT("  A[%d] %s | B[%d] %s"), Diff.mIndexA, *TextA, Diff.mIndexB, *TextB);
+	}
+}
+
+/**
+ * @brief	問題が再現する範囲で入力記録を小さくする
+ *			ddminでコマンドを間引いてから 終了フレームを二分探索で手前に詰める
+ *			元の入力記録で再現しなければfalse
+ */
+bool	FCSDebugAutoPilotRecordTool::Minimize(FCSDebugAutoPilotCommandList& OutList, FCSDebugAutoPilotRecordMinimizeStat& OutStat, const FCSDebugAutoPilotCommandList& InList, FPredicate InPredicate, const int32 InMaxTestNum)
+{
+	const double BeginSec = FPlatformTime::Seconds();
+	OutStat = FCSDebugAutoPilotRecordMinimizeStat();
+	OutStat.mBeginNodeNum = InList.mList.Num();
+	OutStat.mBeginEndFrame = sGetEndFrame(InList);
+
+	FCSDebugAutoPilotCommandList Candidate;
+	auto TestIndexList = [&](const TArray<int32>& InIndexList)
+	{
+		if (OutStat.mTestNum >= InMaxTestNum)
+		{
+			OutStat.mbTestLimit = true;
+			return false;
+		}
+		++OutStat.mTestNum;
+		MakeSubList(Candidate, InList, InIndexList);
+		const bool bReproduce = InPredicate(Candidate);
+		UE_LOG(CSDebugLog, Log, TEXT("AutoPilot MinimizeRecord : Test %d Node %d -> %s"),
+			OutStat.mTestNum, InIndexList.Num(), bReproduce ? TEXT("Reproduce") : TEXT("Pass"));
+		return bReproduce;
+	};
+
+	TArray<int32> IndexList;
+	IndexList.Reserve(InList.mList.Num());
+	for (int32 i = 0; i < InList.mList.Num(); ++i)
+	{
+		IndexList.Add(i);
+	}
+	if (!TestIndexList(IndexList))
+	{
+		UE_LOG(CSDebugLog, Warning, TEXT("AutoPilot MinimizeRecord : not reproduced with the original record"));
+		return false;
+	}
+
+	//入力無しでも再現するなら入力は関係ない
+	TArray<int32> TestList;
+	if (TestIndexList(TestList))
+	{
+		IndexList.Reset();
+	}
+
+	int32 Granularity = 2;
+	while (IndexList.Num() >= 2
+		&& !OutStat.mbTestLimit)
+	{
+		const int32 ChunkNum = FMath::Min(Granularity, IndexList.Num());
+		bool bReduced = false;
+
+		//1塊だけで再現するか
+		for (int32 Chunk = 0; Chunk < ChunkNum && !bReduced; ++Chunk)
+		{
+			const int32 BeginIndex = IndexList.Num() * Chunk / ChunkNum;
+			const int32 EndIndex = IndexList.Num() * (Chunk + 1) / ChunkNum;
+			TestList.Reset();
+			TestList.Append(IndexList.GetData() + BeginIndex, EndIndex - BeginIndex);
+			if (TestIndexList(TestList))
+			{
+				Swap(IndexList, TestList);
+				Granularity = 2;
+				bReduced = true;
+			}
+		}
+
+		//1塊抜いても再現するか(2分割なら上と同じなので飛ばす)
+		for (int32 Chunk = 0; Chunk < ChunkNum && !bReduced && ChunkNum > 2; ++Chunk)
+		{
+			const int32 BeginIndex = IndexList.Num() * Chunk / ChunkNum;
+			const int32 EndIndex = IndexList.Num() * (Chunk + 1) / ChunkNum;
+			TestList.Reset();
+			TestList.Append(IndexList.GetData(), BeginIndex);
+			TestList.Append(IndexList.GetData() + EndIndex, IndexList.Num() - EndIndex);
+			if (TestIndexList(TestList))
+			{
+				Swap(IndexList, TestList);
+				Granularity = FMath::Max(Granularity - 1, 2);
+				bReduced = true;
+			}
+		}
+
+		if (!bReduced)
+		{
+			if (ChunkNum >= IndexList.Num())
+			{
+				break;
+			}
+			Granularity = FMath::Min(Granularity * 2, IndexList.Num());
+		}
+	}
+
+	//残った入力で 再現する一番手前の終了フレームを探す
+	FCSDebugAutoPilotCommandList Reduced;
+	MakeSubList(Reduced, InList, IndexList);
+	uint32 LowFrame = 1;
+	uint32 HighFrame = FMath::Max(sGetEndFrame(Reduced), 1u);
+	while (LowFrame < HighFrame
+		&& OutStat.mTestNum < InMaxTestNum)
+	{
+		const uint32 MidFrame = LowFrame + (HighFrame - LowFrame) / 2;
+		TrimEndFrame(Candidate, Reduced, MidFrame);
+		++OutStat.mTestNum;
+		const bool bReproduce = InPredicate(Candidate);
+		UE_LOG(CSDebugLog, Log, TEXT("AutoPilot MinimizeRecord : Test %d EndFrame %u -> %s"),
+			OutStat.mTestNum, MidFrame, bReproduce ? TEXT("Reproduce") : TEXT("Pass"));
+		if (bReproduce)
+		{
+			HighFrame = MidFrame;
+		}
+		else
+		{
+			LowFrame = MidFrame + 1;
+		}
+	}
+	if (LowFrame < HighFrame)
+	{
+		OutStat.mbTestLimit = true;
+	}
+	TrimEndFrame(OutList, Reduced, HighFrame);
+
+	OutStat.mEndNodeNum = OutList.mList.Num();
+	OutStat.mEndEndFrame = OutList.mEndFrame;
+	OutStat.mSec = FPlatformTime::Seconds() - BeginSec;
+	UE_LOG(CSDebugLog, Log, TEXT("AutoPilot MinimizeRecord : Node %d -> %d Frame %u -> %u Test %d%s %.1fs"),
+		OutStat.mBeginNodeNum, OutStat.mEndNodeNum, OutStat.mBeginEndFrame, OutStat.mEndEndFrame,
+		OutStat.mTestNum, OutStat.mbTestLimit ? TEXT("(limit)") : TEXT(""), OutStat.mSec);
+	return true;
+}
+
+/**
+ * @brief	指定したコマンドだけの入力記録を作る(ヘッダはそのまま)
+ */
+void	FCSDebugAutoPilotRecordTool::MakeSubList(FCSDebugAutoPilotCommandList& OutList, const FCSDebugAutoPilotCommandList& InList, const TArray<int32>& InIndexList)
+{
+	OutList.CopyHeader(InList);
+	OutList.mEndFrame = sGetEndFrame(InList);
+	OutList.mList.Reset(InIndexList.Num());
+	for (const int32 Index : InIndexList)
+	{
+		FCSDebugAutoPilotCommandNode& Node = OutList.mList.Add_GetRef(InList.mList[Index]);
+		Node.mIndex = OutList.mList.Num() - 1;
+	}
+}
+
+/**
+ * @brief	指定フレームで打ち切った入力記録を作る(跨ぐ入力はそこで離す)
+ */
+void	FCSDebugAutoPilotRecordTool::TrimEndFrame(FCSDebugAutoPilotCommandList& OutList, const FCSDebugAutoPilotCommandList& InList, const uint32 InEndFrame)
+{
+	OutList.CopyHeader(InList);
+	OutList.mEndFrame = InEndFrame;
+	OutList.mList.Reset(InList.mList.Num());
+	for (const FCSDebugAutoPilotCommandNode& InNode : InList.mList)
+	{
+		if (InNode.mBeginFrame >= InEndFrame)
+		{
+			continue;
+		}
+		FCSDebugAutoPilotCommandNode& Node = OutList.mList.Add_GetRef(InNode);
+		Node.mEndFrame = FMath::Min(Node.mEndFrame, InEndFrame - 1);
+		Node.mIndex = OutList.mList.Num() - 1;
+	}
+}
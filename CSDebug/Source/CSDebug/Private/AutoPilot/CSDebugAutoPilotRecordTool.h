@@ -0,0 +1,73 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotRecordTool.h
+ * @brief 自動入力 入力記録の比較と縮小(再現する最小の入力を探す)
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+struct FCSDebugAutoPilotCommandNode;
+struct FCSDebugAutoPilotCommandList;
+
+/* ------------------------------------------------------------
+   !入力記録2つの比較結果
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotRecordDiffResult
+{
+	/* ------------------------------------------------------------
+	   !違いの1件分(片方に無い物は反対側のIndexがINDEX_NONE)
+	------------------------------------------------------------ */
+	struct FDiff
+	{
+		int32	mIndexA = INDEX_NONE;
+		int32	mIndexB = INDEX_NONE;
+	};
+
+	TArray<FDiff>	mDiffList;//開始フレーム順(InMaxDiffNumまで)
+	int32	mOnlyANum = 0;
+	int32	mOnlyBNum = 0;
+	int32	mChangedNum = 0;//開始フレームとキーは同じで 終了フレームや値が違う
+	int32	mSameNum = 0;
+	uint32	mFirstDiffFrame = MAX_uint32;
+	bool	mbHeaderDiff = false;//開始位置や終了フレーム等
+
+	bool	IsSame() const { return !mbHeaderDiff && mOnlyANum == 0 && mOnlyBNum == 0 && mChangedNum == 0; }
+};
+
+/* ------------------------------------------------------------
+   !入力記録の縮小の経過
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotRecordMinimizeStat
+{
+	int32	mBeginNodeNum = 0;
+	int32	mEndNodeNum = 0;
+	uint32	mBeginEndFrame = 0;
+	uint32	mEndEndFrame = 0;
+	int32	mTestNum = 0;//判定を呼んだ回数
+	double	mSec = 0.0;
+	bool	mbTestLimit = false;//判定回数の上限で途中まで
+};
+
+/* ------------------------------------------------------------
+   !入力記録の比較と縮小
+   縮小はコマンドを間引くdelta debugging(ddmin)の後 終了フレームを二分探索で詰める
+   判定(InPredicate)は渡した入力記録で問題が再現したらtrueを返す物
+   判定はゲームの起動等で重いので InMaxTestNum 回で打ち切ってそこまでの結果を返す
+------------------------------------------------------------ */
+class FCSDebugAutoPilotRecordTool
+{
+public:
+	typedef TFunctionRef<bool(const FCSDebugAutoPilotCommandList&)>	FPredicate;
+
+	static void	Diff(FCSDebugAutoPilotRecordDiffResult& OutResult, const FCSDebugAutoPilotCommandList& InA, const FCSDebugAutoPilotCommandList& InB, const int32 InMaxDiffNum);
+	static void	LogDiff(const FCSDebugAutoPilotRecordDiffResult& InResult, const FCSDebugAutoPilotCommandList& InA, const FCSDebugAutoPilotCommandList& InB);
+	static bool	Minimize(FCSDebugAutoPilotCommandList& OutList, FCSDebugAutoPilotRecordMinimizeStat& OutStat, const FCSDebugAutoPilotCommandList& InList, FPredicate InPredicate, const int32 InMaxTestNum);
+
+private:
+	static void	MakeSubList(FCSDebugAutoPilotCommandList& OutList, const FCSDebugAutoPilotCommandList& InList, const TArray<int32>& InIndexList);
+	static void	TrimEndFrame(FCSDebugAutoPilotCommandList& OutList, const FCSDebugAutoPilotCommandList& InList, const uint32 InEndFrame);
+};
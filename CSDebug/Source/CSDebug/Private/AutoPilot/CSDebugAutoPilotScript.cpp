@@ -0,0 +1,275 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotScript.cpp
+ * @brief 自動入力 コマンドスクリプトの解析と命令列
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotScript.h"
+#include "AutoPilot/CSDebugAutoPilotModeBase.h"
+
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	//ECSDebugAutoPilotKeyの順
+	const TCHAR* sKeyNameList[] = {
+		TEXT("Invalid"),
+		TEXT("LeftStickX"),
+		TEXT("LeftStickY"),
+		TEXT("RightStickX"),
+		TEXT("RightStickY"),
+		TEXT("Up"),
+		TEXT("Down"),
+		TEXT("Left"),
+		TEXT("Right"),
+		TEXT("L1"),
+		TEXT("L2"),
+		TEXT("L3"),
+		TEXT("R1"),
+		TEXT("R2"),
+		TEXT("R3"),
+		TEXT("Sankaku"),
+		TEXT("Shikaku"),
+		TEXT("Batsu"),
+		TEXT("Maru"),
+		TEXT("Option"),
+	};
+	static_assert(UE_ARRAY_COUNT(sKeyNameList) == static_cast<int32>(ECSDebugAutoPilotKey::Num), "sKeyNameList");
+
+	float	sGetFloat(const TArray<FString>& InTokenList, const int32 InIndex, const float InDefault)
+	{
+		return InTokenList.IsValidIndex(InIndex) ? FCString::Atof(*InTokenList[InIndex]) : InDefault;
+	}
+
+	//行頭か空白の後の # か // からがコメント
+	//Execの引数はURLやコンソールコマンドの // を含むのでコメントを探さない
+	void	sStripComment(FString& InOutLine)
+	{
+		InOutLine.TrimStartInline();
+		int32 CommandLen = 0;
+		while (CommandLen < InOutLine.Len()
+			&& !FChar::IsWhitespace(InOutLine[CommandLen]))
+		{
+			++CommandLen;
+		}
+		if (InOutLine.Left(CommandLen).Equals(TEXT("Exec"), ESearchCase::IgnoreCase))
+		{
+			return;
+		}
+		for (int32 i = 0; i < InOutLine.Len(); ++i)
+		{
+			if (i > 0
+				&& !FChar::IsWhitespace(InOutLine[i - 1]))
+			{
+				continue;
+			}
+			if (InOutLine[i] == TEXT('#')
+				|| (InOutLine[i] == TEXT('/') && i + 1 < InOutLine.Len() && InOutLine[i + 1] == TEXT('/')))
+			{
+				InOutLine.LeftInline(i);
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * @brief	キー名
+ */
+const TCHAR*	FCSDebugAutoPilotScript::sGetKeyName(const uint8 InKeyId)
+{
+	return (InKeyId < UE_ARRAY_COUNT(sKeyNameList)) ? sKeyNameList[InKeyId] : sKeyNameList[0];
+}
+
+/**
+ * @brief	キー名からECSDebugAutoPilotKeyを探す(大文字小文字は区別しない)
+ */
+bool	FCSDebugAutoPilotScript::sFindKeyId(const FString& InName, uint8& OutKeyId)
+{
+	for (uint8 i = 1; i < UE_ARRAY_COUNT(sKeyNameList); ++i)
+	{
+		if (InName.Equals(sKeyNameList[i], ESearchCase::IgnoreCase))
+		{
+			OutKeyId = i;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief	ファイルから読んで解析
+ */
+bool	FCSDebugAutoPilotScript::LoadFile(const FString& InPath, FString& OutError)
+{
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *InPath))
+	{
+		Reset();
+		OutError = FString::Printf(TEXT("failed to load %s"), *InPath);
+		return false;
+	}
+	return Compile(Text, OutError);
+}
+
+/**
+ * @brief	クリア
+ */
+void	FCSDebugAutoPilotScript::Reset()
+{
+	mOpList.Reset();
+	mStringList.Reset();
+	mLoopNum = 0;
+}
+
+/**
+ * @brief	解析して命令配列にする(失敗したら空)
+ */
+bool	FCSDebugAutoPilotScript::Compile(const FString& InText, FString& OutError)
+{
+	Reset();
+
+	TArray<FString> LineList;
+	InText.ParseIntoArrayLines(LineList, false);
+	TArray<int32> LoopStack;
+	TArray<FString> TokenList;
+	for (int32 i = 0; i < LineList.Num(); ++i)
+	{
+		FString Line = LineList[i];
+		sStripComment(Line);
+		Line.TrimStartAndEndInline();
+		if (Line.IsEmpty())
+		{
+			continue;
+		}
+
+		TokenList.Reset();
+		Line.ParseIntoArrayWS(TokenList);
+		if (!CompileLine(TokenList, Line, i + 1, LoopStack, OutError))
+		{
+			Reset();
+			return false;
+		}
+	}
+
+	if (LoopStack.Num() > 0)
+	{
+		OutError = FString::Printf(TEXT("line %d : Loop without EndLoop"), mOpList[LoopStack.Last()].mLine);
+		Reset();
+		return false;
+	}
+
+	FCSDebugAutoPilotScriptOp EndOp;
+	EndOp.mOp = ECSDebugAutoPilotScriptOp::End;
+	EndOp.mLine = LineList.Num();
+	mOpList.Add(EndOp);
+	mOpList.Shrink();
+	return true;
+}
+
+/**
+ * @brief	1行分を命令へ
+ */
+bool	FCSDebugAutoPilotScript::CompileLine(const TArray<FString>& InTokenList, const FString& InLine, const int32 InLineNo, TArray<int32>& InOutLoopStack, FString& OutError)
+{
+	const FString& Command = InTokenList[0];
+	const int32 ArgNum = InTokenList.Num() - 1;
+	FCSDebugAutoPilotScriptOp Op;
+	Op.mLine = InLineNo;
+
+	if (Command.Equals(TEXT("Press"), ESearchCase::IgnoreCase)
+		|| Command.Equals(TEXT("Hold"), ESearchCase::IgnoreCase))
+	{
+		const bool bHold = Command.Equals(TEXT("Hold"), ESearchCase::IgnoreCase);
+		if (ArgNum < (bHold ? 2 : 1)
+			|| !sFindKeyId(InTokenList[1], Op.mKeyId))
+		{
+			OutError = FString::Printf(TEXT("line %d : %s <Key> %s [Value]"), InLineNo, *Command, bHold ? TEXT("<Sec>") : TEXT("[Sec]"));
+			return false;
+		}
+		Op.mOp = bHold ? ECSDebugAutoPilotScriptOp::Hold : ECSDebugAutoPilotScriptOp::Press;
+		Op.mSec = FMath::Max(sGetFloat(InTokenList, 2, 0.f), 0.f);
+		Op.mValue = sGetFloat(InTokenList, 3, 1.f);
+	}
+	else if (Command.Equals(TEXT("Move"), ESearchCase::IgnoreCase)
+		|| Command.Equals(TEXT("Warp"), ESearchCase::IgnoreCase))
+	{
+		const bool bMove = Command.Equals(TEXT("Move"), ESearchCase::IgnoreCase);
+		if (ArgNum < 3)
+		{
+			OutError = FString::Printf(TEXT("line %d : %s <X> <Y> <Z> %s"), InLineNo, *Command, bMove ? TEXT("[Radius] [TimeoutSec]") : TEXT("[Yaw]"));
+			return false;
+		}
+		Op.mOp = bMove ? ECSDebugAutoPilotScriptOp::Move : ECSDebugAutoPilotScriptOp::Warp;
+		Op.mPos = FVector(sGetFloat(InTokenList, 1, 0.f), sGetFloat(InTokenList, 2, 0.f), sGetFloat(InTokenList, 3, 0.f));
+		if (bMove)
+		{
+			Op.mValue = FMath::Max(sGetFloat(InTokenList, 4, 50.f), 1.f);
+			Op.mSec = FMath::Max(sGetFloat(InTokenList, 5, 0.f), 0.f);
+		}
+		else
+		{
+			Op.mValue = sGetFloat(InTokenList, 4, 0.f);
+			Op.mArg = (ArgNum >= 4) ? 1 : 0;//Yaw指定の有無
+		}
+	}
+	else if (Command.Equals(TEXT("Wait"), ESearchCase::IgnoreCase))
+	{
+		if (ArgNum < 1)
+		{
+			OutError = FString::Printf(TEXT("line %d : Wait <Sec>"), InLineNo);
+			return false;
+		}
+		Op.mOp = ECSDebugAutoPilotScriptOp::Wait;
+		Op.mSec = FMath::Max(sGetFloat(InTokenList, 1, 0.f), 0.f);
+	}
+	else if (Command.Equals(TEXT("WaitUntil"), ESearchCase::IgnoreCase))
+	{
+		if (ArgNum < 1)
+		{
+			OutError = FString::Printf(TEXT("line %d : WaitUntil <Condition> [TimeoutSec]"), InLineNo);
+			return false;
+		}
+		Op.mOp = ECSDebugAutoPilotScriptOp::WaitUntil;
+		Op.mArg = mStringList.Add(InTokenList[1]);
+		Op.mSec = FMath::Max(sGetFloat(InTokenList, 2, 0.f), 0.f);
+	}
+	else if (Command.Equals(TEXT("Exec"), ESearchCase::IgnoreCase))
+	{
+		const FString ExecCommand = InLine.Mid(Command.Len()).TrimStart();
+		if (ExecCommand.IsEmpty())
+		{
+			OutError = FString::Printf(TEXT("line %d : Exec <ConsoleCommand>"), InLineNo);
+			return false;
+		}
+		Op.mOp = ECSDebugAutoPilotScriptOp::Exec;
+		Op.mArg = mStringList.Add(ExecCommand);
+	}
+	else if (Command.Equals(TEXT("Loop"), ESearchCase::IgnoreCase))
+	{
+		Op.mOp = ECSDebugAutoPilotScriptOp::Loop;
+		Op.mArg = FMath::Max(FMath::RoundToInt(sGetFloat(InTokenList, 1, 0.f)), 0);
+		Op.mLoopIndex = mLoopNum++;
+		InOutLoopStack.Push(mOpList.Num());
+	}
+	else if (Command.Equals(TEXT("EndLoop"), ESearchCase::IgnoreCase))
+	{
+		if (InOutLoopStack.Num() == 0)
+		{
+			OutError = FString::Printf(TEXT("line %d : EndLoop without Loop"), InLineNo);
+			return false;
+		}
+		Op.mOp = ECSDebugAutoPilotScriptOp::EndLoop;
+		Op.mArg = InOutLoopStack.Pop();
+		Op.mLoopIndex = mOpList[Op.mArg].mLoopIndex;
+	}
+	else
+	{
+		OutError = FString::Printf(TEXT("line %d : unknown command %s"), InLineNo, *Command);
+		return false;
+	}
+
+	mOpList.Add(Op);
+	return true;
+}
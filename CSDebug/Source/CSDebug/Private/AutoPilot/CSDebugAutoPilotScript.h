@@ -0,0 +1,81 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotScript.h
+ * @brief 自動入力 コマンドスクリプトの解析と命令列
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* ------------------------------------------------------------
+   !命令の種類
+------------------------------------------------------------ */
+enum class ECSDebugAutoPilotScriptOp : uint8
+{
+	Invalid,
+	Press,//キー入力開始(待たない)
+	Hold,//キー入力して離すまで待つ
+	Move,//指定位置まで左スティックで移動
+	Wait,//指定秒数待つ
+	WaitUntil,//条件を満たすまで待つ
+	Warp,//Pawnを指定位置へ
+	Exec,//コンソールコマンド
+	Loop,
+	EndLoop,
+	End,
+};
+
+/* ------------------------------------------------------------
+   !命令1つ分
+   実行時は配列を先頭から順に進めるだけ(ループは飛び先のIndex)
+------------------------------------------------------------ */
+struct FCSDebugAutoPilotScriptOp
+{
+	FVector	mPos = FVector::ZeroVector;//Move,Warpの位置
+	float	mSec = 0.f;//入力時間,待ち時間,タイムアウト(0なら無し)
+	float	mValue = 0.f;//入力値,Moveの到着半径,WarpのYaw
+	int32	mArg = 0;//Loop:回数(0なら無限) EndLoop:Loopの命令Index Exec,WaitUntil:文字列Index Warp:Yaw指定の有無
+	int32	mLoopIndex = 0;//Loop,EndLoop:ループカウンタのIndex
+	int32	mLine = 0;//スクリプトの行(ログ用)
+	ECSDebugAutoPilotScriptOp	mOp = ECSDebugAutoPilotScriptOp::Invalid;
+	uint8	mKeyId = 0;//ECSDebugAutoPilotKey
+};
+
+/* ------------------------------------------------------------
+   !コマンドスクリプト
+   1行1命令のテキストを一度だけ解析して命令配列にする
+
+   Press <Key> [Sec] [Value]     キー入力開始(Sec省略で1フレーム Valueはスティック用)
+   Hold <Key> <Sec> [Value]      キー入力して離すまで待つ
+   Move <X> <Y> <Z> [Radius] [TimeoutSec]  左スティックで移動(Radius省略で50)
+   Wait <Sec>
+   WaitUntil <Condition> [TimeoutSec]      Grounded,Stopped か UCSDebugAutoPilotComponentに登録した条件名
+   Warp <X> <Y> <Z> [Yaw]
+   Exec <ConsoleCommand...>
+   Loop [Count] ～ EndLoop       Count省略か0で無限
+   行頭か空白の後の # か // 以降はコメント(Execの引数はURL等に//を含むのでそのまま)
+------------------------------------------------------------ */
+class FCSDebugAutoPilotScript
+{
+public:
+	bool	Compile(const FString& InText, FString& OutError);
+	bool	LoadFile(const FString& InPath, FString& OutError);
+	void	Reset();
+
+	const TArray<FCSDebugAutoPilotScriptOp>&	GetOpList() const { return mOpList; }
+	const FString&	GetString(const int32 InIndex) const { return mStringList[InIndex]; }
+	int32	GetLoopNum() const { return mLoopNum; }
+
+	static const TCHAR*	sGetKeyName(const uint8 InKeyId);
+	static bool	sFindKeyId(const FString& InName, uint8& OutKeyId);
+
+private:
+	bool	CompileLine(const TArray<FString>& InTokenList, const FString& InLine, const int32 InLineNo, TArray<int32>& InOutLoopStack, FString& OutError);
+
+private:
+	TArray<FCSDebugAutoPilotScriptOp>	mOpList;
+	TArray<FString>	mStringList;
+	int32	mLoopNum = 0;
+};
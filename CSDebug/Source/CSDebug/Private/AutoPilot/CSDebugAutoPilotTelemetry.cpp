@@ -0,0 +1,184 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotTelemetry.cpp
+ * @brief 自動入力 再生フレーム毎の負荷計測
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#include "AutoPilot/CSDebugAutoPilotTelemetry.h"
+
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UObjectGlobals.h"
+
+FCSDebugAutoPilotTelemetry::FCSDebugAutoPilotTelemetry()
+	: mFrameList(0)
+{
+}
+
+FCSDebugAutoPilotTelemetry::~FCSDebugAutoPilotTelemetry()
+{
+	End();
+}
+
+/**
+ * @brief	計測開始
+ *			リングの確保とGC,スポーンの監視登録
+ */
+void	FCSDebugAutoPilotTelemetry::Begin(UWorld* InWorld, const int32 InFrameNum)
+{
+	End();
+
+	mFrameList.ChangeSize(FMath::Max(InFrameNum, 1));
+	mWorld = InWorld;
+	mPreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FCSDebugAutoPilotTelemetry::OnPreGarbageCollect);
+	mPostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FCSDebugAutoPilotTelemetry::OnPostGarbageCollect);
+	if (InWorld)
+	{
+		mActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FCSDebugAutoPilotTelemetry::OnActorSpawned));
+	}
+	mLastCaptureSec = FPlatformTime::Seconds();
+	mGCSec = 0.0;
+	mSpawnActorNum = 0;
+	mbActive = true;
+}
+
+/**
+ * @brief	計測終了(記録済みのフレームは残す)
+ */
+void	FCSDebugAutoPilotTelemetry::End()
+{
+	if (!mbActive)
+	{
+		return;
+	}
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(mPreGCHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(mPostGCHandle);
+	if (UWorld* World = mWorld.Get())
+	{
+		World->RemoveOnActorSpawnedHandler(mActorSpawnedHandle);
+	}
+	mPreGCHandle.Reset();
+	mPostGCHandle.Reset();
+	mActorSpawnedHandle.Reset();
+	mWorld.Reset();
+	mbActive = false;
+}
+
+/**
+ * @brief	1フレーム分を記録
+ */
+void	FCSDebugAutoPilotTelemetry::Capture(const uint32 InPlayFrame)
+{
+	if (!mbActive)
+	{
+		return;
+	}
+
+	const double NowSec = FPlatformTime::Seconds();
+	FFrame Frame;
+	Frame.mPlayFrame = InPlayFrame;
+	Frame.mFrameMs = static_cast<float>((NowSec - mLastCaptureSec) * 1000.0);
+	Frame.mGameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Frame.mRenderThreadMs = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+	Frame.mGCMs = static_cast<float>(mGCSec * 1000.0);
+	Frame.mSpawnActorNum = mSpawnActorNum;
+	mFrameList.Push(Frame);
+
+	mLastCaptureSec = NowSec;
+	mGCSec = 0.0;
+	mSpawnActorNum = 0;
+}
+
+/**
+ * @brief	ファイル出力(拡張子が.csvならテキスト それ以外はバイナリ)
+ */
+bool	FCSDebugAutoPilotTelemetry::Export(const FString& InPath) const
+{
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(InPath), true);
+	if (FPaths::GetExtension(InPath) == TEXT("csv"))
+	{
+		return ExportCsv(InPath);
+	}
+	return ExportBinary(InPath);
+}
+
+/**
+ * @brief	CSV出力
+ */
+bool	FCSDebugAutoPilotTelemetry::ExportCsv(const FString& InPath) const
+{
+	const int32 FrameNum = mFrameList.GetListNum();
+	FString Text;
+	Text.Reserve((FrameNum + 1) * 48);
+	Text += TEXT("PlayFrame,FrameMs,GameThreadMs,RenderThreadMs,GCMs,SpawnActorNum\n");
+	for (int32 i = 0; i < FrameNum; ++i)
+	{
+		const FFrame& Frame = mFrameList.GetOrder(i);
+		Text += FString::Printf(TEXT("%u,%.3f,%.3f,%.3f,%.3f,%u\n"),
+			Frame.mPlayFrame, Frame.mFrameMs, Frame.mGameThreadMs, Frame.mRenderThreadMs, Frame.mGCMs, Frame.mSpawnActorNum);
+	}
+	return FFileHelper::SaveStringToFile(Text, *InPath);
+}
+
+/**
+ * @brief	バイナリ出力
+ *			[Magic][Version][FrameNum] の後に1フレーム24Byte
+ */
+bool	FCSDebugAutoPilotTelemetry::ExportBinary(const FString& InPath) const
+{
+	const int32 FrameNum = mFrameList.GetListNum();
+	TArray<uint8> Buffer;
+	Buffer.Reserve(10 + FrameNum * sizeof(FFrame));
+	FMemoryWriter Writer(Buffer);
+	uint32 Magic = sMagic;
+	uint16 Version = sVersion;
+	uint32 Num = static_cast<uint32>(FrameNum);
+	Writer << Magic;
+	Writer << Version;
+	Writer << Num;
+	for (int32 i = 0; i < FrameNum; ++i)
+	{
+		FFrame Frame = mFrameList.GetOrder(i);
+		Writer << Frame.mPlayFrame;
+		Writer << Frame.mFrameMs;
+		Writer << Frame.mGameThreadMs;
+		Writer << Frame.mRenderThreadMs;
+		Writer << Frame.mGCMs;
+		Writer << Frame.mSpawnActorNum;
+	}
+	return FFileHelper::SaveArrayToFile(Buffer, *InPath);
+}
+
+/**
+ * @brief	GC開始
+ */
+void	FCSDebugAutoPilotTelemetry::OnPreGarbageCollect()
+{
+	mGCBeginSec = FPlatformTime::Seconds();
+}
+
+/**
+ * @brief	GC終了
+ */
+void	FCSDebugAutoPilotTelemetry::OnPostGarbageCollect()
+{
+	if (mGCBeginSec > 0.0)
+	{
+		mGCSec += FPlatformTime::Seconds() - mGCBeginSec;
+		mGCBeginSec = 0.0;
+	}
+}
+
+/**
+ * @brief	アクターのスポーン
+ */
+void	FCSDebugAutoPilotTelemetry::OnActorSpawned(AActor* InActor)
+{
+	++mSpawnActorNum;
+}
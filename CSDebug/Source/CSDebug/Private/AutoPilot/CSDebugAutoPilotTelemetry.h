@@ -0,0 +1,70 @@
+// Copyright 2021 SensyuGames.
+/**
+ * @file CSDebugAutoPilotTelemetry.h
+ * @brief 自動入力 再生フレーム毎の負荷計測
+ * @author SensyuGames
+ * @date 2026/10/17
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CSDebug_LoopOrderArray.h"
+
+class UWorld;
+class AActor;
+
+/* ------------------------------------------------------------
+   !再生フレーム毎の負荷計測
+   入力は毎回同じなので 別ビルドの結果とmPlayFrameで突き合わせて比較できる
+   リングは再生開始時に確保して 計測中は確保しない
+------------------------------------------------------------ */
+class FCSDebugAutoPilotTelemetry
+{
+public:
+	static const uint32	sMagic = 0x4C545343;//"CSTL"
+	static const uint16	sVersion = 1;
+
+	/* ------------------------------------------------------------
+	   !1フレーム分
+	------------------------------------------------------------ */
+	struct FFrame
+	{
+		uint32	mPlayFrame = 0;
+		float	mFrameMs = 0.f;//前回の記録からの実時間
+		float	mGameThreadMs = 0.f;//GGameThreadTime(前フレーム分)
+		float	mRenderThreadMs = 0.f;//GRenderThreadTime(前フレーム分)
+		float	mGCMs = 0.f;
+		uint32	mSpawnActorNum = 0;
+	};
+
+public:
+	FCSDebugAutoPilotTelemetry();
+	~FCSDebugAutoPilotTelemetry();
+
+	void	Begin(UWorld* InWorld, const int32 InFrameNum);
+	void	End();
+	bool	IsActive() const { return mbActive; }
+	void	Capture(const uint32 InPlayFrame);
+	const TCSDebug_LoopOrderArray<FFrame>&	GetFrameList() const { return mFrameList; }
+
+	bool	Export(const FString& InPath) const;
+	bool	ExportCsv(const FString& InPath) const;
+	bool	ExportBinary(const FString& InPath) const;
+
+private:
+	void	OnPreGarbageCollect();
+	void	OnPostGarbageCollect();
+	void	OnActorSpawned(AActor* InActor);
+
+private:
+	TCSDebug_LoopOrderArray<FFrame>	mFrameList;
+	TWeakObjectPtr<UWorld>	mWorld;
+	FDelegateHandle	mPreGCHandle;
+	FDelegateHandle	mPostGCHandle;
+	FDelegateHandle	mActorSpawnedHandle;
+	double	mLastCaptureSec = 0.0;
+	double	mGCBeginSec = 0.0;
+	double	mGCSec = 0.0;//前回の記録から溜まったGC時間
+	uint32	mSpawnActorNum = 0;//前回の記録から溜まったスポーン数
+	bool	mbActive = false;
+};
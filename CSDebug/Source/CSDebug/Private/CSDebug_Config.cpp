@@ -66,6 +66,9 @@ UCSDebug_Config::UCSDebug_Config()
 	mDebugCommand_DebugCameraKey.mKeyboad = EKeys::Three;
 	mDebugCommand_DebugCameraKey.mPad = EKeys::Gamepad_DPad_Down;
 
+	mDebugCommand_DumpRollingRecordKey.mKeyboad = EKeys::Four;
+	mDebugCommand_DumpRollingRecordKey.mPad = EKeys::Gamepad_DPad_Left;
+
 	mDebugSelect_SelectKey.mKeyboad = EKeys::LeftMouseButton;
 	mDebugSelect_SelectKey.mPad = EKeys::Gamepad_FaceButton_Right;
 
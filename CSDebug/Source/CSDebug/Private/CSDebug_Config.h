@@ -1,7 +1,7 @@
 // Copyright 2020 SensyuGames.
 /**
  * @file CSDebug_Config.h
- * @brief CSDebugpConfig
+ * @brief CSDebug用のConfig
  * @author SensyuGames
  * @date 2020/5/26
  */
@@ -36,6 +36,30 @@ struct FCSDebugSecretCommand
 	TArray<FKey> mKeyList;
 };
 
+UENUM()
+enum class ECSDebugAutoPilotRandomHoldType : uint8
+{
+	Uniform,//Min～Maxで均等
+	Exponential,//Min寄りの短い入力が多く たまにMaxまでの長押し
+};
+
+USTRUCT(BlueprintType)
+struct FCSDebugAutoPilotRandomKey
+{
+	GENERATED_USTRUCT_BODY();
+
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	FKey	mKey;//パッドのキー(スティックは軸)
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	float	mWeight = 1.f;//入力開始時に選ばれる重み
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	float	mHoldMinSec = 0.1f;
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	float	mHoldMaxSec = 0.5f;
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	ECSDebugAutoPilotRandomHoldType	mHoldType = ECSDebugAutoPilotRandomHoldType::Uniform;
+};
+
 /**
  * 
  */
@@ -62,6 +86,9 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = CSDebugCommand)
 	FCSDebugKey	mDebugCommand_DebugCameraKey;
 
+	UPROPERTY(EditAnywhere, config, Category = CSDebugCommand)
+	FCSDebugKey	mDebugCommand_DumpRollingRecordKey;
+
 	UPROPERTY(EditAnywhere, config, Category = CSDebugCommand)
 	TMap<FString, FCSDebugSecretCommand> mDebugSecretCommand;
 	
@@ -84,4 +111,33 @@ public:
 	FCSDebugKey	mDebugMenu_RightKey;
 	UPROPERTY(EditAnywhere, config, Category = CSDebugMenu)
 	FCSDebugKey	mDebugMenu_LeftKey;
+
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	float	mAutoPilot_RollingRecordSec = 60.f;//常時記録で保持する秒数(30fps換算)
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	bool	mAutoPilot_bRollingRecordAutoStart = false;//ローカルプレイヤーのBeginPlayで常時記録を始める(起動引数-CSDebugAutoPilotRollingRecordでも)
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	float	mAutoPilot_BatchHitchMilliSec = 50.f;//一括再生時にヒッチとして数えるフレーム時間
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	float	mAutoPilot_BatchTimeoutSec = 60.f;//一括再生時にロードや開始待ちを諦めるまでの時間(再生中は記録の長さにこれを足した時間)
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	int32	mAutoPilot_TelemetryFrameNum = 30 * 60 * 30;//再生時の負荷計測で保持するフレーム数
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	float	mAutoPilot_KeyframeIntervalSec = 5.f;//記録時にキーフレームを書く間隔(再生時のシーク単位)
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	float	mAutoPilot_SeekStepSec = 10.f;//DebugMenuから再生を進める/戻す秒数
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	bool	mAutoPilot_bRecordAllLocalPlayer = false;//画面分割等で他のローカルプレイヤーの入力も一緒に記録する
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	bool	mAutoPilot_bRecordVariableFrameRate = false;//フレームレートを固定せずに記録する(フレーム毎の時間も書くので時間基準で再生できる)
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	bool	mAutoPilot_bPlayTimeBased = false;//入力記録をフレームではなく記録時の時間基準で再生する(フレームレートは固定しない)
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	TArray<FCSDebugAutoPilotRandomKey>	mAutoPilot_RandomKeyList;//ランダム入力で使うキー(空なら全キー均等)
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	int32	mAutoPilot_RandomSeed = 0;//ランダム入力のシード(0なら開始時刻から決めてログに出す)
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	float	mAutoPilot_RandomInputPerSec = 4.f;//ランダム入力で1秒当たりに新しく始める入力数
+	UPROPERTY(EditAnywhere, config, Category = CSDebugAutoPilot)
+	bool	mAutoPilot_bRandomRecord = true;//ランダム入力を入力記録としても書き出す
 };
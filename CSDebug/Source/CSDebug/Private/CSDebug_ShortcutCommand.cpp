@@ -10,6 +10,7 @@
 #include "CSDebug_Subsystem.h"
 #include "CSDebug_Config.h"
 #include "DebugMenu/CSDebug_DebugMenuManager.h"
+#include "AutoPilot/CSDebugAutoPilotComponent.h"
 
 #include "Engine/Canvas.h"
 #include "GameFramework/PlayerInput.h"
@@ -36,7 +37,48 @@ void	UCSDebug_ShortcutCommand::Init()
 	UCSDebug_DebugMenuManager* DebugMenuManager = UCSDebug_DebugMenuManager::sGet(this);
 
 	const FString BaseDebugMenuPath(TEXT("CSDebug/DebugCommand"));
-	DebugMenuManager->AddNode_Bool(BaseDebugMenuPath, FString(TEXT("DebugStopOnDebugMenu")), false);
+	mMenuValue_DebugStopOnDebugMenu = DebugMenuManager->AddNode_Bool(BaseDebugMenuPath, FString(TEXT("DebugStopOnDebugMenu")), false);
+	mbRequestDebugStopOnDebugMenu = mMenuValue_DebugStopOnDebugMenu.Get();
+	mDebugStopOnDebugMenuChangedHandle = DebugMenuManager->SubscribeNodeValueChanged(mMenuValue_DebugStopOnDebugMenu, FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate::CreateUObject(this, &UCSDebug_ShortcutCommand::OnChangeDebugStopOnDebugMenu));
+
+	const FString AutoPilotDebugMenuPath(TEXT("CSDebug/AutoPilot"));
+	{
+		const auto& Delegate = FCSDebug_DebugMenuNodeActionDelegate::CreateUObject(this, &UCSDebug_ShortcutCommand::OnBeginRollingRecord);
+		DebugMenuManager->AddNode_Button(AutoPilotDebugMenuPath, FString(TEXT("BeginRollingRecord")), Delegate);
+	}
+	{
+		const auto& Delegate = FCSDebug_DebugMenuNodeActionDelegate::CreateUObject(this, &UCSDebug_ShortcutCommand::OnDumpRollingRecord);
+		DebugMenuManager->AddNode_Button(AutoPilotDebugMenuPath, FString(TEXT("DumpRollingRecord")), Delegate);
+	}
+	{
+		const auto& Delegate = FCSDebug_DebugMenuNodeActionDelegate::CreateUObject(this, &UCSDebug_ShortcutCommand::OnSeekForwardPlayRecord);
+		DebugMenuManager->AddNode_Button(AutoPilotDebugMenuPath, FString(TEXT("SeekForwardPlayRecord")), Delegate);
+	}
+	{
+		const auto& Delegate = FCSDebug_DebugMenuNodeActionDelegate::CreateUObject(this, &UCSDebug_ShortcutCommand::OnSeekBackPlayRecord);
+		DebugMenuManager->AddNode_Button(AutoPilotDebugMenuPath, FString(TEXT("SeekBackPlayRecord")), Delegate);
+	}
+	{
+		const auto& Delegate = FCSDebug_DebugMenuNodeActionDelegate::CreateUObject(this, &UCSDebug_ShortcutCommand::OnBeginRandom);
+		DebugMenuManager->AddNode_Button(AutoPilotDebugMenuPath, FString(TEXT("BeginRandom")), Delegate);
+	}
+	{
+		const auto& Delegate = FCSDebug_DebugMenuNodeActionDelegate::CreateUObject(this, &UCSDebug_ShortcutCommand::OnEndRandom);
+		DebugMenuManager->AddNode_Button(AutoPilotDebugMenuPath, FString(TEXT("EndRandom")), Delegate);
+	}
+}
+
+/**
+ * @brief	Exit
+ */
+void	UCSDebug_ShortcutCommand::Exit()
+{
+	const UCSDebug_Subsystem* CSDebugSubsystem = GetTypedOuter<UCSDebug_Subsystem>();
+	if (UCSDebug_DebugMenuManager* DebugMenuManager = CSDebugSubsystem ? CSDebugSubsystem->GetDebugMenuManager() : nullptr)
+	{
+		DebugMenuManager->Unsubscribe(mDebugStopOnDebugMenuChangedHandle);
+	}
+	mDebugStopOnDebugMenuChangedHandle.Reset();
 }
 /**
  * @brief	Tick
@@ -57,7 +99,6 @@ bool	UCSDebug_ShortcutCommand::DebugTick(float InDeltaSecond)
 
 	UCSDebug_Subsystem* CSDebug = Cast<UCSDebug_Subsystem>(GetOuter());
 	UCSDebug_DebugMenuManager* DebugMenuManager = CSDebug->GetDebugMenuManager();
-	mbRequestDebugStopOnDebugMenu = DebugMenuManager->GetNodeValue_Bool(FString(TEXT("CSDebug/DebugCommand/DebugStopOnDebugMenu")));
     if (!DebugMenuManager->IsActive())
 	{
 		CheckDebugStep(PlayerController, InDeltaSecond);
@@ -89,6 +130,12 @@ bool	UCSDebug_ShortcutCommand::DebugTick(float InDeltaSecond)
 			PlayerController->ConsoleCommand(FString(TEXT("ToggleDebugCamera")));
 			return true;
 		}
+		//常時記録してる直近の入力を保存
+		else if (CSDebugConfig->mDebugCommand_DumpRollingRecordKey.IsJustPressed(*PlayerInput))
+		{
+			DumpRollingRecord(PlayerController);
+			return true;
+		}
     }
 
     return true;
@@ -354,4 +401,102 @@ void	UCSDebug_ShortcutCommand::SetStopMotionBlur(bool bInStop, APlayerController
     InPlayerController->ConsoleCommand(FString(TEXT("Show MotionBlur")));
 }
 
+/**
+ * @brief	AutoPilotで常時記録してる直近の入力を保存
+ */
+void	UCSDebug_ShortcutCommand::DumpRollingRecord(APlayerController* InPlayerController)
+{
+	UCSDebugAutoPilotComponent* AutoPilotComponent = InPlayerController ? InPlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+	if (AutoPilotComponent == nullptr)
+	{
+		return;
+	}
+
+	const FString FileName = FString::Printf(TEXT("RollingRecord_%s"), *FDateTime::Now().ToString());
+	AutoPilotComponent->DumpRollingRecord(FileName);
+}
+
+/**
+ * @brief	DebugMenuから常時記録開始
+ */
+void	UCSDebug_ShortcutCommand::OnBeginRollingRecord(const FCSDebug_DebugMenuNodeActionParameter& InParameter)
+{
+	APlayerController* PlayerController = InParameter.mPlayerController.Get();
+	UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+	if (AutoPilotComponent)
+	{
+		AutoPilotComponent->RequestBeginRollingRecord();
+	}
+}
+
+/**
+ * @brief	DebugMenuから常時記録の保存
+ */
+void	UCSDebug_ShortcutCommand::OnDumpRollingRecord(const FCSDebug_DebugMenuNodeActionParameter& InParameter)
+{
+	DumpRollingRecord(InParameter.mPlayerController.Get());
+}
+
+/**
+ * @brief	DebugMenuから入力記録の再生を進める
+ */
+void	UCSDebug_ShortcutCommand::OnSeekForwardPlayRecord(const FCSDebug_DebugMenuNodeActionParameter& InParameter)
+{
+	APlayerController* PlayerController = InParameter.mPlayerController.Get();
+	UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+	if (AutoPilotComponent)
+	{
+		const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+		AutoPilotComponent->SeekPlayRecord(CSDebugConfig->mAutoPilot_SeekStepSec);
+	}
+}
+
+/**
+ * @brief	DebugMenuから入力記録の再生を戻す
+ */
+void	UCSDebug_ShortcutCommand::OnSeekBackPlayRecord(const FCSDebug_DebugMenuNodeActionParameter& InParameter)
+{
+	APlayerController* PlayerController = InParameter.mPlayerController.Get();
+	UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+	if (AutoPilotComponent)
+	{
+		const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
+		AutoPilotComponent->SeekPlayRecord(-CSDebugConfig->mAutoPilot_SeekStepSec);
+	}
+}
+
+/**
+ * @brief	DebugMenuからランダム入力開始(シードはConfigか開始時刻)
+ */
+void	UCSDebug_ShortcutCommand::OnBeginRandom(const FCSDebug_DebugMenuNodeActionParameter& InParameter)
+{
+	APlayerController* PlayerController = InParameter.mPlayerController.Get();
+	UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+	if (AutoPilotComponent)
+	{
+		AutoPilotComponent->RequestBeginRandom(0, FString());
+	}
+}
+
+/**
+ * @brief	DebugMenuからランダム入力終了
+ */
+void	UCSDebug_ShortcutCommand::OnEndRandom(const FCSDebug_DebugMenuNodeActionParameter& InParameter)
+{
+	APlayerController* PlayerController = InParameter.mPlayerController.Get();
+	UCSDebugAutoPilotComponent* AutoPilotComponent = PlayerController ? PlayerController->FindComponentByClass<UCSDebugAutoPilotComponent>() : nullptr;
+	if (AutoPilotComponent)
+	{
+		AutoPilotComponent->RequestEndRandom();
+	}
+}
+
+/**
+ * @brief	デバッグメニューのDebugStopOnDebugMenuが変わった
+ */
+void	UCSDebug_ShortcutCommand::OnChangeDebugStopOnDebugMenu(const CSDebug_DebugMenuNodeBase& InNode)
+{
+	mbRequestDebugStopOnDebugMenu = InNode.GetBool();
+}
+
 #endif//USE_CSDEBUG
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "ActorSelect/CSDebug_ActorSelectManager.h"
 #include "DebugMenu/CSDebug_DebugMenuManager.h"
 #include "ScreenWindow/CSDebug_ScreenWindowManager.h"
+#include "AutoPilot/CSDebugAutoPilotBatchRunner.h"
 #include "CSDebug_Config.h"
 
 #include "Engine/Canvas.h"
@@ -75,6 +76,12 @@ void	UCSDebug_Subsystem::Initialize(FSubsystemCollectionBase& Collection)
 		mGCObject.mScreenWindowManager = NewObject<UCSDebug_ScreenWindowManager>(this);
 		mGCObject.mScreenWindowManager->Init();
 	}
+	if (mGCObject.mAutoPilotBatchRunner == nullptr
+		&& UCSDebugAutoPilotBatchRunner::sIsRequested())
+	{
+		mGCObject.mAutoPilotBatchRunner = NewObject<UCSDebugAutoPilotBatchRunner>(this);
+		mGCObject.mAutoPilotBatchRunner->Init();
+	}
 }
 /**
  * @brief Deinitialize
@@ -83,6 +90,15 @@ void	UCSDebug_Subsystem::Deinitialize()
 {
 	RequestTick(false);
 	RequestDraw(false);
+
+	if (mGCObject.mActorSelectManager)
+	{
+		mGCObject.mActorSelectManager->Exit();
+	}
+	if (mGCObject.mShortcutCommand)
+	{
+		mGCObject.mShortcutCommand->Exit();
+	}
 }
 
 /**
@@ -134,6 +150,12 @@ void	UCSDebug_Subsystem::RequestDraw(const bool bInActive)
  */
 bool	UCSDebug_Subsystem::DebugTick(float InDeltaSecond)
 {
+	//起動引数で指定されてるので設定に関わらず動かす
+	if (mGCObject.mAutoPilotBatchRunner)
+	{
+		mGCObject.mAutoPilotBatchRunner->DebugTick(InDeltaSecond);
+	}
+
 	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
 	if (!CSDebugConfig->mbActiveCSDebug)
 	{
@@ -11,6 +11,81 @@
 #include "DebugMenu/CSDebug_DebugMenuNodeButton.h"
 #include "DebugMenu/CSDebug_DebugMenuTableRow.h"
 
+#include "Engine/DataTable.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	// InOutCursorから次の/までを切り出して進める(空の区切りは飛ばす)
+	bool sNextPathSegment(const TCHAR*& InOutCursor, const TCHAR*& OutSegment, int32& OutLength)
+	{
+		while (*InOutCursor == TEXT('/'))
+		{
+			++InOutCursor;
+		}
+		if (*InOutCursor == TEXT('\0'))
+		{
+			return false;
+		}
+		OutSegment = InOutCursor;
+		while (*InOutCursor != TEXT('\0')
+			&& *InOutCursor != TEXT('/'))
+		{
+			++InOutCursor;
+		}
+		OutLength = static_cast<int32>(InOutCursor - OutSegment);
+		return true;
+	}
+
+	// 既定メニューやゲーム側のAddNode_*の分としてDataTable分に足しておく
+	constexpr SIZE_T sRuntimeNodeReserveSize = 16 * 1024;
+
+	SIZE_T sGetNodeAllocSize(const ECSDebug_DebugMenuValueKind InKind)
+	{
+		switch (InKind)
+		{
+		case ECSDebug_DebugMenuValueKind::Bool:
+			return FCSDebug_DebugMenuNodeArena::sGetAllocSize<CSDebug_DebugMenuNodeBool>();
+		case ECSDebug_DebugMenuValueKind::Int:
+			return FCSDebug_DebugMenuNodeArena::sGetAllocSize<CSDebug_DebugMenuNodeInt>();
+		case ECSDebug_DebugMenuValueKind::Float:
+			return FCSDebug_DebugMenuNodeArena::sGetAllocSize<CSDebug_DebugMenuNodeFloat>();
+		case ECSDebug_DebugMenuValueKind::List:
+		case ECSDebug_DebugMenuValueKind::Enum:
+			return FCSDebug_DebugMenuNodeArena::sGetAllocSize<CSDebug_DebugMenuNodeList>();
+		case ECSDebug_DebugMenuValueKind::Button:
+			return FCSDebug_DebugMenuNodeArena::sGetAllocSize<CSDebug_DebugMenuNodeButton>();
+		case ECSDebug_DebugMenuValueKind::Folder:
+			return FCSDebug_DebugMenuNodeArena::sGetAllocSize<CSDebug_DebugMenuNodeFolder>();
+		default:
+			return FCSDebug_DebugMenuNodeArena::sGetAllocSize<CSDebug_DebugMenuNodeBase>();
+		}
+	}
+}
+
+static FAutoConsoleCommand sCSDebugDebugMenuBenchmarkNodeValueCommand(
+	TEXT("CSDebug.DebugMenu.BenchmarkNodeValue"),
+	TEXT("CSDebug.DebugMenu.BenchmarkNodeValue [ReadNum] [FrameNum] : 1フレームにReadNum回ノードの値を読むコストを文字列変換と比較"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+	{
+		const int32 ReadNum = (InArgs.Num() > 0) ? FCString::Atoi(*InArgs[0]) : 10000;
+		const int32 FrameNum = (InArgs.Num() > 1) ? FCString::Atoi(*InArgs[1]) : 100;
+		UCSDebug_DebugMenuManager::sBenchmarkNodeValue(FMath::Max(ReadNum, 1), FMath::Max(FrameNum, 1));
+	})
+);
+
+static FAutoConsoleCommand sCSDebugDebugMenuBenchmarkInitCommand(
+	TEXT("CSDebug.DebugMenu.BenchmarkInit"),
+	TEXT("CSDebug.DebugMenu.BenchmarkInit [NodeNum] [LoopNum] : NodeNum個のDataTableからのInitとClearNodeの時間とメモリ"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+	{
+		const int32 NodeNum = (InArgs.Num() > 0) ? FCString::Atoi(*InArgs[0]) : 5000;
+		const int32 LoopNum = (InArgs.Num() > 1) ? FCString::Atoi(*InArgs[1]) : 10;
+		UCSDebug_DebugMenuManager::sBenchmarkInit(FMath::Max(NodeNum, 1), FMath::Max(LoopNum, 1));
+	})
+);
+
 UCSDebug_DebugMenuManager* UCSDebug_DebugMenuManager::sGet(const UObject* InObject)
 {
 	UGameInstance* GameInstance = InObject->GetWorld()->GetGameInstance();
@@ -18,6 +93,143 @@ UCSDebug_DebugMenuManager* UCSDebug_DebugMenuManager::sGet(const UObject* InObje
 	return CSDebugSubsystem->GetDebugMenuManager();
 }
 
+// 値を文字列で持ってた時(毎回変換)と 種類別に持ってる今の読み込みを比較
+void UCSDebug_DebugMenuManager::sBenchmarkNodeValue(const int32 InReadNum, const int32 InFrameNum)
+{
+	FCSDebug_DebugMenuNodeData BoolNodeData;
+	BoolNodeData.mDisplayName = FString(TEXT("BenchmarkBool"));
+	BoolNodeData.mKind = ECSDebug_DebugMenuValueKind::Bool;
+	BoolNodeData.mInitValue = FString(TEXT("true"));
+	FCSDebug_DebugMenuNodeData IntNodeData;
+	IntNodeData.mDisplayName = FString(TEXT("BenchmarkInt"));
+	IntNodeData.mKind = ECSDebug_DebugMenuValueKind::Int;
+	IntNodeData.mInitValue = FString(TEXT("12345"));
+	FCSDebug_DebugMenuNodeData FloatNodeData;
+	FloatNodeData.mDisplayName = FString(TEXT("BenchmarkFloat"));
+	FloatNodeData.mKind = ECSDebug_DebugMenuValueKind::Float;
+	FloatNodeData.mInitValue = FString(TEXT("1.25"));
+	CSDebug_DebugMenuNodeBool BoolNode;
+	CSDebug_DebugMenuNodeInt IntNode;
+	CSDebug_DebugMenuNodeFloat FloatNode;
+	BoolNode.Init(FString(TEXT("~")), BoolNodeData, nullptr);
+	IntNode.Init(FString(TEXT("~")), IntNodeData, nullptr);
+	FloatNode.Init(FString(TEXT("~")), FloatNodeData, nullptr);
+	const FString BoolString = BoolNode.GetValueString();
+	const FString IntString = IntNode.GetValueString();
+	const FString FloatString = FloatNode.GetValueString();
+
+	double StringSum = 0.0;
+	const double StringBeginSec = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < InFrameNum; ++Frame)
+	{
+		for (int32 i = 0; i < InReadNum; ++i)
+		{
+			switch (i % 3)
+			{
+			case 0:
+				StringSum += BoolString.ToBool() ? 1.0 : 0.0;
+				break;
+			case 1:
+				StringSum += FCString::Atoi(*IntString);
+				break;
+			default:
+				StringSum += FCString::Atof(*FloatString);
+				break;
+			}
+		}
+	}
+	const double StringSec = FPlatformTime::Seconds() - StringBeginSec;
+
+	double NativeSum = 0.0;
+	const double NativeBeginSec = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < InFrameNum; ++Frame)
+	{
+		for (int32 i = 0; i < InReadNum; ++i)
+		{
+			switch (i % 3)
+			{
+			case 0:
+				NativeSum += BoolNode.GetBool() ? 1.0 : 0.0;
+				break;
+			case 1:
+				NativeSum += IntNode.GetInt();
+				break;
+			default:
+				NativeSum += FloatNode.GetFloat();
+				break;
+			}
+		}
+	}
+	const double NativeSec = FPlatformTime::Seconds() - NativeBeginSec;
+
+	UE_LOG(CSDebugLog, Log, TEXT("DebugMenu NodeValueBenchmark Read=%d/frame Frame=%d"), InReadNum, InFrameNum);
+	UE_LOG(CSDebugLog, Log, TEXT("  String : %.3f us/frame (%.0f)"), StringSec * 1000000.0 / InFrameNum, StringSum);
+	UE_LOG(CSDebugLog, Log, TEXT("  Native : %.3f us/frame (%.0f)"), NativeSec * 1000000.0 / InFrameNum, NativeSum);
+}
+
+// 1行50個ずつ種類を混ぜたDataTableを作ってInitを繰り返す
+// 初回はチャンク確保込み 2回目以降はチャンク使い回し
+void UCSDebug_DebugMenuManager::sBenchmarkInit(const int32 InNodeNum, const int32 InLoopNum)
+{
+	const int32 RowNodeNum = 50;
+	const ECSDebug_DebugMenuValueKind KindList[] = {
+		ECSDebug_DebugMenuValueKind::Bool,
+		ECSDebug_DebugMenuValueKind::Int,
+		ECSDebug_DebugMenuValueKind::Float,
+		ECSDebug_DebugMenuValueKind::List,
+		ECSDebug_DebugMenuValueKind::Button,
+	};
+	UDataTable* DataTable = NewObject<UDataTable>(GetTransientPackage());
+	DataTable->RowStruct = FCSDebug_DebugMenuTableRow::StaticStruct();
+	for (int32 RowIndex = 0; RowIndex * RowNodeNum < InNodeNum; ++RowIndex)
+	{
+		FCSDebug_DebugMenuTableRow Row;
+		const int32 NodeNum = FMath::Min(RowNodeNum, InNodeNum - RowIndex * RowNodeNum);
+		for (int32 i = 0; i < NodeNum; ++i)
+		{
+			FCSDebug_DebugMenuNodeData& NodeData = Row.mNodeList.AddDefaulted_GetRef();
+			NodeData.mDisplayName = FString::Printf(TEXT("Node%02d"), i);
+			NodeData.mKind = KindList[i % UE_ARRAY_COUNT(KindList)];
+			if (NodeData.mKind == ECSDebug_DebugMenuValueKind::List)
+			{
+				NodeData.mList = { FString(TEXT("A")), FString(TEXT("B")), FString(TEXT("C")) };
+			}
+		}
+		DataTable->AddRow(FName(*FString::Printf(TEXT("Benchmark/Group%02d/Row%03d"), RowIndex / 10, RowIndex)), Row);
+	}
+
+	UCSDebug_DebugMenuManager* Manager = NewObject<UCSDebug_DebugMenuManager>(GetTransientPackage());
+	const double ColdBeginSec = FPlatformTime::Seconds();
+	Manager->InitNode(*DataTable);
+	const double ColdSec = FPlatformTime::Seconds() - ColdBeginSec;
+
+	double WarmSec = 0.0;
+	double ClearSec = 0.0;
+	for (int32 i = 0; i < InLoopNum; ++i)
+	{
+		const double ClearBeginSec = FPlatformTime::Seconds();
+		Manager->ClearNode();
+		const double InitBeginSec = FPlatformTime::Seconds();
+		Manager->InitNode(*DataTable);
+		const double InitEndSec = FPlatformTime::Seconds();
+		ClearSec += InitBeginSec - ClearBeginSec;
+		WarmSec += InitEndSec - InitBeginSec;
+	}
+
+	const FCSDebug_DebugMenuNodeArena& Arena = Manager->mNodeArena;
+	const SIZE_T TreeSize = Manager->mTreeNodeList.GetAllocatedSize() + Manager->mChildIndexMap.GetAllocatedSize();
+	UE_LOG(CSDebugLog, Log, TEXT("DebugMenu InitBenchmark Node=%d (Tree=%d) Loop=%d"), InNodeNum, Manager->mTreeNodeList.Num(), InLoopNum);
+	UE_LOG(CSDebugLog, Log, TEXT("  Init  : %.3f ms first / %.3f ms reuse"), ColdSec * 1000.0, WarmSec * 1000.0 / InLoopNum);
+	UE_LOG(CSDebugLog, Log, TEXT("  Clear : %.3f ms"), ClearSec * 1000.0 / InLoopNum);
+	UE_LOG(CSDebugLog, Log, TEXT("  Arena : %.1f KB used / %.1f KB reserved (%d chunk)"), Arena.GetUsedSize() / 1024.f, Arena.GetReservedSize() / 1024.f, Arena.GetChunkNum());
+	UE_LOG(CSDebugLog, Log, TEXT("  Tree  : %.1f KB"), TreeSize / 1024.f);
+
+	Manager->ClearNode();
+	Manager->mNodeArena.Empty();
+	Manager->MarkPendingKill();
+	DataTable->MarkPendingKill();
+}
+
 UCSDebug_DebugMenuManager::UCSDebug_DebugMenuManager()
 {
 }
@@ -27,47 +239,88 @@ void UCSDebug_DebugMenuManager::BeginDestroy()
 	Super::BeginDestroy();
 
 	ClearNode();
+	mNodeArena.Empty();
 }
 
 void UCSDebug_DebugMenuManager::Init()
 {
-	ClearNode();
-
 	const UCSDebug_Config* CSDebugConfig = GetDefault<UCSDebug_Config>();
 	const UDataTable* DataTable = CSDebugConfig->mDebugMenuDataTable.LoadSynchronous();
 	if (DataTable == nullptr)
 	{
+		ClearNode();
 		return;
 	}
 
-	FindOrAddFolder(mRootPath);
+	InitNode(*DataTable);
+
+	if (UCSDebug_Subsystem::sGetSaveData().GetBool(FString(TEXT("DebugMenu_AutoLoad"))))
+	{
+		Load(FCSDebug_DebugMenuNodeActionParameter());
+		mbDoneAutoLoad = true;
+	}
+}
 
-	TArray<FName> RowNameList = DataTable->GetRowNames();
+void UCSDebug_DebugMenuManager::InitNode(const UDataTable& InDataTable)
+{
+	ClearNode();
+	mbInitNode = true;
+
+	TArray<FName> RowNameList = InDataTable.GetRowNames();
+	TArray<const FCSDebug_DebugMenuTableRow*> RowList;
+	RowList.Reserve(RowNameList.Num());
+	// 先に全ノード分の大きさを数えて1回で確保する(フォルダは行毎に最大数で見積もる)
+	SIZE_T ReserveSize = sRuntimeNodeReserveSize;
+	int32 TreeNodeNum = 1;
 	for (const FName& RowName : RowNameList)
 	{
-		const FCSDebug_DebugMenuTableRow* DebugMenuTableRow = DataTable->FindRow<FCSDebug_DebugMenuTableRow>(RowName, FString());
+		const FCSDebug_DebugMenuTableRow* DebugMenuTableRow = InDataTable.FindRow<FCSDebug_DebugMenuTableRow>(RowName, FString());
+		RowList.Add(DebugMenuTableRow);
 		if (DebugMenuTableRow == nullptr)
 		{
 			continue;
 		}
 
-		FFolder NodeFolder;
+		const FString RowNameString = RowName.ToString();
+		const TCHAR* Cursor = *RowNameString;
+		const TCHAR* Segment = nullptr;
+		int32 SegmentLength = 0;
+		while (sNextPathSegment(Cursor, Segment, SegmentLength))
+		{
+			ReserveSize += sGetNodeAllocSize(ECSDebug_DebugMenuValueKind::Folder);
+			++TreeNodeNum;
+		}
+		for (const FCSDebug_DebugMenuNodeData& NodeData : DebugMenuTableRow->mNodeList)
+		{
+			ReserveSize += sGetNodeAllocSize(NodeData.mKind);
+		}
+		TreeNodeNum += DebugMenuTableRow->mNodeList.Num();
+	}
+	mNodeArena.Reserve(ReserveSize);
+	mTreeNodeList.Reserve(TreeNodeNum);
+	mChildIndexMap.Reserve(TreeNodeNum);
+
+	for (int32 i = 0; i < RowNameList.Num(); ++i)
+	{
+		const FCSDebug_DebugMenuTableRow* DebugMenuTableRow = RowList[i];
+		if (DebugMenuTableRow == nullptr)
+		{
+			continue;
+		}
+
+		const FString RowNameString = RowNameList[i].ToString();
 		for(const FCSDebug_DebugMenuNodeData& NodeData : DebugMenuTableRow->mNodeList)
 		{
-			AddNode(RowName.ToString(), NodeData);
+			AddNode(RowNameString, NodeData);
 		}
 	}
 
 	SetupDefaultMenu();
 
-	SetMainFolder(mRootPath);
-
+	mbInitNode = false;
+	BindPendingSubscription();
 
-	if (UCSDebug_Subsystem::sGetSaveData().GetBool(FString(TEXT("DebugMenu_AutoLoad"))))
-	{
-		Load(FCSDebug_DebugMenuNodeActionParameter());
-		mbDoneAutoLoad = true;
-	}
+	SetMainFolderIndex(0);
 }
 
 void UCSDebug_DebugMenuManager::DebugTick(const float InDeltaTime)
@@ -76,7 +329,8 @@ void UCSDebug_DebugMenuManager::DebugTick(const float InDeltaTime)
 	{
 		return;
 	}
-	if (mSelectNode == nullptr)
+	CSDebug_DebugMenuNodeBase* SelectNode = GetSelectNode();
+	if (SelectNode == nullptr)
 	{
 		return;
 	}
@@ -101,20 +355,20 @@ void UCSDebug_DebugMenuManager::DebugTick(const float InDeltaTime)
 	const bool bPressedSelectKey = CSDebugConfig->mDebugMenu_SelectKey.IsPressed(*PlayerInput);
 	if (CSDebugConfig->mDebugMenu_SelectKey.IsJustPressed(*PlayerInput))
 	{
-		mSelectNode->OnBeginAction();
+		SelectNode->OnBeginAction();
 	}
 	else if (CSDebugConfig->mDebugMenu_SelectKey.IsJustReleased(*PlayerInput))
 	{
 		FCSDebug_DebugMenuNodeActionParameter ActionParameter;
 		ActionParameter.mPlayerController = PlayerController;
-		mSelectNode->OnEndAction(ActionParameter);
+		SelectNode->OnEndAction(ActionParameter);
 	}
 	else if (CSDebugConfig->mDebugMenu_CancelKey.IsJustPressed(*PlayerInput))
 	{
 	}
 	else if (CSDebugConfig->mDebugMenu_UpKey.IsJustPressed(*PlayerInput))
 	{
-		mSelectNode->OnJustPressedUpKey();
+		SelectNode->OnJustPressedUpKey();
 		if (!bPressedSelectKey)
 		{
 			ChangeSelectNode(false);
@@ -122,7 +376,7 @@ void UCSDebug_DebugMenuManager::DebugTick(const float InDeltaTime)
 	}
 	else if (CSDebugConfig->mDebugMenu_DownKey.IsJustPressed(*PlayerInput))
 	{
-		mSelectNode->OnJustPressedDownKey();
+		SelectNode->OnJustPressedDownKey();
 		if (!bPressedSelectKey)
 		{
 			ChangeSelectNode(true);
@@ -130,7 +384,7 @@ void UCSDebug_DebugMenuManager::DebugTick(const float InDeltaTime)
 	}
 	else if (CSDebugConfig->mDebugMenu_LeftKey.IsJustPressed(*PlayerInput))
 	{
-		mSelectNode->OnJustPressedLeftKey();
+		SelectNode->OnJustPressedLeftKey();
 		if (!bPressedSelectKey)
 		{
 			BackMainFolder();
@@ -138,7 +392,7 @@ void UCSDebug_DebugMenuManager::DebugTick(const float InDeltaTime)
 	}
 	else if (CSDebugConfig->mDebugMenu_RightKey.IsJustPressed(*PlayerInput))
 	{
-		mSelectNode->OnJustPressedRightKey();
+		SelectNode->OnJustPressedRightKey();
 	}
 }
 
@@ -154,64 +408,79 @@ void UCSDebug_DebugMenuManager::DebugDraw(UCanvas* InCanvas)
 	DrawMainFolderPath(InCanvas, DrawPos);
 	DrawPos.Y += 20.f;
 
+	if (!mTreeNodeList.IsValidIndex(mMainFolderIndex))
+	{
+		return;
+	}
 	FVector2D SelectNodeDrawPos = DrawPos;
-	if (const FFolder* MainFolder = mFolderMap.Find(mMainFolderPath))
+	for (int32 ChildIndex = mTreeNodeList[mMainFolderIndex].mFirstChildIndex; ChildIndex != INDEX_NONE; ChildIndex = mTreeNodeList[ChildIndex].mNextSiblingIndex)
 	{
-		for(const CSDebug_DebugMenuNodeBase* Node : MainFolder->mNodeList)
+		if (mSelectIndex == ChildIndex)
 		{
-			if (mSelectNode == Node)
-			{
-				SelectNodeDrawPos = DrawPos;//選択されてるのは最後に描画したいので
-			}
-			else
-			{
-				Node->Draw(InCanvas, DrawPos, false);
-			}
-			DrawPos.Y += 20.f;
+			SelectNodeDrawPos = DrawPos;//選択されてるのは最後に描画したいので
 		}
-		if (mSelectNode)
+		else
 		{
-			mSelectNode->Draw(InCanvas, SelectNodeDrawPos, true);
+			mTreeNodeList[ChildIndex].mNode->Draw(InCanvas, DrawPos, false);
 		}
+		DrawPos.Y += 20.f;
+	}
+	if (const CSDebug_DebugMenuNodeBase* SelectNode = GetSelectNode())
+	{
+		SelectNode->Draw(InCanvas, SelectNodeDrawPos, true);
 	}
 }
 
 CSDebug_DebugMenuNodeBase* UCSDebug_DebugMenuManager::AddNode(const FString& InFolderPath, const FCSDebug_DebugMenuNodeData& InNodeData)
 {
-	const FString PathString = CheckPathString(InFolderPath);
-	const FString NodePath = FString::Printf(TEXT("%s/%s"), *PathString, *InNodeData.mDisplayName);
-	if (CSDebug_DebugMenuNodeBase** NodeBase = mNodeMap.Find(NodePath))
+	const int32 FolderIndex = FindOrAddFolderTreeIndex(InFolderPath);
+	if (FolderIndex == INDEX_NONE)
 	{
-		return *NodeBase;
+		return nullptr;
+	}
+	const FName NodeName(*InNodeData.mDisplayName);
+	if (const int32* NodeIndex = mChildIndexMap.Find(MakeTuple(FolderIndex, NodeName)))
+	{
+		// 同じパスに別の種類のノードがあったら使わない
+		CSDebug_DebugMenuNodeBase* Node = mTreeNodeList[*NodeIndex].mNode;
+		if (Node->GetNodeData().mKind != InNodeData.mKind)
+		{
+			UE_LOG(CSDebugLog, Error, TEXT("DebugMenu AddNode : %s already exists as another kind"), *Node->GetPath());
+			return nullptr;
+		}
+		return Node;
 	}
 
 	CSDebug_DebugMenuNodeBase* NewNode = nullptr;
 	switch (InNodeData.mKind)
 	{
 	case ECSDebug_DebugMenuValueKind::Bool:
-		NewNode = new CSDebug_DebugMenuNodeBool();
+		NewNode = mNodeArena.New<CSDebug_DebugMenuNodeBool>();
 		break;
 	case ECSDebug_DebugMenuValueKind::Int:
-		NewNode = new CSDebug_DebugMenuNodeInt();
+		NewNode = mNodeArena.New<CSDebug_DebugMenuNodeInt>();
 		break;
 	case ECSDebug_DebugMenuValueKind::Float:
-		NewNode = new CSDebug_DebugMenuNodeFloat();
+		NewNode = mNodeArena.New<CSDebug_DebugMenuNodeFloat>();
 		break;
 	case ECSDebug_DebugMenuValueKind::List:
 	case ECSDebug_DebugMenuValueKind::Enum:
-		NewNode = new CSDebug_DebugMenuNodeList();
+		NewNode = mNodeArena.New<CSDebug_DebugMenuNodeList>();
 		break;
 	case ECSDebug_DebugMenuValueKind::Button:
-		NewNode = new CSDebug_DebugMenuNodeButton();
+		NewNode = mNodeArena.New<CSDebug_DebugMenuNodeButton>();
 		break;
 	default:
-		NewNode = new CSDebug_DebugMenuNodeBase();
+		NewNode = mNodeArena.New<CSDebug_DebugMenuNodeBase>();
 		break;
 	}
 
-	NewNode->Init(PathString, InNodeData, this);
-	mNodeMap.Add(NewNode->GetPath(), NewNode);
-	AssignNodeToFolder(NewNode);
+	NewNode->Init(GetTreePath(FolderIndex), InNodeData, this);
+	AddTreeNode(FolderIndex, NodeName, NewNode);
+	if (!mbInitNode)
+	{
+		BindPendingSubscription();
+	}
 	if (mbDoneAutoLoad)
 	{
 		const FString SaveValue = mSaveData.GetValueString(NewNode->GetPath());
@@ -223,13 +492,31 @@ CSDebug_DebugMenuNodeBase* UCSDebug_DebugMenuManager::AddNode(const FString& InF
 	return NewNode;
 }
 
-CSDebug_DebugMenuNodeBase* UCSDebug_DebugMenuManager::AddNode_Bool(const FString& InFolderPath, const FString& InDisplayName, const bool InInitValue)
+TCSDebugMenuValue<bool> UCSDebug_DebugMenuManager::AddNode_Bool(const FString& InFolderPath, const FString& InDisplayName, const bool InInitValue)
 {
 	FCSDebug_DebugMenuNodeData NodeData;
 	NodeData.mDisplayName = InDisplayName;
 	NodeData.mKind = ECSDebug_DebugMenuValueKind::Bool;
 	NodeData.mInitValue = InInitValue ? FString(TEXT("true")) : FString(TEXT("false"));
-	return AddNode(InFolderPath, NodeData);
+	return TCSDebugMenuValue<bool>(AddNode(InFolderPath, NodeData), this);
+}
+
+TCSDebugMenuValue<int32> UCSDebug_DebugMenuManager::AddNode_Int(const FString& InFolderPath, const FString& InDisplayName, const int32 InInitValue)
+{
+	FCSDebug_DebugMenuNodeData NodeData;
+	NodeData.mDisplayName = InDisplayName;
+	NodeData.mKind = ECSDebug_DebugMenuValueKind::Int;
+	NodeData.mInitValue = FString::FromInt(InInitValue);
+	return TCSDebugMenuValue<int32>(AddNode(InFolderPath, NodeData), this);
+}
+
+TCSDebugMenuValue<float> UCSDebug_DebugMenuManager::AddNode_Float(const FString& InFolderPath, const FString& InDisplayName, const float InInitValue)
+{
+	FCSDebug_DebugMenuNodeData NodeData;
+	NodeData.mDisplayName = InDisplayName;
+	NodeData.mKind = ECSDebug_DebugMenuValueKind::Float;
+	NodeData.mInitValue = FString::SanitizeFloat(InInitValue);
+	return TCSDebugMenuValue<float>(AddNode(InFolderPath, NodeData), this);
 }
 
 CSDebug_DebugMenuNodeBase* UCSDebug_DebugMenuManager::AddNode_Button(const FString& InFolderPath, const FString& InDisplayName, const FCSDebug_DebugMenuNodeActionDelegate& InDelegate)
@@ -247,59 +534,146 @@ CSDebug_DebugMenuNodeBase* UCSDebug_DebugMenuManager::AddNode_Button(const FStri
 
 bool UCSDebug_DebugMenuManager::GetNodeValue_Bool(const FString& InPath) const
 {
-	const FString PathString = CheckPathString(InPath);
-	if (const CSDebug_DebugMenuNodeBase* const* NodePtrPtr = mNodeMap.Find(PathString))
-	{
-		if (const CSDebug_DebugMenuNodeBase* NodePtr = *NodePtrPtr)
-		{
-			return NodePtr->GetBool();
-		}
-	}
-	return false;
+	return FindNodeValue<bool>(InPath).Get();
+}
+
+int32 UCSDebug_DebugMenuManager::GetNodeValue_Int(const FString& InPath) const
+{
+	return FindNodeValue<int32>(InPath).Get();
+}
+
+float UCSDebug_DebugMenuManager::GetNodeValue_Float(const FString& InPath) const
+{
+	return FindNodeValue<float>(InPath).Get();
 }
 
 void UCSDebug_DebugMenuManager::SetNodeActionDelegate(const FString& InPath, const FCSDebug_DebugMenuNodeActionDelegate& InDelegate)
 {
-	if (CSDebug_DebugMenuNodeBase** NodePtrPtr = mNodeMap.Find(InPath))
+	if (CSDebug_DebugMenuNodeBase* NodePtr = FindDebugMenuNode(InPath))
 	{
-		if (CSDebug_DebugMenuNodeBase* NodePtr = *NodePtrPtr)
-		{
-			NodePtr->SetNodeAction(InDelegate);
-		}
+		NodePtr->SetNodeAction(InDelegate);
 	}
 }
 
-void UCSDebug_DebugMenuManager::SetMainFolder(const FString& InPath)
+FDelegateHandle UCSDebug_DebugMenuManager::SubscribeNodeValueChanged(const FString& InPath, const FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate& InDelegate)
 {
-	mMainFolderPath = InPath;
+	const int32 TreeIndex = FindTreeIndex(InPath);
+	CSDebug_DebugMenuNodeBase* Node = (TreeIndex != INDEX_NONE) ? mTreeNodeList[TreeIndex].mNode : nullptr;
+	FNodeSubscription& Subscription = mNodeSubscriptionList.AddDefaulted_GetRef();
+	Subscription.mPath = Node ? Node->GetPath() : CheckPathString(InPath);
+	Subscription.mDelegate = InDelegate;
+	Subscription.mHandle = Subscription.mDelegate.GetHandle();
+	if (Node)
+	{
+		Subscription.mTreeIndex = TreeIndex;
+		Node->GetValueChangedDelegate().Add(Subscription.mDelegate);
+	}
+	return Subscription.mHandle;
+}
 
-	FFolder& RootFolder = FindOrAddFolder(mMainFolderPath);
-	if (RootFolder.mNodeList.Num() > 0)
+FDelegateHandle UCSDebug_DebugMenuManager::SubscribeNodeValueChanged(const FCSDebug_DebugMenuValueHandle& InValue, const FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate& InDelegate)
+{
+	if (const CSDebug_DebugMenuNodeBase* Node = InValue.GetNode())
 	{
-		mSelectNode = RootFolder.mNodeList[0];
+		return SubscribeNodeValueChanged(Node->GetPath(), InDelegate);
 	}
+	return FDelegateHandle();
 }
 
-void UCSDebug_DebugMenuManager::BackMainFolder()
+FDelegateHandle UCSDebug_DebugMenuManager::SubscribeFolderValueChanged(const FString& InFolderPath, const FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate& InDelegate)
+{
+	const int32 FolderIndex = FindTreeIndex(InFolderPath);
+	FFolderSubscription& Subscription = mFolderSubscriptionList.AddDefaulted_GetRef();
+	if (FolderIndex != INDEX_NONE)
+	{
+		Subscription.mPath = GetTreePath(FolderIndex);
+	}
+	else
+	{
+		Subscription.mPath = CheckPathString(InFolderPath);
+		Subscription.mPath.RemoveFromEnd(TEXT("/"));
+	}
+	Subscription.mTreeIndex = FolderIndex;
+	Subscription.mDelegate = InDelegate;
+	Subscription.mHandle = Subscription.mDelegate.GetHandle();
+	return Subscription.mHandle;
+}
+
+void UCSDebug_DebugMenuManager::Unsubscribe(const FDelegateHandle& InHandle)
 {
-	TArray<FString> FolderList;
-	mMainFolderPath.ParseIntoArray(FolderList, TEXT("/"));
-	const int32 FolderNum = FolderList.Num();
-	if (FolderNum <= 1)
+	if (!InHandle.IsValid())
 	{
 		return;
 	}
+	const int32 RemoveNum = mFolderSubscriptionList.RemoveAll([&InHandle](const FFolderSubscription& InSubscription)
+	{
+		return InSubscription.mHandle == InHandle;
+	});
+	if (RemoveNum > 0)
+	{
+		return;
+	}
+	const int32 SubscriptionIndex = mNodeSubscriptionList.IndexOfByPredicate([&InHandle](const FNodeSubscription& InSubscription)
+	{
+		return InSubscription.mHandle == InHandle;
+	});
+	if (SubscriptionIndex == INDEX_NONE)
+	{
+		return;
+	}
+	const int32 TreeIndex = mNodeSubscriptionList[SubscriptionIndex].mTreeIndex;
+	if (mTreeNodeList.IsValidIndex(TreeIndex)
+		&& mTreeNodeList[TreeIndex].mNode)
+	{
+		mTreeNodeList[TreeIndex].mNode->GetValueChangedDelegate().Remove(InHandle);
+	}
+	mNodeSubscriptionList.RemoveAt(SubscriptionIndex);
+}
 
-	FString BackFolderPath;
-	for (int32 i = 0; i < FolderNum - 1; ++i)
+void UCSDebug_DebugMenuManager::NotifyNodeValueChanged(const CSDebug_DebugMenuNodeBase& InNode)
+{
+	const int32 NodeIndex = InNode.GetTreeIndex();
+	// 通知先で購読を増減しても大丈夫なように添字で回す
+	for (int32 i = 0; i < mFolderSubscriptionList.Num(); ++i)
 	{
-		if (i != 0)
+		const int32 FolderIndex = mFolderSubscriptionList[i].mTreeIndex;
+		if (FolderIndex == INDEX_NONE
+			|| !mTreeNodeList.IsValidIndex(NodeIndex))
 		{
-			BackFolderPath += FString::Printf(TEXT("/"));
+			continue;
 		}
-		BackFolderPath += FolderList[i];
+		// 親を辿ってフォルダ以下かどうか
+		int32 TreeIndex = mTreeNodeList[NodeIndex].mParentIndex;
+		while (TreeIndex != INDEX_NONE
+			&& TreeIndex != FolderIndex)
+		{
+			TreeIndex = mTreeNodeList[TreeIndex].mParentIndex;
+		}
+		if (TreeIndex == FolderIndex)
+		{
+			const FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate Delegate = mFolderSubscriptionList[i].mDelegate;
+			Delegate.ExecuteIfBound(InNode);
+		}
+	}
+}
+
+void UCSDebug_DebugMenuManager::SetMainFolder(const FString& InPath)
+{
+	const int32 FolderIndex = FindTreeIndex(InPath);
+	if (FolderIndex != INDEX_NONE)
+	{
+		SetMainFolderIndex(FolderIndex);
 	}
-	SetMainFolder(BackFolderPath);
+}
+
+void UCSDebug_DebugMenuManager::BackMainFolder()
+{
+	const int32 ParentIndex = mTreeNodeList.IsValidIndex(mMainFolderIndex) ? mTreeNodeList[mMainFolderIndex].mParentIndex : INDEX_NONE;
+	if (ParentIndex == INDEX_NONE)
+	{
+		return;
+	}
+	SetMainFolderIndex(ParentIndex);
 }
 
 void UCSDebug_DebugMenuManager::SetActive(const bool bInActive)
@@ -322,12 +696,31 @@ void UCSDebug_DebugMenuManager::SetupDefaultMenu()
 
 void UCSDebug_DebugMenuManager::ClearNode()
 {
-	for (auto& MapElement : mNodeMap)
+	// 実体はmNodeArenaにあるのでデストラクタだけ呼んで纏めて戻す
+	for (FTreeNode& TreeNode : mTreeNodeList)
 	{
-		CSDebug_DebugMenuNodeBase* Node = MapElement.Value;
-		delete Node;
+		if (TreeNode.mNode)
+		{
+			TreeNode.mNode->~CSDebug_DebugMenuNodeBase();
+		}
 	}
-	mNodeMap.Empty();
+	mNodeArena.Reset();
+	mTreeNodeList.Reset();
+	mChildIndexMap.Reset();
+	mTreeNodeList.AddDefaulted();//ルート
+	mMainFolderIndex = 0;
+	mSelectIndex = INDEX_NONE;
+	++mNodeGeneration;
+	// 購読は残して、ノードが追加され直した時に付け直す
+	for (FFolderSubscription& Subscription : mFolderSubscriptionList)
+	{
+		Subscription.mTreeIndex = INDEX_NONE;
+	}
+	for (FNodeSubscription& Subscription : mNodeSubscriptionList)
+	{
+		Subscription.mTreeIndex = INDEX_NONE;
+	}
+	BindPendingSubscription();
 }
 
 APlayerController* UCSDebug_DebugMenuManager::FindPlayerController() const
@@ -347,38 +740,20 @@ APlayerController* UCSDebug_DebugMenuManager::FindPlayerController() const
 
 void UCSDebug_DebugMenuManager::ChangeSelectNode(const bool bInDown)
 {
-	const FFolder* NodeFolder = mFolderMap.Find(mMainFolderPath);
-	if (NodeFolder == nullptr)
-	{
-		return;
-	}
-	const TArray<CSDebug_DebugMenuNodeBase*>& NodeList = NodeFolder->mNodeList;
-	const int32 NodeListSize = NodeList.Num();
-	if (NodeListSize <= 0)
-	{
-		return;
-	}
-	int32 SelectIndex = NodeList.Find(mSelectNode);
-	if (SelectIndex == INDEX_NONE)
+	if (!mTreeNodeList.IsValidIndex(mSelectIndex))
 	{
 		return;
 	}
+	const FTreeNode& SelectTreeNode = mTreeNodeList[mSelectIndex];
+	const FTreeNode& FolderTreeNode = mTreeNodeList[SelectTreeNode.mParentIndex];
 	if (bInDown)
 	{
-		SelectIndex = (SelectIndex + 1) % NodeListSize;
+		mSelectIndex = (SelectTreeNode.mNextSiblingIndex != INDEX_NONE) ? SelectTreeNode.mNextSiblingIndex : FolderTreeNode.mFirstChildIndex;
 	}
 	else
 	{
-		if (SelectIndex == 0)
-		{
-			SelectIndex = NodeListSize - 1;
-		}
-		else
-		{
-			SelectIndex = SelectIndex - 1;
-		}
+		mSelectIndex = (SelectTreeNode.mPrevSiblingIndex != INDEX_NONE) ? SelectTreeNode.mPrevSiblingIndex : FolderTreeNode.mLastChildIndex;
 	}
-	mSelectNode = NodeList[SelectIndex];
 }
 
 void UCSDebug_DebugMenuManager::DrawMainFolderPath(UCanvas* InCanvas, const FVector2D& InPos) const
@@ -405,95 +780,172 @@ void UCSDebug_DebugMenuManager::DrawMainFolderPath(UCanvas* InCanvas, const FVec
 	// パス表示
 	{
 		const FVector2D StringPos = InPos + StringOffset;
-		FCanvasTextItem Item(StringPos, FText::FromString(mMainFolderPath), GEngine->GetSmallFont(), FontColor);
+		FCanvasTextItem Item(StringPos, FText::FromString(GetTreePath(mMainFolderIndex)), GEngine->GetSmallFont(), FontColor);
 		Item.Scale = FVector2D(1.f);
 		InCanvas->DrawItem(Item);
 	}
 }
 
-UCSDebug_DebugMenuManager::FFolder& UCSDebug_DebugMenuManager::FindOrAddFolder(const FString& InPath)
+int32 UCSDebug_DebugMenuManager::FindTreeIndex(const FString& InPath) const
 {
-	if (FFolder* NodeFolder = mFolderMap.Find(InPath))
-	{
-		return *NodeFolder;
+	int32 TreeIndex = 0;
+	const TCHAR* Segment = nullptr;
+	int32 SegmentLength = 0;
+	const TCHAR* Cursor = *InPath;
+	bool bFirst = true;
+	while (sNextPathSegment(Cursor, Segment, SegmentLength))
+	{
+		const bool bRoot = bFirst && IsRootPathSegment(Segment, SegmentLength);
+		bFirst = false;
+		if (bRoot)
+		{
+			continue;
+		}
+		const FName SegmentName(SegmentLength, Segment, FNAME_Find);
+		if (SegmentName.IsNone())
+		{
+			return INDEX_NONE;
+		}
+		const int32* ChildIndex = mChildIndexMap.Find(MakeTuple(TreeIndex, SegmentName));
+		if (ChildIndex == nullptr)
+		{
+			return INDEX_NONE;
+		}
+		TreeIndex = *ChildIndex;
 	}
+	return TreeIndex;
+}
 
-	FFolder NodeFolder;
-	NodeFolder.mPath = InPath;
+int32 UCSDebug_DebugMenuManager::FindOrAddFolderTreeIndex(const FString& InPath)
+{
+	int32 TreeIndex = 0;
+	const TCHAR* Segment = nullptr;
+	int32 SegmentLength = 0;
+	const TCHAR* Cursor = *InPath;
+	bool bFirst = true;
+	while (sNextPathSegment(Cursor, Segment, SegmentLength))
+	{
+		const bool bRoot = bFirst && IsRootPathSegment(Segment, SegmentLength);
+		bFirst = false;
+		if (bRoot)
+		{
+			continue;
+		}
+		const FName SegmentName(SegmentLength, Segment);
+		if (const int32* ChildIndex = mChildIndexMap.Find(MakeTuple(TreeIndex, SegmentName)))
+		{
+			// フォルダと同じ名前の値のノードがあったらその下には足せない
+			const CSDebug_DebugMenuNodeBase* ChildNode = mTreeNodeList[*ChildIndex].mNode;
+			if (ChildNode->GetNodeData().mKind != ECSDebug_DebugMenuValueKind::Folder)
+			{
+				UE_LOG(CSDebugLog, Error, TEXT("DebugMenu AddNode : %s is not a folder (%s)"), *ChildNode->GetPath(), *InPath);
+				return INDEX_NONE;
+			}
+			TreeIndex = *ChildIndex;
+			continue;
+		}
 
-	return mFolderMap.Add(InPath, NodeFolder);
+		FCSDebug_DebugMenuNodeData NodeData;
+		NodeData.mKind = ECSDebug_DebugMenuValueKind::Folder;
+		NodeData.mDisplayName = FString(SegmentLength, Segment);
+		CSDebug_DebugMenuNodeFolder* NodeFolder = mNodeArena.New<CSDebug_DebugMenuNodeFolder>();
+		NodeFolder->Init(FString::Printf(TEXT("%s/%s"), *GetTreePath(TreeIndex), *NodeData.mDisplayName), NodeData, this);
+		TreeIndex = AddTreeNode(TreeIndex, SegmentName, NodeFolder);
+	}
+	return TreeIndex;
 }
 
-CSDebug_DebugMenuNodeBase* UCSDebug_DebugMenuManager::FindOrAddDebugMenuNodeFolder(const FString& InPath)
+int32 UCSDebug_DebugMenuManager::AddTreeNode(const int32 InParentIndex, const FName& InName, CSDebug_DebugMenuNodeBase* InNode)
 {
-	TArray<FString> PathList;
-	InPath.ParseIntoArray(PathList, TEXT("/"));
-	if (PathList.Num() <= 1)
+	const int32 TreeIndex = mTreeNodeList.AddDefaulted();
+	FTreeNode& TreeNode = mTreeNodeList[TreeIndex];
+	TreeNode.mNode = InNode;
+	TreeNode.mName = InName;
+	TreeNode.mParentIndex = InParentIndex;
+	InNode->SetTreeIndex(TreeIndex);
+
+	FTreeNode& ParentTreeNode = mTreeNodeList[InParentIndex];
+	if (ParentTreeNode.mLastChildIndex == INDEX_NONE)
 	{
-		return nullptr;
+		ParentTreeNode.mFirstChildIndex = TreeIndex;
 	}
-
-	if (CSDebug_DebugMenuNodeBase** NodePtrPtr = mNodeMap.Find(InPath))
+	else
 	{
-		CSDebug_DebugMenuNodeBase* NodePtr = *NodePtrPtr;
-		check(NodePtr->GetNodeData().mKind == ECSDebug_DebugMenuValueKind::Folder);
-		return NodePtr;
+		mTreeNodeList[ParentTreeNode.mLastChildIndex].mNextSiblingIndex = TreeIndex;
+		TreeNode.mPrevSiblingIndex = ParentTreeNode.mLastChildIndex;
 	}
+	ParentTreeNode.mLastChildIndex = TreeIndex;
+	mChildIndexMap.Add(MakeTuple(InParentIndex, InName), TreeIndex);
+	return TreeIndex;
+}
 
-	FCSDebug_DebugMenuNodeData NodeData;
-	NodeData.mKind = ECSDebug_DebugMenuValueKind::Folder;
-	NodeData.mDisplayName = PathList[PathList.Num() - 1];
-
-	CSDebug_DebugMenuNodeFolder* NodeFolder = new CSDebug_DebugMenuNodeFolder();
-	NodeFolder->Init(InPath, NodeData, this);
-	mNodeMap.Add(InPath, NodeFolder);
-
-	FString ParentFolderPath = PathList[0];
-	for (int32 i = 1; i < PathList.Num() - 1; ++i)
+// まだ付いてない購読のノードを木から探して付ける(パスの区切りはFNameで引くので文字列は作らない)
+void UCSDebug_DebugMenuManager::BindPendingSubscription()
+{
+	for (FFolderSubscription& Subscription : mFolderSubscriptionList)
 	{
-		ParentFolderPath += FString(TEXT("/")) + PathList[i];
+		if (Subscription.mTreeIndex == INDEX_NONE)
+		{
+			Subscription.mTreeIndex = FindTreeIndex(Subscription.mPath);
+		}
 	}
-	FFolder& Folder = FindOrAddFolder(ParentFolderPath);
-	Folder.mNodeList.Add(NodeFolder);
+	for (FNodeSubscription& Subscription : mNodeSubscriptionList)
+	{
+		if (Subscription.mTreeIndex != INDEX_NONE)
+		{
+			continue;
+		}
+		const int32 TreeIndex = FindTreeIndex(Subscription.mPath);
+		if (TreeIndex != INDEX_NONE
+			&& mTreeNodeList[TreeIndex].mNode)
+		{
+			Subscription.mTreeIndex = TreeIndex;
+			mTreeNodeList[TreeIndex].mNode->GetValueChangedDelegate().Add(Subscription.mDelegate);
+		}
+	}
+}
 
-	return NodeFolder;
+void UCSDebug_DebugMenuManager::SetMainFolderIndex(const int32 InTreeIndex)
+{
+	mMainFolderIndex = InTreeIndex;
+	mSelectIndex = mTreeNodeList[mMainFolderIndex].mFirstChildIndex;
 }
 
-CSDebug_DebugMenuNodeBase* UCSDebug_DebugMenuManager::FindDebugMenuNode(const FString& InPath)
+const FString& UCSDebug_DebugMenuManager::GetTreePath(const int32 InTreeIndex) const
 {
-	if (CSDebug_DebugMenuNodeBase** NodePtr = mNodeMap.Find(InPath))
+	if (mTreeNodeList.IsValidIndex(InTreeIndex))
 	{
-		if (NodePtr != nullptr)
+		if (const CSDebug_DebugMenuNodeBase* Node = mTreeNodeList[InTreeIndex].mNode)
 		{
-			return *NodePtr;
+			return Node->GetPath();
 		}
 	}
-	return nullptr;
+	return mRootPath;
 }
 
-void UCSDebug_DebugMenuManager::AssignNodeToFolder(CSDebug_DebugMenuNodeBase* InNode)
+CSDebug_DebugMenuNodeBase* UCSDebug_DebugMenuManager::FindDebugMenuNode(const FString& InPath) const
 {
-	const FString NodePath = InNode->GetPath();
-	FString FolderPath;
-	TArray<FString> PathList;
-	NodePath.ParseIntoArray(PathList, TEXT("/"));
-	int32 LastIndex = PathList.Num();
-	if (InNode->GetNodeData().mKind != ECSDebug_DebugMenuValueKind::Folder)
+	const int32 TreeIndex = FindTreeIndex(InPath);
+	if (TreeIndex == INDEX_NONE)
 	{
-		--LastIndex;
+		return nullptr;
 	}
-	for (int32 i = 0; i < LastIndex; ++i)
+	return mTreeNodeList[TreeIndex].mNode;
+}
+
+CSDebug_DebugMenuNodeBase* UCSDebug_DebugMenuManager::GetSelectNode() const
+{
+	if (mTreeNodeList.IsValidIndex(mSelectIndex))
 	{
-		if (i != 0)
-		{
-			FolderPath += FString(TEXT("/"));
-		}
-		FolderPath += PathList[i];
-		FindOrAddDebugMenuNodeFolder(FolderPath);
+		return mTreeNodeList[mSelectIndex].mNode;
 	}
+	return nullptr;
+}
 
-	FFolder& LastFolder = FindOrAddFolder(FolderPath);
-	LastFolder.mNodeList.Add(InNode);
+bool UCSDebug_DebugMenuManager::IsRootPathSegment(const TCHAR* InSegment, const int32 InLength) const
+{
+	return InLength == mRootPath.Len()
+		&& FCString::Strncmp(InSegment, *mRootPath, InLength) == 0;
 }
 
 FString UCSDebug_DebugMenuManager::CheckPathString(const FString& InPath) const
@@ -508,11 +960,11 @@ FString UCSDebug_DebugMenuManager::CheckPathString(const FString& InPath) const
 
 void UCSDebug_DebugMenuManager::Save(const FCSDebug_DebugMenuNodeActionParameter& InParameter)
 {
-	for (const auto& MapElement : mNodeMap)
+	for (const FTreeNode& TreeNode : mTreeNodeList)
 	{
-		const FString& Path = MapElement.Key;
-		if (const CSDebug_DebugMenuNodeBase* Node = MapElement.Value)
+		if (const CSDebug_DebugMenuNodeBase* Node = TreeNode.mNode)
 		{
+			const FString& Path = Node->GetPath();
 			const FCSDebug_DebugMenuNodeData& NodeData = Node->GetNodeData();
 			if (NodeData.mKind == ECSDebug_DebugMenuValueKind::Button
 				|| NodeData.mKind == ECSDebug_DebugMenuValueKind::Folder)
@@ -0,0 +1,75 @@
+// Copyright 2022 SensyuGames.
+
+#include "DebugMenu/CSDebug_DebugMenuNodeArena.h"
+
+
+FCSDebug_DebugMenuNodeArena::~FCSDebug_DebugMenuNodeArena()
+{
+	Empty();
+}
+
+void FCSDebug_DebugMenuNodeArena::Reserve(const SIZE_T InSize)
+{
+	check(mUsedSize == 0);
+	if (GetReservedSize() >= InSize)
+	{
+		return;
+	}
+	// 足りない時は細切れのチャンクを捨てて1つに纏める
+	Empty();
+	FChunk& Chunk = mChunkList.AddDefaulted_GetRef();
+	Chunk.mData = static_cast<uint8*>(FMemory::Malloc(InSize));
+	Chunk.mSize = InSize;
+}
+
+void* FCSDebug_DebugMenuNodeArena::Alloc(const SIZE_T InSize, const SIZE_T InAlign)
+{
+	for (; mChunkIndex < mChunkList.Num(); ++mChunkIndex, mChunkOffset = 0)
+	{
+		const FChunk& Chunk = mChunkList[mChunkIndex];
+		uint8* Result = Align(Chunk.mData + mChunkOffset, InAlign);
+		const SIZE_T EndOffset = static_cast<SIZE_T>(Result - Chunk.mData) + InSize;
+		if (EndOffset <= Chunk.mSize)
+		{
+			mUsedSize += EndOffset - mChunkOffset;
+			mChunkOffset = EndOffset;
+			return Result;
+		}
+	}
+
+	FChunk& Chunk = mChunkList.AddDefaulted_GetRef();
+	Chunk.mSize = FMath::Max(sDefaultChunkSize, InSize + InAlign);
+	Chunk.mData = static_cast<uint8*>(FMemory::Malloc(Chunk.mSize));
+	mChunkIndex = mChunkList.Num() - 1;
+	uint8* Result = Align(Chunk.mData, InAlign);
+	mChunkOffset = static_cast<SIZE_T>(Result - Chunk.mData) + InSize;
+	mUsedSize += mChunkOffset;
+	return Result;
+}
+
+void FCSDebug_DebugMenuNodeArena::Reset()
+{
+	mChunkIndex = 0;
+	mChunkOffset = 0;
+	mUsedSize = 0;
+}
+
+void FCSDebug_DebugMenuNodeArena::Empty()
+{
+	for (const FChunk& Chunk : mChunkList)
+	{
+		FMemory::Free(Chunk.mData);
+	}
+	mChunkList.Empty();
+	Reset();
+}
+
+SIZE_T FCSDebug_DebugMenuNodeArena::GetReservedSize() const
+{
+	SIZE_T Size = 0;
+	for (const FChunk& Chunk : mChunkList)
+	{
+		Size += Chunk.mSize;
+	}
+	return Size;
+}
@@ -61,6 +61,7 @@ void CSDebug_DebugMenuNodeBase::Init(const FString& InPath, const FCSDebug_Debug
 	default:
 		break;
 	}
+	mbInitialized = true;
 }
 
 void CSDebug_DebugMenuNodeBase::OnBeginAction()
@@ -142,32 +143,51 @@ FString CSDebug_DebugMenuNodeBase::GetDrawValueString() const
 	{
 		return GetSelectString();
 	}
-	return mValueString;
+	return GetValueString();
+}
+
+FString CSDebug_DebugMenuNodeBase::GetValueString() const
+{
+	switch (mNodeData.mKind)
+	{
+	case ECSDebug_DebugMenuValueKind::Bool:
+		return mValue.mBool ? FString(TEXT("true")) : FString(TEXT("false"));
+	case ECSDebug_DebugMenuValueKind::Int:
+		return FString::FromInt(mValue.mInt);
+	case ECSDebug_DebugMenuValueKind::Float:
+		return FString::SanitizeFloat(mValue.mFloat);
+	case ECSDebug_DebugMenuValueKind::List:
+	case ECSDebug_DebugMenuValueKind::Enum:
+		return FString::FromInt(mValue.mSelectIndex);
+	default:
+		break;
+	}
+	return FString();
 }
 
 bool CSDebug_DebugMenuNodeBase::GetBool() const
 {
 	ensure(mNodeData.mKind == ECSDebug_DebugMenuValueKind::Bool);
-	return mValueString.ToBool();
+	return mValue.mBool;
 }
 
 int32 CSDebug_DebugMenuNodeBase::GetInt() const
 {
 	ensure(mNodeData.mKind == ECSDebug_DebugMenuValueKind::Int);
-	return FCString::Atoi(*mValueString);
+	return mValue.mInt;
 }
 
 float CSDebug_DebugMenuNodeBase::GetFloat() const
 {
 	ensure(mNodeData.mKind == ECSDebug_DebugMenuValueKind::Float);
-	return FCString::Atof(*mValueString);
+	return mValue.mFloat;
 }
 
 int32 CSDebug_DebugMenuNodeBase::GetSelectIndex() const
 {
 	ensure(mNodeData.mKind == ECSDebug_DebugMenuValueKind::List
 			|| mNodeData.mKind == ECSDebug_DebugMenuValueKind::Enum);
-	return FCString::Atoi(*mValueString);
+	return mValue.mSelectIndex;
 }
 
 FString CSDebug_DebugMenuNodeBase::GetSelectString() const
@@ -198,6 +218,29 @@ void CSDebug_DebugMenuNodeBase::Load(const FString& InValueString, const FCSDebu
 	mActionDelegate.ExecuteIfBound(InParameter);
 }
 
+void CSDebug_DebugMenuNodeBase::SetValueString(const FString& InString)
+{
+	// セーブデータ,初期値の文字列は種類に合わせて一度だけ変換
+	switch (mNodeData.mKind)
+	{
+	case ECSDebug_DebugMenuValueKind::Bool:
+		SetValueBool(InString.ToBool());
+		break;
+	case ECSDebug_DebugMenuValueKind::Int:
+		SetValueInt(FCString::Atoi(*InString));
+		break;
+	case ECSDebug_DebugMenuValueKind::Float:
+		SetValueFloat(FCString::Atof(*InString));
+		break;
+	case ECSDebug_DebugMenuValueKind::List:
+	case ECSDebug_DebugMenuValueKind::Enum:
+		SetValueList(FCString::Atoi(*InString));
+		break;
+	default:
+		break;
+	}
+}
+
 void CSDebug_DebugMenuNodeBase::SetInitValue()
 {
 	if (!mNodeData.mInitValue.IsEmpty())
@@ -209,28 +252,55 @@ void CSDebug_DebugMenuNodeBase::SetInitValue()
 void CSDebug_DebugMenuNodeBase::SetValueBool(const bool InValue)
 {
 	ensure(mNodeData.mKind == ECSDebug_DebugMenuValueKind::Bool);
-	mValueString = InValue ? TEXT("true") : TEXT("false");
+	if (mValue.mBool != InValue)
+	{
+		mValue.mBool = InValue;
+		NotifyValueChanged();
+	}
 }
 
 void CSDebug_DebugMenuNodeBase::SetValueInt(const int32 InValue)
 {
 	ensure(mNodeData.mKind == ECSDebug_DebugMenuValueKind::Int);
-	mValueString = FString::FromInt(InValue);
+	if (mValue.mInt != InValue)
+	{
+		mValue.mInt = InValue;
+		NotifyValueChanged();
+	}
 }
 
 void CSDebug_DebugMenuNodeBase::SetValueFloat(const float InValue)
 {
 	ensure(mNodeData.mKind == ECSDebug_DebugMenuValueKind::Float);
-	mValueString = FString::SanitizeFloat(InValue);
+	if (mValue.mFloat != InValue)
+	{
+		mValue.mFloat = InValue;
+		NotifyValueChanged();
+	}
 }
 
 void CSDebug_DebugMenuNodeBase::SetValueList(const int32 InSelectIndex)
 {
 	ensure(mNodeData.mKind == ECSDebug_DebugMenuValueKind::List
 			|| mNodeData.mKind == ECSDebug_DebugMenuValueKind::Enum);
-	if (InSelectIndex < mNodeData.mList.Num())
+	if (InSelectIndex < mNodeData.mList.Num()
+		&& mValue.mSelectIndex != InSelectIndex)
+	{
+		mValue.mSelectIndex = InSelectIndex;
+		NotifyValueChanged();
+	}
+}
+
+void CSDebug_DebugMenuNodeBase::NotifyValueChanged()
+{
+	if (!mbInitialized)
+	{
+		return;
+	}
+	mValueChangedDelegate.Broadcast(*this);
+	if (UCSDebug_DebugMenuManager* Manager = GetManager())
 	{
-		mValueString = FString::FromInt(InSelectIndex);
+		Manager->NotifyNodeValueChanged(*this);
 	}
 }
 
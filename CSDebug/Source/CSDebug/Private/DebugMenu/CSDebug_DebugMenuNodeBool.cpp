@@ -14,6 +14,5 @@ void CSDebug_DebugMenuNodeBool::SetInitValue()
 	if (!GetNodeData().mInitValue.IsEmpty())
 	{
 		SetValueString(GetNodeData().mInitValue);
-		SetValueBool(GetBool());
 	}
 }
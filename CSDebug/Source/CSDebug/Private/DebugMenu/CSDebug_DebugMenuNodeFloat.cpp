@@ -9,16 +9,10 @@ void CSDebug_DebugMenuNodeFloat::OnBeginAction()
 
 	mEditDigitIntList.Empty();
 	mEditDigitIntList.Reserve(mEditDigitNum);
-	const FString FloatValueString = GetValueString();
-	FString IntegerPartString;
-	FString FractionalPartString;
-	FloatValueString.Split(FString(TEXT(".")), &IntegerPartString, &FractionalPartString);
-
-	FractionalPartString = FractionalPartString.Left(mEditDecimalNum);
-
-	const int32 IntegerPart = FCString::Atoi(*IntegerPartString);
-	const int32 AbsIntegerPart = FMath::Abs(IntegerPart);
-	const int32 FractionalPart = FCString::Atoi(*FractionalPartString);;
+	const float FloatValue = GetFloat();
+	const int64 ScaledValue = static_cast<int64>(FMath::RoundToDouble(FMath::Abs(static_cast<double>(FloatValue)) * mEditDecimalScale));
+	const int32 AbsIntegerPart = static_cast<int32>(ScaledValue / mEditDecimalScale);
+	const int32 FractionalPart = static_cast<int32>(ScaledValue % mEditDecimalScale);
 	{//è¨êîïîï™
 		int32 CalcDigitValue = FractionalPart;
 		for (int32 i = 0; i < mEditDecimalNum; ++i)
@@ -39,7 +33,7 @@ void CSDebug_DebugMenuNodeFloat::OnBeginAction()
 	}
 
 	//ç≈å„Ç…ïÑçÜèÓïÒ
-	if (IntegerPart >= 0)
+	if (FloatValue >= 0.f)
 	{
 		mEditDigitIntList.Add(1);
 	}
@@ -53,33 +47,20 @@ void CSDebug_DebugMenuNodeFloat::OnEndAction(const FCSDebug_DebugMenuNodeActionP
 {
 	CSDebug_DebugMenuNodeBase::OnEndAction(InParameter);
 
-	FString FloatString;
-	for (int32 i = 0; i < mEditDecimalNum; ++i)
+	int64 ScaledValue = 0;
+	int64 DigitValue = 1;
+	for (int32 i = 0; i < mEditDigitNumberNum; ++i)
 	{
-		FloatString = FString::Printf(TEXT("%d%s"),mEditDigitIntList[i],*FloatString);
+		ScaledValue += mEditDigitIntList[i] * DigitValue;
+		DigitValue *= 10;
 	}
-
-	FloatString = FString::Printf(TEXT(".%s"), *FloatString);
-
-	int32 ActiveNumberDigitIndex = mEditDigitNumberNum-1;
-	for (int32 i = mEditDigitNumberNum - 1; i >= mEditDecimalNum; --i)
-	{
-		if (mEditDigitIntList[i] == 0)
-		{
-			ActiveNumberDigitIndex = i;
-		}
-	}
-	for (int32 i = mEditDecimalNum; i < ActiveNumberDigitIndex; ++i)
-	{
-		FloatString = FString::Printf(TEXT("%d%s"), mEditDigitIntList[i], *FloatString);
-	}
-
+	float FloatValue = static_cast<float>(static_cast<double>(ScaledValue) / mEditDecimalScale);
 	if (mEditDigitIntList[mEditDigitNum - 1] < 0)
 	{
-		FloatString = FString::Printf(TEXT("-%s"), *FloatString);
+		FloatValue *= -1.f;
 	}
 
-	SetValueString(FloatString);
+	SetValueFloat(FloatValue);
 }
 
 void CSDebug_DebugMenuNodeFloat::OnJustPressedUpKey()
@@ -148,17 +129,11 @@ void CSDebug_DebugMenuNodeFloat::OnJustPressedRightKey()
 
 void CSDebug_DebugMenuNodeFloat::SetInitValue()
 {
-	FString IntegerPartString;
-	FString FractionalPartString;
-	if (!GetNodeData().mInitValue.Split(FString(TEXT(".")), &IntegerPartString, &FractionalPartString))
+	if (!GetNodeData().mInitValue.IsEmpty())
 	{
-		return;
+		const double InitValue = FCString::Atod(*GetNodeData().mInitValue);
+		SetValueFloat(static_cast<float>(FMath::RoundToDouble(InitValue * mEditDecimalScale) / mEditDecimalScale));
 	}
-
-	FractionalPartString = FractionalPartString.Left(mEditDecimalNum);
-
-	const FString FloatString = FString::Printf(TEXT("%s.%s"),*IntegerPartString, *FractionalPartString);
-	SetValueString(FloatString);
 }
 
 void CSDebug_DebugMenuNodeFloat::DrawEditValue(UCanvas* InCanvas, const FVector2D& InValuePos, const FVector2D& InValueExtent) const
@@ -17,7 +17,7 @@ void CSDebug_DebugMenuNodeInt::OnBeginAction()
 		mEditDigitIntList.Add(DigitValue);
 		CalcDigitValue /= 10;
 	}
-	//Ōɕ
+	//最後に符号情報
 	if (IntValue >= 0)
 	{
 		mEditDigitIntList.Add(1);
@@ -116,7 +116,6 @@ void CSDebug_DebugMenuNodeInt::SetInitValue()
 	if (!GetNodeData().mInitValue.IsEmpty())
 	{
 		SetValueString(GetNodeData().mInitValue);
-		SetValueInt(GetInt());
 	}
 }
 
@@ -127,13 +126,13 @@ void CSDebug_DebugMenuNodeInt::DrawEditValue(UCanvas* InCanvas, const FVector2D&
 	const FLinearColor WindowBackColor = GetWindowBackColor();
 	const FLinearColor WindowFrameColor = GetWindowFrameColor();
 	const FLinearColor FontColor = GetFontColor();
-	// ~
+	// 下敷き
 	{
 		FCanvasTileItem Item(SubWindowPos, WindowExtent, WindowBackColor);
 		Item.BlendMode = ESimpleElementBlendMode::SE_BLEND_Translucent;
 		InCanvas->DrawItem(Item);
 	}
-	// g
+	// 枠
 	{
 		FCanvasBoxItem Item(SubWindowPos, WindowExtent);
 		Item.SetColor(GetSelectColor());
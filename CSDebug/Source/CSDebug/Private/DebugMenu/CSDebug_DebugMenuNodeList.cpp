@@ -168,7 +168,6 @@ void CSDebug_DebugMenuNodeList::SetInitValue()
 	if (InitIndex == INDEX_NONE)
 	{
 		SetValueString(GetNodeData().mInitValue);
-		SetValueInt(GetInt());
 		return;
 	}
 	
@@ -0,0 +1,23 @@
+// Copyright 2022 SensyuGames.
+
+#include "DebugMenu/CSDebug_DebugMenuValue.h"
+#include "DebugMenu/CSDebug_DebugMenuManager.h"
+
+
+FCSDebug_DebugMenuValueHandle::FCSDebug_DebugMenuValueHandle(const CSDebug_DebugMenuNodeBase* InNode, const UCSDebug_DebugMenuManager* InManager)
+	: mNode(InNode)
+	, mManager(InManager)
+	, mNodeGeneration(InManager ? InManager->GetNodeGeneration() : 0)
+{
+}
+
+bool FCSDebug_DebugMenuValueHandle::IsValid() const
+{
+	if (mNode == nullptr)
+	{
+		return false;
+	}
+	const UCSDebug_DebugMenuManager* Manager = mManager.Get();
+	return Manager != nullptr
+		&& Manager->GetNodeGeneration() == mNodeGeneration;
+}
@@ -9,6 +9,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "DebugMenu/CSDebug_DebugMenuValue.h"
 #include "CSDebug_ActorSelectManager.generated.h"
 
 class UCanvas;
@@ -28,6 +29,7 @@ public:
 	static UCSDebug_ActorSelectManager* sGet(const UWorld* InWorld);
 
 	void	Init();
+	void	Exit();
 	bool	DebugTick(float InDeltaSecond);
 	void	DebugDraw(class UCanvas* InCanvas);
 	void	EntryDebugSelectComponent(UCSDebug_ActorSelectComponent* InComponent);
@@ -48,11 +50,27 @@ protected:
 	void	DrawMarkAllSelectList(UCanvas* InCanvas);
 
 	void	SetOnlyUpdateSelectActor(const bool bInOnlyUpdate);
+	void	SetupDebugMenu();
+	bool	IsDebugMenuRebuilt() const;
+	void	OnChangeDebugMenuValue(const CSDebug_DebugMenuNodeBase& InNode);
+	void	ApplyDebugMenuValue();
 
 private:
 	TWeakObjectPtr<ADebugCameraController>	mDebugCameraController;
 	TArray<TWeakObjectPtr<UCSDebug_ActorSelectComponent>>	mAllSelectList;
 	TArray<TWeakObjectPtr<UCSDebug_ActorSelectComponent>>	mSelectList;
+	TCSDebugMenuValue<bool>	mMenuValue_Active;
+	TCSDebugMenuValue<bool>	mMenuValue_UpdateOnlySelectActor;
+	TCSDebugMenuValue<bool>	mMenuValue_DrawInfo;
+	TCSDebugMenuValue<bool>	mMenuValue_DrawMark;
+	TCSDebugMenuValue<bool>	mMenuValue_DrawAxis;
+	TCSDebugMenuValue<bool>	mMenuValue_DrawBone;
+	TCSDebugMenuValue<bool>	mMenuValue_DrawPathFollow;
+	TCSDebugMenuValue<bool>	mMenuValue_DrawLastEQS;
+	TCSDebugMenuValue<bool>	mMenuValue_DrawBehaviorTree;
+	TCSDebugMenuValue<bool>	mMenuValue_DrawPerception;
+	FDelegateHandle	mDebugMenuValueChangedHandle;
+	uint32	mDebugMenuNodeGeneration = 0;//mMenuValue_*を取った時のデバッグメニューの世代
 	bool	mbActive = false;
 	bool	mbOnlyUpdateSelectActor = false;
 	bool	mbShowInfo = false;
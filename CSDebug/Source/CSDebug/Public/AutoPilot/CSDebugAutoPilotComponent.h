@@ -16,6 +16,15 @@
 class UCanvas;
 class APlayerController;
 class UCSDebugAutoPilotModeBase;
+class UCSDebugAutoPilotModeRecord;
+class UCSDebugAutoPilotModeRollingRecord;
+
+//入力記録のチェックサムに混ぜるユーザー値(乱数の状態やHP等 再生でズレを検出したい物)
+DECLARE_DELEGATE_RetVal(uint32, FCSDebugAutoPilotChecksumDelegate);
+//入力記録のキーフレームに保存,復元するユーザー状態(シーク時に戻したい物)
+DECLARE_DELEGATE_OneParam(FCSDebugAutoPilotKeyframeDelegate, FArchive&);
+//コマンドスクリプトのWaitUntilで待つユーザー条件(満たしたらtrue)
+DECLARE_DELEGATE_RetVal(bool, FCSDebugAutoPilotCommandConditionDelegate);
 
 /* ------------------------------------------------------------
    !é©ìÆëÄçÏÉÇÅ[Éh
@@ -54,10 +63,45 @@ public:
 
 	void	RequestPlayInputRecord(const FString& InFileName);
 	bool	IsFinishPlayRecord() const;
+	const UCSDebugAutoPilotModeRecord*	GetModeRecord() const;
+	void	SeekPlayRecord(const float InOffsetSec);
+	void	SetFastForward(const bool bInFastForward, const bool bInSkipRender);
+	bool	IsFastForward() const { return mbFastForward; }
+	void	RefreshFixFrameRate();
 	void	RequestBeginRecord(const FString& InFileName);
 	void	RequestEndRecord();
 	void	RequestIdleRecord();
 
+	void	RequestBeginRollingRecord();
+	void	RequestEndRollingRecord();
+	bool	IsRollingRecord() const { return mRollingRecord != nullptr; }
+	bool	DumpRollingRecord(const FString& InFileName);
+
+	void	RequestBeginRandom(const int32 InSeed, const FString& InRecordFileName);
+	void	RequestEndRandom();
+
+	UFUNCTION(BlueprintCallable, Category = "Command", meta = (DevelopmentOnly))
+	bool	RequestCommandScript(const FString& InFileName);
+	UFUNCTION(BlueprintCallable, Category = "Command", meta = (DevelopmentOnly))
+	void	RequestEndCommand();
+	UFUNCTION(BlueprintCallable, Category = "Command", meta = (DevelopmentOnly))
+	bool	IsFinishCommand() const;
+	void	AddCommandConditionDelegate(const FName& InName, const FCSDebugAutoPilotCommandConditionDelegate& InDelegate);
+	const FCSDebugAutoPilotCommandConditionDelegate*	FindCommandConditionDelegate(const FName& InName) const { return mCommandConditionMap.Find(InName); }
+
+	UFUNCTION(BlueprintCallable, Category = "AutoPlay", meta = (DevelopmentOnly))
+	bool	RequestBeginAutoPlay(const FString& InRouteName, const bool bInQuitOnFinish = false);
+	UFUNCTION(BlueprintCallable, Category = "AutoPlay", meta = (DevelopmentOnly))
+	void	RequestEndAutoPlay();
+	UFUNCTION(BlueprintCallable, Category = "AutoPlay", meta = (DevelopmentOnly))
+	bool	IsFinishAutoPlay() const;
+
+	void	AddChecksumDelegate(const FCSDebugAutoPilotChecksumDelegate& InDelegate);
+	void	ClearChecksumDelegate();
+	const TArray<FCSDebugAutoPilotChecksumDelegate>&	GetChecksumDelegateList() const { return mChecksumDelegateList; }
+	void	SetKeyframeStateDelegate(const FCSDebugAutoPilotKeyframeDelegate& InDelegate) { mKeyframeStateDelegate = InDelegate; }
+	const FCSDebugAutoPilotKeyframeDelegate&	GetKeyframeStateDelegate() const { return mKeyframeStateDelegate; }
+
 protected:
 	void	RequestDebugDraw(const bool bInActive);
 	void	DebugDraw(class UCanvas* InCanvas, class APlayerController* InPlayerController);
@@ -65,25 +109,32 @@ protected:
 	void	OnBeginMode();
 	void	OnEndMode();
 	void	SetFixFrameRate(bool InFix);
+	bool	IsFixFrameRateMode() const;
 
 private:
 	UPROPERTY()
 	UCSDebugAutoPilotModeBase* mActiveMode = nullptr;
+	UPROPERTY()
+	UCSDebugAutoPilotModeRollingRecord* mRollingRecord = nullptr;//常時記録はmActiveModeと並行して動かす(モードを切り替えても消さない)
 
 	FDelegateHandle	mDebugDrawHandle;
+	TArray<FCSDebugAutoPilotChecksumDelegate>	mChecksumDelegateList;
+	FCSDebugAutoPilotKeyframeDelegate	mKeyframeStateDelegate;
+	TMap<FName, FCSDebugAutoPilotCommandConditionDelegate>	mCommandConditionMap;
 	ECSDebugAutoPilotMode	mMode = ECSDebugAutoPilotMode::Invalid;
 	bool	mbIgnoreInput = false;
+	bool	mbFastForward = false;//固定デルタのままフレーム待ちせずに回す
+	bool	mbFastForwardSkipRender = false;
+	double	mPrevFixedDeltaTime = 1.0 / 30.0;//早送り開始前のFApp::GetFixedDeltaTime()
+	bool	mbFixedTimeStep = false;
+	bool	mbPrevUseFixedTimeStep = false;//早送り開始前のFApp::UseFixedTimeStep()
+	bool	mbSkipRender = false;
+	bool	mbPrevDisableWorldRendering = false;//早送り開始前のbDisableWorldRendering
 
 #if 0
 public:
 
 
-	void	RequestBeginRandom();
-	void	RequestEndRandom();
-
-	void	RequestBeginAutoPlay();
-	void	RequestEndAutoPlay();
-
 	void	RequestBeginSemiAutoPlay();
 	void	RequestEndSemiAutoPlay();
 
@@ -106,10 +157,6 @@ public:
 		bool	IsFinishCommand(int32 InCommandId);
 	UFUNCTION(BlueprintCallable, Category = "Command", meta = (DevelopmentOnly))
 		bool	IsFinishLastCommand();
-	UFUNCTION(BlueprintCallable, Category = "Command", meta = (DevelopmentOnly))
-		bool	IsFinishAllCommand();
-	UFUNCTION(BlueprintCallable, Category = "Command", meta = (DevelopmentOnly))
-		bool	RequestCommandScript(FString InPath);
 
 	UFUNCTION(BlueprintCallable, Category = "Command", meta = (DevelopmentOnly))
 		FVector	GetCommandMoveGoalPos() const;
@@ -10,10 +10,12 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "DebugMenu/CSDebug_DebugMenuValue.h"
 #include "CSDebug_ShortcutCommand.generated.h"
 
 
 class APlayerController;
+struct FCSDebug_DebugMenuNodeActionParameter;
 
 /**
  * 
@@ -28,6 +30,7 @@ class CSDEBUG_API UCSDebug_ShortcutCommand : public UObject
 #if USE_CSDEBUG
 public:
 	void	Init();
+	void	Exit();
 	bool	DebugTick(float InDeltaSecond);
 	void	DebugDraw(class UCanvas* InCanvas);
 
@@ -47,9 +50,19 @@ protected:
 	void	SwicthDebugMenuActive(APlayerController* InPlayerController);
 	void	SetDebugStop(bool bInStop, APlayerController* InPlayerController);
 	void	SetStopMotionBlur(bool bInStop, APlayerController* InPlayerController);
+	void	DumpRollingRecord(APlayerController* InPlayerController);
+	void	OnBeginRollingRecord(const FCSDebug_DebugMenuNodeActionParameter& InParameter);
+	void	OnDumpRollingRecord(const FCSDebug_DebugMenuNodeActionParameter& InParameter);
+	void	OnSeekForwardPlayRecord(const FCSDebug_DebugMenuNodeActionParameter& InParameter);
+	void	OnSeekBackPlayRecord(const FCSDebug_DebugMenuNodeActionParameter& InParameter);
+	void	OnBeginRandom(const FCSDebug_DebugMenuNodeActionParameter& InParameter);
+	void	OnEndRandom(const FCSDebug_DebugMenuNodeActionParameter& InParameter);
+	void	OnChangeDebugStopOnDebugMenu(const CSDebug_DebugMenuNodeBase& InNode);
 
 private:
 	TMap<FString, FSecretCommandLog> mSecretCommandLog;
+	TCSDebugMenuValue<bool>	mMenuValue_DebugStopOnDebugMenu;
+	FDelegateHandle	mDebugStopOnDebugMenuChangedHandle;
 	float	mDebugStepRepeatBeginSec = 0.3f;//DebugStepRepeat発動までの押しっぱなし時間
 	float	mDebugStepRepeatBeginTimer = 0.f;//DebugStepRepeat発動までの押しっぱなし計測時間
 	float	mDebugStepInterval = 0.f;//DebugStepでPause解除後に再度解除するまでの時間
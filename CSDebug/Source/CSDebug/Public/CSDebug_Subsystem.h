@@ -17,6 +17,7 @@ class UCSDebug_ActorSelectManager;
 class UCSDebugMenuManager;
 class UCSDebugInfoWindowManager;
 class UCSDebug_DebugMenuManager;
+class UCSDebugAutoPilotBatchRunner;
 
 DECLARE_LOG_CATEGORY_EXTERN(CSDebugLog, Log, All);
 
@@ -41,6 +42,13 @@ public:
 	UCSDebug_ActorSelectManager* GetActorSelectManager() const { return mGCObject.mActorSelectManager; }
 	UCSDebug_DebugMenuManager* GetDebugMenuManager() const { return mGCObject.mDebugMenuManager; }
 	UCSDebug_ScreenWindowManager* GetScreenWindowManager() const { return mGCObject.mScreenWindowManager; }
+	//起動引数の経路の自動移動を見るのはGameInstance(PIEならプレイ毎)で一度だけ 最初の呼び出しだけtrue
+	bool	TakeAutoPilotRouteCommandLine()
+	{
+		const bool bFirst = !mbTakenAutoPilotRouteCommandLine;
+		mbTakenAutoPilotRouteCommandLine = true;
+		return bFirst;
+	}
 
 protected:
 	void	RequestTick(const bool bInActive);
@@ -56,12 +64,14 @@ protected:
 		UCSDebug_ActorSelectManager* mActorSelectManager = nullptr;
 		UCSDebug_DebugMenuManager* mDebugMenuManager = nullptr;
 		UCSDebug_ScreenWindowManager* mScreenWindowManager = nullptr;
+		UCSDebugAutoPilotBatchRunner* mAutoPilotBatchRunner = nullptr;
 		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
 		{
 			Collector.AddReferencedObject(mShortcutCommand);
 			Collector.AddReferencedObject(mActorSelectManager);
 			Collector.AddReferencedObject(mDebugMenuManager);
 			Collector.AddReferencedObject(mScreenWindowManager);
+			Collector.AddReferencedObject(mAutoPilotBatchRunner);
 		}
 	};
 	FGCObjectCSDebug	mGCObject;
@@ -70,5 +80,6 @@ private:
 	TWeakObjectPtr<AActor>	mOwner;
 	FDelegateHandle	mDebugTickHandle;
 	FDelegateHandle	mDebugDrawHandle;
+	bool	mbTakenAutoPilotRouteCommandLine = false;
 	static FCSDebug_SaveData mSaveData;
 };
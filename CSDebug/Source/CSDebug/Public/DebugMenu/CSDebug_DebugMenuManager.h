@@ -4,21 +4,24 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "DebugMenu/CSDebug_DebugMenuNodeArena.h"
 #include "DebugMenu/CSDebug_DebugMenuNodeBase.h"
 #include "DebugMenu/CSDebug_DebugMenuSave.h"
+#include "DebugMenu/CSDebug_DebugMenuValue.h"
 #include "CSDebug_DebugMenuManager.generated.h"
 
 class CSDebug_DebugMenuNodeBase;
+class UDataTable;
 
 UCLASS()
 class CSDEBUG_API UCSDebug_DebugMenuManager : public UObject
 {
 	GENERATED_BODY()
 
-	struct FFolder;
-	
 public:
 	static UCSDebug_DebugMenuManager* sGet(const UObject* InObject);
+	static void sBenchmarkNodeValue(const int32 InReadNum, const int32 InFrameNum);
+	static void sBenchmarkInit(const int32 InNodeNum, const int32 InLoopNum);
 
 	UCSDebug_DebugMenuManager();
 	virtual void BeginDestroy() override;
@@ -27,41 +30,90 @@ public:
 	void DebugTick(const float InDeltaTime);
 	void DebugDraw(UCanvas* InCanvas);
 	CSDebug_DebugMenuNodeBase* AddNode(const FString& InFolderPath, const FCSDebug_DebugMenuNodeData& InNodeData);
-	CSDebug_DebugMenuNodeBase* AddNode_Bool(const FString& InFolderPath, const FString& InDisplayName, const bool InInitValue);
+	TCSDebugMenuValue<bool> AddNode_Bool(const FString& InFolderPath, const FString& InDisplayName, const bool InInitValue);
+	TCSDebugMenuValue<int32> AddNode_Int(const FString& InFolderPath, const FString& InDisplayName, const int32 InInitValue);
+	TCSDebugMenuValue<float> AddNode_Float(const FString& InFolderPath, const FString& InDisplayName, const float InInitValue);
 	CSDebug_DebugMenuNodeBase* AddNode_Button(const FString& InFolderPath, const FString& InDisplayName, const FCSDebug_DebugMenuNodeActionDelegate& InDelegate);
+	template<typename T>
+	TCSDebugMenuValue<T> FindNodeValue(const FString& InPath) const
+	{
+		return TCSDebugMenuValue<T>(FindDebugMenuNode(InPath), this);
+	}
 	bool GetNodeValue_Bool(const FString& InPath) const;
+	int32 GetNodeValue_Int(const FString& InPath) const;
+	float GetNodeValue_Float(const FString& InPath) const;
 	void SetNodeActionDelegate(const FString& InPath, const FCSDebug_DebugMenuNodeActionDelegate& InDelegate);
+	FDelegateHandle SubscribeNodeValueChanged(const FString& InPath, const FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate& InDelegate);
+	FDelegateHandle SubscribeNodeValueChanged(const FCSDebug_DebugMenuValueHandle& InValue, const FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate& InDelegate);
+	FDelegateHandle SubscribeFolderValueChanged(const FString& InFolderPath, const FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate& InDelegate);
+	void Unsubscribe(const FDelegateHandle& InHandle);
+	void NotifyNodeValueChanged(const CSDebug_DebugMenuNodeBase& InNode);
 	void SetMainFolder(const FString& InPath);
 	void BackMainFolder();
 	void SetActive(const bool bInActive);
 	bool IsActive() const {return mbActive;}
+	uint32 GetNodeGeneration() const { return mNodeGeneration; }
 
 protected:
+	void InitNode(const UDataTable& InDataTable);
 	void SetupDefaultMenu();
 	void ClearNode();
 	APlayerController* FindPlayerController() const;
 	void ChangeSelectNode(const bool bInDown);
 	void DrawMainFolderPath(UCanvas* InCanvas, const FVector2D& InPos) const;
-	FFolder& FindOrAddFolder(const FString& InPath);
-	CSDebug_DebugMenuNodeBase* FindOrAddDebugMenuNodeFolder(const FString& InPath);
-	CSDebug_DebugMenuNodeBase* FindDebugMenuNode(const FString& InPath);
-	void AssignNodeToFolder(CSDebug_DebugMenuNodeBase* InNode);
+	int32 FindTreeIndex(const FString& InPath) const;
+	int32 FindOrAddFolderTreeIndex(const FString& InPath);
+	int32 AddTreeNode(const int32 InParentIndex, const FName& InName, CSDebug_DebugMenuNodeBase* InNode);
+	void BindPendingSubscription();
+	void SetMainFolderIndex(const int32 InTreeIndex);
+	const FString& GetTreePath(const int32 InTreeIndex) const;
+	CSDebug_DebugMenuNodeBase* FindDebugMenuNode(const FString& InPath) const;
+	CSDebug_DebugMenuNodeBase* GetSelectNode() const;
+	bool IsRootPathSegment(const TCHAR* InSegment, const int32 InLength) const;
 	FString CheckPathString(const FString& InPath) const;
 	void Save(const FCSDebug_DebugMenuNodeActionParameter& InParameter);
 	void Load(const FCSDebug_DebugMenuNodeActionParameter& InParameter);
 
 private:
-	struct FFolder
+	// メニューの木構造の1要素(0番はルート)
+	// 子は兄弟のリンクで追加順に並べる
+	struct FTreeNode
+	{
+		CSDebug_DebugMenuNodeBase* mNode = nullptr;//ルートはnullptr
+		FName mName;//パスの区切り1つ分
+		int32 mParentIndex = INDEX_NONE;
+		int32 mFirstChildIndex = INDEX_NONE;
+		int32 mLastChildIndex = INDEX_NONE;
+		int32 mPrevSiblingIndex = INDEX_NONE;
+		int32 mNextSiblingIndex = INDEX_NONE;
+	};
+	// フォルダ以下のどれかの値が変わった時の通知先(ClearNodeしても残る)
+	struct FFolderSubscription
+	{
+		FString mPath;
+		int32 mTreeIndex = INDEX_NONE;//フォルダが無い間はINDEX_NONE(追加された時に埋める)
+		FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate mDelegate;
+		FDelegateHandle mHandle;
+	};
+	FCSDebug_DebugMenuNodeArena mNodeArena;//mTreeNodeListのmNodeの実体
+	TArray<FTreeNode> mTreeNodeList;
+	TMap<TPair<int32, FName>, int32> mChildIndexMap;//(親,名前)から子のmTreeNodeListの添字
+	// ノードの値が変わった時の通知先(ClearNodeしても残して同じパスのノードが追加された時に付け直す)
+	struct FNodeSubscription
 	{
-		TArray<CSDebug_DebugMenuNodeBase*> mNodeList;
 		FString mPath;
+		int32 mTreeIndex = INDEX_NONE;//付けてるノード(まだ無ければINDEX_NONE)
+		FCSDebug_DebugMenuNodeValueChangedDelegate::FDelegate mDelegate;
+		FDelegateHandle mHandle;
 	};
-	TMap<FString, CSDebug_DebugMenuNodeBase*> mNodeMap;
-	TMap<FString, FFolder> mFolderMap;
+	TArray<FFolderSubscription> mFolderSubscriptionList;
+	TArray<FNodeSubscription> mNodeSubscriptionList;
 	FCSDebug_DebugMenuSaveData mSaveData;
-	FString mMainFolderPath;
 	FString mRootPath = FString(TEXT("~"));
-	CSDebug_DebugMenuNodeBase* mSelectNode = nullptr;
+	int32 mMainFolderIndex = 0;
+	int32 mSelectIndex = INDEX_NONE;
+	uint32 mNodeGeneration = 0;//ClearNodeで進めて古いTCSDebugMenuValueを無効にする
 	bool mbActive = false;
+	bool mbInitNode = false;//InitNode中は購読の付け直しを最後に纏めて1回
 	bool mbDoneAutoLoad = false;
 };
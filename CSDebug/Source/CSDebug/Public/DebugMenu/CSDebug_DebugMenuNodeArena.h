@@ -0,0 +1,45 @@
+// Copyright 2022 SensyuGames.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// DebugMenuManagerのノード置き場
+// Reserveで纏めて確保したチャンクから詰めて切り出すだけで 個別の解放はしない
+// Resetは先頭に戻すだけなのでチャンクは次のInitで使い回す(デストラクタは使う側で呼ぶ)
+class CSDEBUG_API FCSDebug_DebugMenuNodeArena
+{
+public:
+	~FCSDebug_DebugMenuNodeArena();
+
+	void Reserve(const SIZE_T InSize);
+	void* Alloc(const SIZE_T InSize, const SIZE_T InAlign);
+	template<typename T>
+	T* New()
+	{
+		return new(Alloc(sizeof(T), alignof(T))) T();
+	}
+	void Reset();
+	void Empty();
+	SIZE_T GetUsedSize() const { return mUsedSize; }
+	SIZE_T GetReservedSize() const;
+	int32 GetChunkNum() const { return mChunkList.Num(); }
+
+	template<typename T>
+	static SIZE_T sGetAllocSize()
+	{
+		return Align(sizeof(T), alignof(T));
+	}
+
+private:
+	struct FChunk
+	{
+		uint8* mData = nullptr;
+		SIZE_T mSize = 0;
+	};
+	TArray<FChunk> mChunkList;
+	int32 mChunkIndex = 0;
+	SIZE_T mChunkOffset = 0;
+	SIZE_T mUsedSize = 0;
+	static constexpr SIZE_T sDefaultChunkSize = 64 * 1024;//Reserve分を使い切った後(実行中のAddNode_*等)の追加分
+};
@@ -12,6 +12,7 @@ struct FCSDebug_DebugMenuNodeActionParameter
 	TWeakObjectPtr<APlayerController> mPlayerController;
 };
 DECLARE_DELEGATE_OneParam(FCSDebug_DebugMenuNodeActionDelegate, const FCSDebug_DebugMenuNodeActionParameter&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FCSDebug_DebugMenuNodeValueChangedDelegate, const CSDebug_DebugMenuNodeBase&);
 
 
 class CSDEBUG_API CSDebug_DebugMenuNodeBase
@@ -29,24 +30,30 @@ public:
 	virtual void OnJustPressedRightKey() {}
 	void Draw(UCanvas* InCanvas, const FVector2D& InPos, const bool bInSelect) const;
 	const FString& GetPath() const { return mPath; }
-	FString GetValueString() const { return mValueString; }
+	int32 GetTreeIndex() const { return mTreeIndex; }
+	void SetTreeIndex(const int32 InTreeIndex) { mTreeIndex = InTreeIndex; }
+	FString GetValueString() const;
 	FString GetDrawValueString() const;
 	bool GetBool() const;
 	int32 GetInt() const;
 	float GetFloat() const;
 	int32 GetSelectIndex() const;
 	FString GetSelectString() const;
+	template<typename T> bool IsValueKind() const;
+	template<typename T> T GetValue() const;
 	void SetNodeAction(const FCSDebug_DebugMenuNodeActionDelegate& InDelegate);
+	FCSDebug_DebugMenuNodeValueChangedDelegate& GetValueChangedDelegate() { return mValueChangedDelegate; }
 	const FCSDebug_DebugMenuNodeData& GetNodeData() const{return mNodeData;}
 	void Load(const FString& InValueString, const FCSDebug_DebugMenuNodeActionParameter& InParameter);
 
 protected:
-	void SetValueString(const FString& InString){mValueString = InString;}
+	void SetValueString(const FString& InString);
 	virtual void SetInitValue();
 	void SetValueBool(const bool InValue);
 	void SetValueInt(const int32 InValue);
 	void SetValueFloat(const float InValue);
 	void SetValueList(const int32 InSelectIndex);
+	void NotifyValueChanged();
 	virtual void DrawValue(UCanvas* InCanvas, const FVector2D& InPos, const FLinearColor InColor) const;
 	virtual void DrawEditValue(UCanvas* InCanvas, const FVector2D& InValuePos, const FVector2D& InValueExtent) const;
 	bool IsEditMode() const { return mbEditMode; }
@@ -57,10 +64,29 @@ protected:
 	UCSDebug_DebugMenuManager* GetManager() const;
 
 private:
+	// mNodeData.mKindで使う方が決まる 文字列にするのは表示と保存の時だけ
+	union FValue
+	{
+		bool mBool;
+		int32 mInt = 0;
+		float mFloat;
+		int32 mSelectIndex;
+	};
+
 	FCSDebug_DebugMenuNodeData mNodeData;
 	FCSDebug_DebugMenuNodeActionDelegate mActionDelegate;
-	FString mValueString;
+	FCSDebug_DebugMenuNodeValueChangedDelegate mValueChangedDelegate;
+	FValue mValue;
 	FString mPath;
+	int32 mTreeIndex = INDEX_NONE;//ManagerのmTreeNodeListの添字
 	TWeakObjectPtr<UCSDebug_DebugMenuManager> mManager;
 	bool mbEditMode = false;
+	bool mbInitialized = false;//Init中の値設定は変更通知しない
 };
+
+template<> inline bool CSDebug_DebugMenuNodeBase::IsValueKind<bool>() const { return mNodeData.mKind == ECSDebug_DebugMenuValueKind::Bool; }
+template<> inline bool CSDebug_DebugMenuNodeBase::IsValueKind<int32>() const { return mNodeData.mKind == ECSDebug_DebugMenuValueKind::Int; }
+template<> inline bool CSDebug_DebugMenuNodeBase::IsValueKind<float>() const { return mNodeData.mKind == ECSDebug_DebugMenuValueKind::Float; }
+template<> inline bool CSDebug_DebugMenuNodeBase::GetValue<bool>() const { return GetBool(); }
+template<> inline int32 CSDebug_DebugMenuNodeBase::GetValue<int32>() const { return GetInt(); }
+template<> inline float CSDebug_DebugMenuNodeBase::GetValue<float>() const { return GetFloat(); }
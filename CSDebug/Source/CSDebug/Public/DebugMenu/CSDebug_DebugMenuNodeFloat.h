@@ -21,10 +21,11 @@ protected:
 	virtual void DrawEditValue(UCanvas* InCanvas, const FVector2D& InPos, const FVector2D& InValueExtent) const;
 
 private:
-	static const int32 mEditIntegralDigitNum = 7;//
-	static const int32 mEditDecimalNum = 3;//
-	static const int32 mEditDigitNumberNum = mEditIntegralDigitNum + mEditDecimalNum;//
-	static const int32 mEditDigitNum = mEditDigitNumberNum + 1;//ǉ
+	static const int32 mEditIntegralDigitNum = 7;//整数桁数
+	static const int32 mEditDecimalNum = 3;//小数桁数
+	static const int32 mEditDecimalScale = 1000;//10のmEditDecimalNum乗
+	static const int32 mEditDigitNumberNum = mEditIntegralDigitNum + mEditDecimalNum;//桁数
+	static const int32 mEditDigitNum = mEditDigitNumberNum + 1;//符号分追加
 	TArray<int32> mEditDigitIntList;
-	int32 mEditDigitIndex = 0;//mEditDigitIntList̕ҏWʒu
+	int32 mEditDigitIndex = 0;//mEditDigitIntListの編集位置
 };
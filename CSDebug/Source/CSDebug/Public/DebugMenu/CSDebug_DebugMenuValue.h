@@ -0,0 +1,47 @@
+// Copyright 2022 SensyuGames.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DebugMenu/CSDebug_DebugMenuNodeBase.h"
+
+class UCSDebug_DebugMenuManager;
+
+// AddNode_*等で返すノードの参照(毎フレームのパス検索無しで値を読むため)
+// ManagerのClearNodeでノードが消えたら無効になる
+class CSDEBUG_API FCSDebug_DebugMenuValueHandle
+{
+public:
+	bool IsValid() const;
+	const CSDebug_DebugMenuNodeBase* GetNode() const { return IsValid() ? mNode : nullptr; }
+
+protected:
+	FCSDebug_DebugMenuValueHandle() {}
+	FCSDebug_DebugMenuValueHandle(const CSDebug_DebugMenuNodeBase* InNode, const UCSDebug_DebugMenuManager* InManager);
+
+	const CSDebug_DebugMenuNodeBase* mNode = nullptr;
+
+private:
+	TWeakObjectPtr<const UCSDebug_DebugMenuManager> mManager;
+	uint32 mNodeGeneration = 0;
+};
+
+// bool/int32/floatのノードの値
+template<typename T>
+class TCSDebugMenuValue : public FCSDebug_DebugMenuValueHandle
+{
+public:
+	TCSDebugMenuValue() {}
+	TCSDebugMenuValue(const CSDebug_DebugMenuNodeBase* InNode, const UCSDebug_DebugMenuManager* InManager)
+		: FCSDebug_DebugMenuValueHandle((InNode && InNode->IsValueKind<T>()) ? InNode : nullptr, InManager)
+	{}
+
+	T Get() const
+	{
+		if (IsValid())
+		{
+			return mNode->GetValue<T>();
+		}
+		return T();
+	}
+};